@@ -2,60 +2,199 @@
 File: LaunchTimes_main.cpp
 Author: Ryan McNamee
 Date Created: Tuesday, 19, September, 2017
-Date Updated: Monday, 9, October, 2017
+Date Updated: Saturday, 17, October, 2026
 Purpose: Start the program
 */
 #include "rm_Launcher.hpp"
+#include "rm_Benchmark.hpp"
+#include "rm_Report.hpp"
+#include "rm_Trace.hpp"
+#include "rm_ForkServer.hpp"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <cassert>
+#include <locale>
+#ifndef _WIN32
+#include <codecvt>
+#endif
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
+	// Helper of a fork server, started by the launcher with its socket, prints nothing of its own
+	size_t helperSocket;
+	if (argc == 3 && string(argv[1]) == "--fork-server" && rm::ParseUnsigned(string_view(argv[2]), helperSocket)) {
+		return rm::ForkServer::Serve(static_cast<int>(helperSocket));
+	}
+
+#ifndef _WIN32
+	// All console output is wide, write it as UTF-8 regardless of the C locale
+	ios_base::sync_with_stdio(false);
+	locale utf8(locale(), new codecvt_utf8<wchar_t>);
+	wcout.imbue(utf8);
+	wcerr.imbue(utf8);
+#endif
+
 	// Print program info
-	cout << endl << "launchtimes.exe, by Ryan McNamee, 2017" << endl << endl;
+	wcout << endl << L"launchtimes.exe, by Ryan McNamee, 2017" << endl << endl;
 
-	// Only allow 2 arguments
-	if (argc != 2) {
-		// Complain
-		cerr << "Error: Invalid parameter list" << endl
-			<< "Usage: launchtime.exe [text file]" << endl;
-		// Abandon
-		return EXIT_FAILURE;
+	// Benchmark the parsers
+	if (argc == 3 && string(argv[1]) == "--bench-parse") {
+		return rm::BenchmarkParse(argv[2], wcout) ? EXIT_SUCCESS : EXIT_FAILURE;
 	}
 
-	// Create File
-	wifstream file(argv[1]);
-	// Check if file could be opened
-	if (!file) {
+	// Benchmark launching
+	size_t launches;
+	if (argc == 3 && string(argv[1]) == "--bench-launch") {
+		if (!rm::ParseUnsigned(string_view(argv[2]), launches) || launches == 0) {
+			wcerr << L"Error: Invalid number of launches" << endl;
+			return EXIT_FAILURE;
+		}
+#ifdef _WIN32
+		return rm::BenchmarkLaunch(launches, L"cmd.exe", L"/c exit", wcout) ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+		return rm::BenchmarkLaunch(launches, "true", "", wcout) ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+	}
+
+	// Benchmark the whole pipeline
+	if (argc == 3 && string(argv[1]) == "--bench-suite") {
+		wofstream report(argv[2], ios::binary);
+		if (!report) {
+			wcerr << L"Error: Report file could not be opened" << endl;
+			return EXIT_FAILURE;
+		}
+		return rm::BenchmarkSuite(report, wcout) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Compile batch files once so later runs load them without parsing
+	if (argc >= 4 && string(argv[1]) == "--compile") {
+		rm::Launcher launcher;
+		if (!launcher.ParseFiles(vector<string>(argv + 3, argv + argc)) || !launcher.Compile(argv[2])) {
+			return EXIT_FAILURE;
+		}
+		wcout << L"Compiled " << launcher.GetProcessCount() << L" processes into " << rm::FromUtf8(argv[2]) << endl;
+		return EXIT_SUCCESS;
+	}
+
+	// Options come before the input files
+	rm::ReportFormat format = rm::ReportFormat::Text;
+	string reportPath;
+	string tracePath;
+	bool resume = false;
+	size_t shard = 0, shards = 0;
+	bool validShard = true;
+	bool validFormat = true;
+	int arg = 1;
+	for (; arg < argc; ++arg) {
+		string option(argv[arg]);
+		if (option.compare(0, 9, "--format=") == 0) {
+			validFormat = rm::ParseReportFormat(string_view(option).substr(9), format);
+			if (!validFormat) {
+				break;
+			}
+			continue;
+		}
+		if (option.compare(0, 9, "--report=") == 0 && option.size() > 9) {
+			reportPath = option.substr(9);
+			continue;
+		}
+		if (option.compare(0, 8, "--trace=") == 0 && option.size() > 8) {
+			tracePath = option.substr(8);
+			continue;
+		}
+		if (option == "--resume") {
+			resume = true;
+			continue;
+		}
+		if (option == "--shard" || option.compare(0, 8, "--shard=") == 0) {
+			// "i/N", this is instance i of N counting from 1
+			string value = option.size() > 8 ? option.substr(8) : (arg + 1 < argc ? string(argv[++arg]) : string());
+			size_t slash = value.find('/');
+			validShard = slash != string::npos
+				&& rm::ParseUnsigned(string_view(value).substr(0, slash), shard)
+				&& rm::ParseUnsigned(string_view(value).substr(slash + 1), shards)
+				&& shard >= 1 && shard <= shards;
+			continue;
+		}
+		break;
+	}
+
+	// Only allow input files after the options
+	if (arg == argc || !validShard || !validFormat) {
 		// Complain
-		cerr << "Error: File could not be opened" << endl;
+		wcerr << (validFormat ? L"Error: Invalid parameter list" : L"Error: Unknown report format") << endl
+			<< L"Usage: launchtime.exe [--format=text|jsonl|csv] [--report=file] [--trace=file] [--resume] [--shard i/N] [text file or directory]..." << endl
+			<< L"       launchtime.exe --compile [compiled file] [text file or directory]..." << endl
+			<< L"       launchtime.exe --bench-parse [text file]" << endl
+			<< L"       launchtime.exe --bench-launch [number of launches]" << endl
+			<< L"       launchtime.exe --bench-suite [report file]" << endl;
 		// Abandon
 		return EXIT_FAILURE;
 	}
 
-	cout << "Parsing File: " << endl;
-	// Create launcher and parse file
+	// Timeline of the whole run, from parsing to the report
+	rm::Trace trace;
+	if (!tracePath.empty()) {
+		if (!trace.Open(tracePath)) {
+			wcerr << L"Error: Trace file could not be opened" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+	rm::Trace::clock_type::time_point phase = rm::Trace::clock_type::now();
+
+	wcout << L"Parsing File: " << endl;
+	// Create launcher and parse files, several files are parsed at once
 	rm::Launcher launcher;
+	launcher.SetResume(resume);
+	if (trace.Enabled()) {
+		launcher.SetTrace(&trace);
+	}
 	try {
-		file >> launcher;
+		if (!launcher.ParseFiles(vector<string>(argv + arg, argv + argc))) {
+			// Abandon
+			return EXIT_FAILURE;
+		}
 	}
-	catch (exception e) {		// No exception should be thrown but code may change later
-		cerr << e.what() << endl;
+	catch (exception& e) {		// No exception should be thrown but code may change later
+		wcerr << L"Error: " << rm::FromUtf8(e.what()) << endl;
 		return EXIT_FAILURE;
 	}
-	// File no longer needed
-	file.close();
+
+	// Several launchers share the batch, each runs its own part of it
+	if (shards > 0) {
+		size_t jobs = launcher.GetJobCount();
+		size_t kept = launcher.Shard(shard - 1, shards);
+		wcout << L"Shard " << shard << L"/" << shards << L": running " << kept << L" of " << jobs << L" processes" << endl;
+	}
+
+	trace.Phase("parse", phase, rm::Trace::clock_type::now());
 
 	// Run processes and output data
-	cout << endl << "Running Applications: " << endl;
+	wcout << endl << L"Running Applications: " << endl;
 	launcher.RunAll();
-	cout << endl << "Printing Data: " << endl;
-	wcout << launcher;
+	phase = rm::Trace::clock_type::now();
+	if (!reportPath.empty()) {
+		// Report to a file, the console still gets the text table
+		wofstream report(reportPath, ios::binary);
+#ifndef _WIN32
+		report.imbue(utf8);
+#endif
+		if (!report) {
+			wcerr << L"Error: Report file could not be opened" << endl;
+			return EXIT_FAILURE;
+		}
+		rm::WriteReport(report, launcher, format);
+		format = rm::ReportFormat::Text;
+	}
+	wcout << endl << L"Printing Data: " << endl;
+	rm::WriteReport(wcout, launcher, format);
+	trace.Phase("report", phase, rm::Trace::clock_type::now());
+	trace.Close();
 
-	cout << endl << "Progrma End." << endl;
+	wcout << endl << L"Progrma End." << endl;
 	// Everything worked
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
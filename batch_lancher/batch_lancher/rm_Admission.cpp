@@ -0,0 +1,115 @@
+/*
+File: rm_Admission.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Platform independent parts of rm::AdmissionPolicy and rm::PressureMonitor
+		Sampling the system lives in rm_Admission_posix.cpp and rm_Admission_win32.cpp
+*/
+#include "rm_Admission.hpp"
+
+namespace rm {
+	namespace {
+		// Method: ParsePercent
+		// Purpose: Parses a share of wall time between 0 and 100, 0 is not a threshold
+		bool ParsePercent(std::string_view text, double& output) {
+			return ParseDecimal(text, output) && output > 0 && output <= 100;
+		}
+	}
+
+	// Method: ThrottleName
+	// Output: Name of a reason as it is written in reports
+	wchar_t const* ThrottleName(Throttle reason) {
+		switch (reason) {
+		case Throttle::CpuPressure: return L"cpu";
+		case Throttle::MemoryPressure: return L"memory";
+		case Throttle::IoPressure: return L"io";
+		case Throttle::LowMemory: return L"memory_available";
+		default: return L"none";
+		}
+	}
+
+/// Begin AdmissionPolicy::Operations
+	// Method: AdmissionPolicy::Merge
+	// Input: Settings of the launcher
+	// Purpose: Copies every setting this launchgroup does not set itself
+	void AdmissionPolicy::Merge(AdmissionPolicy const& defaults) {
+		if (cpuPressure == 0) {
+			cpuPressure = defaults.cpuPressure;
+		}
+		if (memoryPressure == 0) {
+			memoryPressure = defaults.memoryPressure;
+		}
+		if (ioPressure == 0) {
+			ioPressure = defaults.ioPressure;
+		}
+		if (memoryAvailable == 0) {
+			memoryAvailable = defaults.memoryAvailable;
+		}
+	}
+
+	// Method: AdmissionPolicy::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid admission setting
+	bool AdmissionPolicy::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "pressure_cpu") {
+			return ParsePercent(value, cpuPressure);
+		}
+		if (key == "pressure_memory") {
+			return ParsePercent(value, memoryPressure);
+		}
+		if (key == "pressure_io") {
+			return ParsePercent(value, ioPressure);
+		}
+		if (key == "memory_available") {
+			return ParseSize(value, memoryAvailable);
+		}
+		return false;
+	}
+
+	// Method: AdmissionPolicy::Check
+	// Input: latest sample of the system
+	// Output: First threshold the sample exceeds, None to start processes
+	Throttle AdmissionPolicy::Check(PressureSample const& sample) const {
+		// Memory is checked first, running out of it is what hurts most
+		if (memoryAvailable > 0 && sample.available > 0 && sample.available < memoryAvailable) {
+			return Throttle::LowMemory;
+		}
+		if (memoryPressure > 0 && sample.memory > memoryPressure) {
+			return Throttle::MemoryPressure;
+		}
+		if (ioPressure > 0 && sample.io > ioPressure) {
+			return Throttle::IoPressure;
+		}
+		if (cpuPressure > 0 && sample.cpu > cpuPressure) {
+			return Throttle::CpuPressure;
+		}
+		return Throttle::None;
+	}
+/// End AdmissionPolicy::Operations
+
+/// Begin PressureMonitor::Operations
+	// Method: PressureMonitor::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid monitor setting
+	bool PressureMonitor::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "pressure_interval") {
+			// Shorter intervals react sooner but measure pressure over less time
+			return ParseDuration(value, interval) && interval >= std::chrono::milliseconds(10);
+		}
+		return false;
+	}
+
+	// Method: PressureMonitor::Get
+	// Input: current time
+	// Output: Latest sample, taken again once the interval has passed
+	PressureSample const& PressureMonitor::Get(clock_type::time_point now) {
+		if (!hasSample || now - sampled >= interval) {
+			Read(now);
+			sampled = now;
+			hasSample = true;
+		}
+		return sample;
+	}
+/// End PressureMonitor::Operations
+}
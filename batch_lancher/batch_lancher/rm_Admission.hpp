@@ -0,0 +1,145 @@
+/*
+File: rm_Admission.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Holds back process starts while the system is under pressure
+		A launchgroup sets how much CPU, memory and I/O pressure and how little available memory
+		it tolerates, the monitor samples the system at most once per interval
+		Pressure is the share of wall time some task stalled on the resource, from Linux PSI
+*/
+#ifndef RM_ADMISSION_HEADER_GUARD
+#define RM_ADMISSION_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <chrono>
+#include <string_view>
+
+namespace rm {
+	// Why processes of a launchgroup are being held back
+	enum class Throttle : unsigned char {
+		None,
+		CpuPressure,
+		MemoryPressure,
+		IoPressure,
+		// Less memory is available than the launchgroup needs
+		LowMemory
+	};
+
+	// Number of reasons a launchgroup is throttled, Throttle::None excluded
+	static const size_t THROTTLE_REASONS = 4;
+
+	// Method: ThrottleName
+	// Output: Name of a reason as it is written in reports
+	wchar_t const* ThrottleName(Throttle reason);
+
+	// State of the system when it was last sampled, pressures are negative where not available
+	struct PressureSample {
+		// Percent of wall time some task stalled on each resource
+		double cpu = -1;
+		double memory = -1;
+		double io = -1;
+		// Bytes of memory available without swapping, 0 if not available
+		unsigned long long available = 0;
+	};
+
+	struct AdmissionPolicy {
+		// Percent of wall time some task may stall on each resource, 0 if not set
+		double cpuPressure = 0;
+		double memoryPressure = 0;
+		double ioPressure = 0;
+		// Bytes of memory that must be available, 0 if not set
+		unsigned long long memoryAvailable = 0;
+
+		// Method: AdmissionPolicy::Merge
+		// Input: Settings of the launcher
+		// Purpose: Copies every setting this launchgroup does not set itself
+		void Merge(AdmissionPolicy const& defaults);
+
+		// Method: AdmissionPolicy::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid admission setting
+		//			pressure_cpu=90 pressure_memory=10 pressure_io=40 memory_available=2G
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: AdmissionPolicy::Enabled
+		// Output: Whether any threshold is set
+		inline bool Enabled() const {
+			return cpuPressure > 0 || memoryPressure > 0 || ioPressure > 0 || memoryAvailable > 0;
+		}
+
+		// Method: AdmissionPolicy::Check
+		// Input: latest sample of the system
+		// Output: First threshold the sample exceeds, None to start processes
+		Throttle Check(PressureSample const& sample) const;
+	};
+
+	class PressureMonitor {
+	public:		/// Types
+		using clock_type = std::chrono::steady_clock;
+		using duration_type = std::chrono::nanoseconds;
+
+		// Sampling interval unless set otherwise
+		static constexpr std::chrono::milliseconds DEFAULT_INTERVAL = std::chrono::milliseconds(250);
+	private:
+		// Resources with a stall counter
+		enum Resource : unsigned int {
+			RESOURCE_CPU,
+			RESOURCE_MEMORY,
+			RESOURCE_IO,
+			RESOURCE_COUNT
+		};
+	private:	/// Variables
+		duration_type interval;
+		PressureSample sample;
+		clock_type::time_point sampled;
+		bool hasSample;
+		// Stall counters in microseconds when last read, pressure is their growth over the interval
+		unsigned long long totals[RESOURCE_COUNT];
+		bool hasTotals;
+#ifndef _WIN32
+		// Pressure files and /proc/meminfo, kept open and read from the start each sample, -1 if missing
+		int files[RESOURCE_COUNT + 1];
+#endif
+	public:		/// Methods
+		/// Constructors
+		PressureMonitor();
+
+		~PressureMonitor();
+
+		PressureMonitor(PressureMonitor const&) = delete;
+		PressureMonitor& operator=(PressureMonitor const&) = delete;
+
+		/// Operations
+		// Method: PressureMonitor::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid monitor setting
+		//			pressure_interval=250ms
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: PressureMonitor::GetInterval
+		// Output: Longest a sample is used for
+		inline duration_type GetInterval() {
+			return interval;
+		}
+
+		// Method: PressureMonitor::Open
+		// Input: Thresholds the launchgroups use, merged so any threshold set anywhere is set
+		// Purpose: Opens what is sampled and reports thresholds the system cannot measure
+		void Open(AdmissionPolicy const& used);
+
+		// Method: PressureMonitor::Close
+		void Close();
+
+		// Method: PressureMonitor::Get
+		// Input: current time
+		// Output: Latest sample, taken again once the interval has passed
+		PressureSample const& Get(clock_type::time_point now);
+	private:
+		// Method: PressureMonitor::Read
+		// Input: time of the sample
+		// Purpose: Reads the stall counters and available memory, platform specific
+		void Read(clock_type::time_point now);
+	};
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+File: rm_Admission_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::PressureMonitor
+		Linux reports stall time in /proc/pressure and available memory in /proc/meminfo,
+		both are kept open and read again from the start, so a sample costs four reads
+*/
+#ifndef _WIN32
+#include "rm_Admission.hpp"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace rm {
+	namespace {
+		// Files sampled, in the order of PressureMonitor::Resource, then available memory
+		char const* const FILES[] = { "/proc/pressure/cpu", "/proc/pressure/memory", "/proc/pressure/io", "/proc/meminfo" };
+
+		// Method: ReadFile
+		// Input: open file, buffer and its size
+		// Output: Text read from the start of the file, empty on failure
+		std::string_view ReadFile(int file, char* buffer, size_t size) {
+			if (file < 0) {
+				return std::string_view();
+			}
+			ssize_t length = pread(file, buffer, size - 1, 0);
+			if (length <= 0) {
+				return std::string_view();
+			}
+			buffer[length] = 0;
+			return std::string_view(buffer, static_cast<size_t>(length));
+		}
+
+		// Method: ReadField
+		// Input: text, name of a field such as "total=" or "MemAvailable:"
+		// Output: Number following the field, 0 if missing
+		double ReadField(std::string_view text, char const* name) {
+			size_t found = text.find(name);
+			if (found == std::string_view::npos) {
+				return 0;
+			}
+			return std::strtod(text.data() + found + std::strlen(name), nullptr);
+		}
+	}
+
+/// Begin PressureMonitor::Constructors
+	PressureMonitor::PressureMonitor()
+		: interval(DEFAULT_INTERVAL), hasSample(false), totals(), hasTotals(false) {
+		for (int& file : files) {
+			file = -1;
+		}
+	}
+
+	PressureMonitor::~PressureMonitor() {
+		Close();
+	}
+/// End PressureMonitor::Constructors
+
+/// Begin PressureMonitor::Operations
+	// Method: PressureMonitor::Open
+	// Input: Thresholds the launchgroups use, merged so any threshold set anywhere is set
+	// Purpose: Opens what is sampled and reports thresholds the system cannot measure
+	void PressureMonitor::Open(AdmissionPolicy const& used) {
+		Close();
+		hasSample = false;
+		hasTotals = false;
+		sample = PressureSample();
+
+		bool wanted[RESOURCE_COUNT + 1] = { used.cpuPressure > 0, used.memoryPressure > 0, used.ioPressure > 0, used.memoryAvailable > 0 };
+		for (unsigned int index = 0; index <= RESOURCE_COUNT; ++index) {
+			if (!wanted[index]) {
+				continue;
+			}
+			files[index] = open(FILES[index], O_RDONLY | O_CLOEXEC);
+			if (files[index] < 0 && index < RESOURCE_COUNT) {
+				std::wcerr << L"Error: " << FILES[index] << L" is not available, pressure thresholds for it are ignored." << std::endl;
+			}
+		}
+#ifndef _SC_AVPHYS_PAGES
+		if (files[RESOURCE_COUNT] < 0 && wanted[RESOURCE_COUNT]) {
+			std::wcerr << L"Error: Available memory can not be read on this system, memory_available is ignored." << std::endl;
+		}
+#endif
+	}
+
+	// Method: PressureMonitor::Close
+	void PressureMonitor::Close() {
+		for (int& file : files) {
+			if (file >= 0) {
+				close(file);
+				file = -1;
+			}
+		}
+	}
+
+	// Method: PressureMonitor::Read
+	// Input: time of the sample
+	// Purpose: Reads the stall counters and available memory
+	void PressureMonitor::Read(clock_type::time_point now) {
+		char buffer[4096];
+		double elapsed = std::chrono::duration<double, std::micro>(now - sampled).count();
+		double* pressures[RESOURCE_COUNT] = { &sample.cpu, &sample.memory, &sample.io };
+		for (unsigned int index = 0; index < RESOURCE_COUNT; ++index) {
+			// "some avg10=1.00 avg60=0.50 avg300=0.10 total=123456", some task stalled on the resource
+			std::string_view text = ReadFile(files[index], buffer, sizeof(buffer));
+			text = text.substr(0, text.find('\n'));
+			if (text.compare(0, 5, "some ") != 0) {
+				*pressures[index] = -1;
+				continue;
+			}
+			unsigned long long total = static_cast<unsigned long long>(ReadField(text, "total="));
+			if (hasTotals && elapsed > 0 && total >= totals[index]) {
+				// Stalled time over the interval, which reacts sooner than the kernel's ten second average
+				double percent = static_cast<double>(total - totals[index]) / elapsed * 100;
+				*pressures[index] = percent > 100 ? 100 : percent;
+			}
+			else {
+				*pressures[index] = ReadField(text, "avg10=");
+			}
+			totals[index] = total;
+		}
+		hasTotals = true;
+
+		std::string_view meminfo = ReadFile(files[RESOURCE_COUNT], buffer, sizeof(buffer));
+		if (!meminfo.empty()) {
+			sample.available = static_cast<unsigned long long>(ReadField(meminfo, "MemAvailable:")) * 1024;
+		}
+#ifdef _SC_AVPHYS_PAGES
+		else if (files[RESOURCE_COUNT] < 0) {
+			// Free memory only, without the caches the kernel would give up
+			sample.available = static_cast<unsigned long long>(sysconf(_SC_AVPHYS_PAGES)) * static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+		}
+#endif
+	}
+/// End PressureMonitor::Operations
+}
+#endif
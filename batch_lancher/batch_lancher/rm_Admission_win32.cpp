@@ -0,0 +1,55 @@
+/*
+File: rm_Admission_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::PressureMonitor
+		Windows has no stall accounting, only available memory is sampled
+*/
+#ifdef _WIN32
+#include "rm_Admission.hpp"
+#include <Windows.h>
+#include <iostream>
+
+namespace rm {
+/// Begin PressureMonitor::Constructors
+	PressureMonitor::PressureMonitor()
+		: interval(DEFAULT_INTERVAL), hasSample(false), totals(), hasTotals(false) {
+
+	}
+
+	PressureMonitor::~PressureMonitor() {
+
+	}
+/// End PressureMonitor::Constructors
+
+/// Begin PressureMonitor::Operations
+	// Method: PressureMonitor::Open
+	// Input: Thresholds the launchgroups use, merged so any threshold set anywhere is set
+	// Purpose: Reports thresholds the system cannot measure
+	void PressureMonitor::Open(AdmissionPolicy const& used) {
+		hasSample = false;
+		sample = PressureSample();
+		if (used.cpuPressure > 0 || used.memoryPressure > 0 || used.ioPressure > 0) {
+			std::wcerr << L"Error: Pressure stall information is not available on Windows, pressure thresholds are ignored." << std::endl;
+		}
+	}
+
+	// Method: PressureMonitor::Close
+	void PressureMonitor::Close() {
+
+	}
+
+	// Method: PressureMonitor::Read
+	// Input: time of the sample
+	// Purpose: Reads the available memory
+	void PressureMonitor::Read(clock_type::time_point) {
+		MEMORYSTATUSEX status = {};
+		status.dwLength = sizeof(status);
+		if (GlobalMemoryStatusEx(&status)) {
+			sample.available = status.ullAvailPhys;
+		}
+	}
+/// End PressureMonitor::Operations
+}
+#endif
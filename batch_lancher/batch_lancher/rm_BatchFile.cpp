@@ -0,0 +1,120 @@
+/*
+File: rm_BatchFile.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Memory maps a UTF-8 input file and hands out its lines as slices
+		No characters are copied until a process is created from a line
+*/
+#include "rm_BatchFile.hpp"
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace rm {
+/// Begin BatchFile::Constructors
+	BatchFile::BatchFile() {
+
+	}
+
+	BatchFile::~BatchFile() {
+		Close();
+	}
+/// End BatchFile::Constructors
+
+/// Begin BatchFile::Operations
+	// Method: BatchFile::Open
+	// Input: path of the input file
+	// Output: Whether the file could be opened
+	// Purpose: Maps the file into memory, or reads it in one block if it can not be mapped
+	bool BatchFile::Open(std::string const& path) {
+		Close();
+
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file != INVALID_HANDLE_VALUE) {
+			LARGE_INTEGER length;
+			if (GetFileSizeEx(file, &length)) {
+				if (length.QuadPart == 0) {
+					// Empty files can not be mapped
+					return true;
+				}
+				mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+				if (mapping != NULL) {
+					data = static_cast<char const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					size = data != nullptr ? static_cast<size_type>(length.QuadPart) : 0;
+				}
+			}
+		}
+#else
+		int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd != -1) {
+			struct stat info;
+			if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+				if (info.st_size == 0) {
+					// Empty files can not be mapped
+					close(fd);
+					return true;
+				}
+				void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (view != MAP_FAILED) {
+					madvise(view, info.st_size, MADV_SEQUENTIAL);
+					mapping = view;
+					data = static_cast<char const*>(view);
+					size = static_cast<size_type>(info.st_size);
+				}
+			}
+			close(fd);
+		}
+#endif
+
+		if (data == nullptr) {
+			// Pipes and other unmappable files are read in one block
+			std::ifstream stream(path, std::ios::binary);
+			if (!stream) {
+				Close();
+				return false;
+			}
+			buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+			data = buffer.data();
+			size = buffer.size();
+		}
+
+		// Skip a UTF-8 byte order mark
+		if (size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF') {
+			offset = 3;
+		}
+		return true;
+	}
+
+	// Method: BatchFile::Close
+	// Purpose: Releases the file, invalidating every line handed out
+	void BatchFile::Close() {
+#ifdef _WIN32
+		if (mapping != NULL) {
+			UnmapViewOfFile(data);
+			CloseHandle(mapping);
+			mapping = NULL;
+		}
+		if (file != INVALID_HANDLE_VALUE) {
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (mapping != nullptr) {
+			munmap(mapping, size);
+			mapping = nullptr;
+		}
+#endif
+		buffer.clear();
+		data = nullptr;
+		size = 0;
+		offset = 0;
+		lineNumber = 0;
+	}
+/// End BatchFile::Operations
+}
@@ -0,0 +1,113 @@
+/*
+File: rm_BatchFile.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Memory maps a UTF-8 input file and hands out its lines as slices
+		No characters are copied until a process is created from a line
+*/
+#ifndef RM_BATCHFILE_HEADER_GUARD
+#define RM_BATCHFILE_HEADER_GUARD
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace rm {
+	class BatchFile {
+	public:		/// Types
+		using size_type = size_t;
+		using line_type = std::string_view;
+	private:	/// Variables
+		char const* data = nullptr;
+		size_type size = 0;
+		size_type offset = 0;
+		size_type lineNumber = 0;
+		// Holds the file when it could not be mapped
+		std::vector<char> buffer;
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = NULL;
+#else
+		void* mapping = nullptr;
+#endif
+	public:		/// Methods
+		/// Constructors
+		BatchFile();
+
+		~BatchFile();
+
+		BatchFile(BatchFile const&) = delete;
+		BatchFile& operator=(BatchFile const&) = delete;
+
+		/// Operations
+		// Method: BatchFile::Open
+		// Input: path of the input file
+		// Output: Whether the file could be opened
+		// Purpose: Maps the file into memory, or reads it in one block if it can not be mapped
+		bool Open(std::string const& path);
+
+		// Method: BatchFile::Close
+		// Purpose: Releases the file, invalidating every line handed out
+		void Close();
+
+		// Method: BatchFile::NextLine
+		// Input: output line, without its line ending
+		// Output: Whether a line was found
+		// Purpose: Finds the next line, lines stay valid until the file is closed
+		inline bool NextLine(line_type& line) noexcept {
+			if (offset >= size) {
+				return false;
+			}
+			char const* begin = data + offset;
+			char const* end = static_cast<char const*>(std::memchr(begin, '\n', size - offset));
+			if (end == nullptr) {
+				end = data + size;
+			}
+			offset = (end - data) + 1;
+			++lineNumber;
+
+			// Accept Windows line endings
+			size_type length = end - begin;
+			if (length > 0 && begin[length - 1] == '\r') {
+				--length;
+			}
+			line = line_type(begin, length);
+			return true;
+		}
+
+		// Method: BatchFile::CountLines
+		// Output: Number of lines in the file, including blank lines
+		inline size_type CountLines() {
+			size_type lines = std::count(data + offset, data + size, '\n');
+			if (size > offset && data[size - 1] != '\n') {
+				++lines;
+			}
+			return lines;
+		}
+
+		// Method: BatchFile::GetLineNumber
+		// Output: Line number of the last line returned by NextLine, starting from 1
+		inline size_type GetLineNumber() {
+			return lineNumber;
+		}
+
+		// Method: BatchFile::Data
+		// Output: Contents of the whole file, valid until the file is closed
+		inline char const* Data() {
+			return data;
+		}
+
+		// Method: BatchFile::Size
+		// Output: Size of the file in bytes
+		inline size_type Size() {
+			return size;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,422 @@
+/*
+File: rm_Benchmark.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Measures the cost of the launcher's own work
+*/
+#include "rm_Benchmark.hpp"
+#include "rm_Launcher.hpp"
+#include "rm_BatchFile.hpp"
+#include "rm_Process.hpp"
+#include "rm_StringPool.hpp"
+#include "rm_ForkServer.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <locale>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <codecvt>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+namespace rm {
+	namespace {
+		using clock_type = std::chrono::steady_clock;
+		using seconds = std::chrono::duration<double>;
+
+		// Number of times each measurement is repeated, the fastest is reported
+		const int REPEATS = 3;
+
+		// Method: PrintRate
+		// Purpose: Prints one benchmark result line
+		void PrintRate(std::wostream& outstream, wchar_t const* name, size_t lines, seconds time) {
+			outstream << std::left << std::setw(10) << name << std::right
+				<< std::setw(12) << lines << L" lines"
+				<< std::setw(12) << std::fixed << std::setprecision(4) << time.count() << L" s"
+				<< std::setw(14) << std::setprecision(0) << lines / time.count() << L" lines/s" << std::endl;
+			outstream.unsetf(std::ios_base::floatfield);
+			outstream.precision(6);
+		}
+
+		// Processes started together when measuring throughput, as a scheduler with that many slots would
+		const size_t LAUNCH_BATCH = 32;
+
+		// Results of launching the same command one way
+		struct LaunchRun {
+			size_t failures = 0;
+			// Launching one at a time, and LAUNCH_BATCH at a time before waiting for them
+			seconds sequential = seconds::zero();
+			seconds batched = seconds::zero();
+			Process::duration_type spawn = Process::duration_type::zero();
+			Process::duration_type overhead = Process::duration_type::zero();
+		};
+
+		// Method: MeasureLaunches
+		// Purpose: Launches the command count times one at a time, then count times LAUNCH_BATCH at a time
+		LaunchRun MeasureLaunches(size_t count, native_string_view app, native_string_view params) {
+			LaunchRun run;
+			for (int pass = 0; pass < 2; ++pass) {
+				// Processes are built up front, as they would be when parsing
+				StringPool pool;
+				std::vector<Process> procs;
+				procs.reserve(count);
+				for (size_t i = 0; i < count; ++i) {
+					procs.emplace_back(1, pool, app, params);
+				}
+
+				// One at a time so launches do not compete with each other, then several at a time
+				// so a launch overlaps the children still starting, as it does when running a batch
+				size_t batch = pass == 0 ? 1 : LAUNCH_BATCH;
+				clock_type::time_point begin = clock_type::now();
+				for (size_t first = 0; first < count; first += batch) {
+					size_t last = std::min(count, first + batch);
+					for (size_t i = first; i < last; ++i) {
+						procs[i].StartAsync();
+					}
+					for (size_t i = first; i < last; ++i) {
+						procs[i].Wait();
+					}
+				}
+				(pass == 0 ? run.sequential : run.batched) = clock_type::now() - begin;
+
+				for (Process& proc : procs) {
+					if (!proc.DidRun()) {
+						++run.failures;
+					}
+					if (pass == 0) {
+						run.spawn += proc.GetSpawnLatency();
+						run.overhead += proc.GetLaunchOverhead() - proc.GetSpawnLatency();
+					}
+				}
+			}
+			return run;
+		}
+
+		// Method: PrintLaunches
+		// Purpose: Prints the results of launching one way
+		void PrintLaunches(std::wostream& outstream, wchar_t const* name, size_t count, LaunchRun const& run) {
+			using microseconds = std::chrono::duration<double, std::micro>;
+			outstream << name << L":" << std::endl
+				<< std::fixed << std::setprecision(1)
+				<< L"  Launches/s: " << count / run.sequential.count() << L" one at a time, "
+				<< count / run.batched.count() << L" " << LAUNCH_BATCH << L" at a time" << std::endl
+				<< L"  Spawn latency (us): mean " << microseconds(run.spawn).count() / count << std::endl
+				<< L"  Launch overhead outside spawn (us): mean " << microseconds(run.overhead).count() / count << std::endl;
+			outstream.unsetf(std::ios_base::floatfield);
+			outstream.precision(6);
+			if (run.failures != 0) {
+				outstream << L"Error: " << run.failures << L" launches failed." << std::endl;
+			}
+		}
+
+		// Version of the suite's output, bumped whenever a field changes meaning
+		const int SUITE_SCHEMA = 1;
+
+		// One generated batch file
+		struct Scenario {
+			char const* workload;
+			size_t jobs;
+			size_t groups;
+			// Length of the padding argument added to every command
+			size_t padding;
+			// Whether the processes are run, or only parsed
+			bool run;
+			// Fork server helpers spawning the processes, 0 to spawn them directly
+			size_t forkServers;
+		};
+
+		// Scenarios of the suite, kept short enough to run on every change
+		const Scenario SCENARIOS[] = {
+			{ "true", 1000, 1, 0, true, 0 },
+			{ "true", 1000, 1, 0, true, 2 },
+			{ "true", 1000, 10, 0, true, 0 },
+			{ "true", 1000, 1, 1024, true, 0 },
+			{ "sleep", 200, 1, 0, true, 0 },
+			{ "sleep", 200, 20, 0, true, 0 },
+			{ "cpu", 100, 1, 0, true, 0 },
+			{ "true", 100000, 1, 0, false, 0 },
+			{ "true", 100000, 100, 1024, false, 0 }
+		};
+
+		// Method: WorkloadCommand
+		// Purpose: Application and parameters of a workload, separated by a comma as in a batch file
+		char const* WorkloadCommand(std::string const& workload) {
+#ifdef _WIN32
+			if (workload == "sleep") {
+				return "cmd.exe, /c \"ping -n 1 127.0.0.1 >nul\"";
+			}
+			if (workload == "cpu") {
+				return "cmd.exe, /c \"for /l %i in (1 1 20000) do rem\"";
+			}
+			return "cmd.exe, /c exit";
+#else
+			if (workload == "sleep") {
+				return "sleep, 0.01";
+			}
+			if (workload == "cpu") {
+				return "sh, -c \"i=0; while [ $i -lt 20000 ]; do i=$((i+1)); done\"";
+			}
+			return "true,";
+#endif
+		}
+
+		// Method: SelfCpuTime
+		// Purpose: User and kernel time used by the launcher itself
+		seconds SelfCpuTime() {
+#ifdef _WIN32
+			FILETIME creation, exit, kernel, user;
+			GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+			long long ticks = (static_cast<long long>(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime)
+				+ (static_cast<long long>(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+			return seconds(ticks / 1e7);
+#else
+			rusage usage;
+			getrusage(RUSAGE_SELF, &usage);
+			return seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+				+ (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6);
+#endif
+		}
+
+		// Method: Percentile
+		// Purpose: Nearest rank percentile of sorted values, 0 when there are none
+		double Percentile(std::vector<double> const& sorted, double percent) {
+			if (sorted.empty()) {
+				return 0;
+			}
+			size_t rank = static_cast<size_t>(percent / 100 * sorted.size() + 0.999999);
+			return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+		}
+
+		// Method: RunScenario
+		// Purpose: Generates, parses and runs one scenario, writing its JSON object
+		bool RunScenario(Scenario const& scenario, std::wostream& report, std::wostream& progress) {
+			std::wstring name = FromUtf8(std::string(scenario.workload) + "-" + std::to_string(scenario.jobs) + "j-"
+				+ std::to_string(scenario.groups) + "g-" + std::to_string(scenario.padding) + "p" + (scenario.run ? "" : "-parse")
+				+ (scenario.forkServers != 0 ? "-fork" + std::to_string(scenario.forkServers) : ""));
+			progress << L"Scenario " << name << std::endl;
+
+			// Launchgroups are contiguous, as they usually are in real files
+			std::filesystem::path path = std::filesystem::temp_directory_path()
+				/ ("rm_bench_" + std::to_string(clock_type::now().time_since_epoch().count()) + ".txt");
+			{
+				std::ofstream file(path, std::ios::binary);
+				std::string padding(scenario.padding, 'x');
+				std::string command = WorkloadCommand(scenario.workload);
+				if (scenario.forkServers != 0) {
+					file << "@set fork_server=" << scenario.forkServers << '\n';
+				}
+				for (size_t job = 0; job < scenario.jobs; ++job) {
+					file << job * scenario.groups / scenario.jobs + 1 << ", " << command;
+					if (!padding.empty()) {
+						file << " " << padding;
+					}
+					file << '\n';
+				}
+				if (!file) {
+					progress << L"Error: Could not write " << path.wstring() << std::endl;
+					return false;
+				}
+			}
+
+			Launcher launcher;
+			BatchFile file;
+			clock_type::time_point begin = clock_type::now();
+			bool opened = file.Open(path.string());
+			if (opened) {
+				file >> launcher;
+			}
+			seconds parseTime = clock_type::now() - begin;
+			file.Close();
+			std::error_code ignored;
+			std::filesystem::remove(path, ignored);
+			if (!opened) {
+				progress << L"Error: Could not read " << path.wstring() << std::endl;
+				return false;
+			}
+
+			size_t commandBytes = launcher.GetProcesses().empty() ? 0 : launcher.GetProcesses().front().GetCommand().size() * sizeof(native_char);
+			report << L"{\"schema\":" << SUITE_SCHEMA
+				<< L",\"scenario\":\"" << name << L"\""
+				<< L",\"workload\":\"" << scenario.workload << L"\""
+				<< L",\"jobs\":" << scenario.jobs
+				<< L",\"groups\":" << scenario.groups
+				<< L",\"fork_servers\":" << scenario.forkServers
+				<< L",\"command_bytes\":" << commandBytes
+				<< std::fixed << std::setprecision(6)
+				<< L",\"parse_s\":" << parseTime.count();
+
+			if (scenario.run) {
+				seconds cpuBegin = SelfCpuTime();
+				launcher.RunAll();
+				seconds cpuTime = SelfCpuTime() - cpuBegin;
+
+				using microseconds = std::chrono::duration<double, std::micro>;
+				std::vector<double> spawns;
+				for (Process& proc : launcher.GetProcesses()) {
+					if (proc.DidRun()) {
+						spawns.push_back(microseconds(proc.GetSpawnLatency()).count());
+					}
+				}
+				std::sort(spawns.begin(), spawns.end());
+
+				// The ideal is limited by the longest dependency chain and by the number of slots
+				Scheduler::Stats const& stats = launcher.GetSchedule();
+				seconds makespan = stats.makespan;
+				seconds ideal = std::max<seconds>(stats.criticalPath, seconds(stats.busyTime) / std::max<size_t>(stats.slots, 1));
+				double jobs = static_cast<double>(std::max<size_t>(scenario.jobs, 1));
+
+				report << L",\"slots\":" << stats.slots
+					<< L",\"started\":" << stats.started
+					<< std::setprecision(1)
+					<< L",\"spawn_p50_us\":" << Percentile(spawns, 50)
+					<< L",\"spawn_p90_us\":" << Percentile(spawns, 90)
+					<< L",\"spawn_p99_us\":" << Percentile(spawns, 99)
+					<< L",\"spawn_max_us\":" << (spawns.empty() ? 0 : spawns.back())
+					<< L",\"launcher_cpu_us_per_job\":" << microseconds(cpuTime).count() / jobs
+					<< L",\"scheduler_overhead_us_per_job\":" << microseconds(stats.overhead).count() / jobs
+					<< std::setprecision(6)
+					<< L",\"makespan_s\":" << makespan.count()
+					<< L",\"jobs_per_s\":" << (makespan.count() > 0 ? jobs / makespan.count() : 0)
+					<< L",\"ideal_s\":" << ideal.count()
+					<< L",\"efficiency\":" << (makespan.count() > 0 ? ideal.count() / makespan.count() : 0);
+			}
+			report << L"}" << std::endl;
+			report.unsetf(std::ios_base::floatfield);
+			report.precision(6);
+			return true;
+		}
+	}
+
+	// Method: BenchmarkParse
+	// Input: path of an input file, output stream for results
+	// Output: Whether the file could be parsed
+	// Purpose: Compares lines per second of the wifstream parser, the memory mapped parser
+	//			and loading the file compiled, and reports the memory used to store the parsed processes
+	bool BenchmarkParse(std::string const& path, std::wostream& outstream) {
+		seconds streamTime = seconds::max();
+		seconds mappedTime = seconds::max();
+		seconds compiledTime = seconds::max();
+		size_t lines = 0;
+		size_t processes = 0;
+		size_t footprint = 0;
+
+		for (int repeat = 0; repeat < REPEATS; ++repeat) {
+			// Launchers are destroyed outside of the timed section
+			std::unique_ptr<Launcher> streamed(new Launcher);
+			std::unique_ptr<Launcher> mapped(new Launcher);
+
+			// Character at a time wifstream parser
+			std::wifstream stream(path);
+			if (!stream) {
+				return false;
+			}
+#ifndef _WIN32
+			stream.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
+#endif
+			clock_type::time_point begin = clock_type::now();
+			stream >> *streamed;
+			streamTime = std::min<seconds>(streamTime, clock_type::now() - begin);
+
+			// Memory mapped parser
+			BatchFile file;
+			begin = clock_type::now();
+			if (!file.Open(path)) {
+				return false;
+			}
+			file >> *mapped;
+			mappedTime = std::min<seconds>(mappedTime, clock_type::now() - begin);
+			lines = file.GetLineNumber();
+			processes = mapped->GetProcessCount();
+			footprint = mapped->GetMemoryFootprint();
+		}
+
+		// Compiled once, only opening and loading it is timed
+		std::error_code error;
+		std::string compiledPath = (std::filesystem::temp_directory_path(error) / "rm_bench_parse.rmbatch").string();
+		{
+			Launcher source;
+			BatchFile file;
+			if (!file.Open(path)) {
+				return false;
+			}
+			file >> source;
+			if (!source.Compile(compiledPath)) {
+				return false;
+			}
+		}
+		for (int repeat = 0; repeat < REPEATS; ++repeat) {
+			std::unique_ptr<Launcher> compiled(new Launcher);
+			clock_type::time_point begin = clock_type::now();
+			if (!compiled->ParseFiles(std::vector<std::string>(1, compiledPath))) {
+				std::filesystem::remove(compiledPath, error);
+				return false;
+			}
+			compiledTime = std::min<seconds>(compiledTime, clock_type::now() - begin);
+		}
+		std::filesystem::remove(compiledPath, error);
+
+		outstream << L"Parse benchmark, best of " << REPEATS << L": " << path.c_str() << std::endl;
+		PrintRate(outstream, L"wifstream", lines, streamTime);
+		PrintRate(outstream, L"mapped", lines, mappedTime);
+		PrintRate(outstream, L"compiled", lines, compiledTime);
+		outstream << L"Speedup: " << std::fixed << std::setprecision(2) << streamTime / mappedTime << L"x" << std::endl
+			<< L"Compiled speedup: " << mappedTime / compiledTime << L"x over mapped, "
+			<< streamTime / compiledTime << L"x over wifstream" << std::endl;
+		outstream.unsetf(std::ios_base::floatfield);
+		outstream << L"Storage: " << processes << L" processes in " << footprint << L" bytes" << std::endl;
+		return true;
+	}
+
+	// Method: BenchmarkLaunch
+	// Input: number of launches, application and parameters to launch, output stream for results
+	// Output: Whether every launch succeeded
+	// Purpose: Measures launches per second and the time spent launching outside the operating system,
+	//			spawning directly and through a fork server
+	bool BenchmarkLaunch(size_t count, native_string_view app, native_string_view params, std::wostream& outstream) {
+		outstream << L"Launch benchmark: " << count << L" x " << ToWide(app) << L" " << ToWide(params) << std::endl;
+		LaunchRun direct = MeasureLaunches(count, app, params);
+		PrintLaunches(outstream, L"Direct", count, direct);
+
+		// Launches go through one helper, as they would with @set fork_server=1
+		ForkServer server;
+		server.SetCount(1);
+		if (!server.Open()) {
+			return direct.failures == 0;
+		}
+		Process::SetForkServer(&server);
+		LaunchRun served = MeasureLaunches(count, app, params);
+		Process::SetForkServer(nullptr);
+		server.Close();
+		PrintLaunches(outstream, L"Fork server", count, served);
+		outstream << std::fixed << std::setprecision(2)
+			<< L"Fork server speedup: " << direct.sequential / served.sequential << L"x one at a time, "
+			<< direct.batched / served.batched << L"x " << LAUNCH_BATCH << L" at a time" << std::endl;
+		outstream.unsetf(std::ios_base::floatfield);
+		outstream.precision(6);
+		return direct.failures == 0 && served.failures == 0;
+	}
+
+	// Method: BenchmarkSuite
+	// Input: stream for one JSON object per scenario, stream for progress
+	// Output: Whether every scenario ran
+	// Purpose: Generates synthetic batch files of varying job count, launchgroup count and command length,
+	//			runs them against trivial children and reports parse time, spawn latency percentiles,
+	//			scheduler overhead per job and makespan against the ideal
+	bool BenchmarkSuite(std::wostream& report, std::wostream& progress) {
+		bool valid = true;
+		for (Scenario const& scenario : SCENARIOS) {
+			if (!RunScenario(scenario, report, progress)) {
+				valid = false;
+			}
+		}
+		return valid;
+	}
+}
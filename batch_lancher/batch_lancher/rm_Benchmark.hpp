@@ -0,0 +1,38 @@
+/*
+File: rm_Benchmark.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Measures the cost of the launcher's own work
+*/
+#ifndef RM_BENCHMARK_HEADER_GUARD
+#define RM_BENCHMARK_HEADER_GUARD
+#include <string>
+#include <ostream>
+#include "rm_lib.hpp"
+
+namespace rm {
+	// Method: BenchmarkParse
+	// Input: path of an input file, output stream for results
+	// Output: Whether the file could be parsed
+	// Purpose: Compares lines per second of the wifstream parser and the memory mapped parser
+	//			and reports the memory used to store the parsed processes
+	bool BenchmarkParse(std::string const& path, std::wostream& outstream);
+
+	// Method: BenchmarkLaunch
+	// Input: number of launches, application and parameters to launch, output stream for results
+	// Output: Whether every launch succeeded
+	// Purpose: Measures launches per second and the time spent launching outside the operating system,
+	//			spawning directly and through a fork server
+	bool BenchmarkLaunch(size_t count, native_string_view app, native_string_view params, std::wostream& outstream);
+
+	// Method: BenchmarkSuite
+	// Input: stream for one JSON object per scenario, stream for progress
+	// Output: Whether every scenario ran
+	// Purpose: Generates synthetic batch files of varying job count, launchgroup count and command length,
+	//			runs them against trivial children and reports parse time, spawn latency percentiles,
+	//			scheduler overhead per job and makespan against the ideal
+	bool BenchmarkSuite(std::wostream& report, std::wostream& progress);
+}
+
+#endif
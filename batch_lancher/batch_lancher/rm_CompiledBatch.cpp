@@ -0,0 +1,426 @@
+/*
+File: rm_CompiledBatch.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Compiled batch files, written by Launcher::Compile and read by Launcher::LoadCompiled
+		The file is a header followed by the directive text, the launchgroup index, the job table,
+		the argument table and the string pool, each section padded to 8 bytes
+		Strings are stored as the pool holds them, so loading copies them in one block
+		and points each process into it without parsing anything
+		Values are in the byte order and text in the native character type of the machine
+*/
+#include "rm_Launcher.hpp"
+#include "rm_History.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+namespace rm {
+	namespace {
+		// Identifies the file, the last character is the version of its layout
+		char const FILE_TAG[8] = { 'R', 'M', 'B', 'A', 'T', 'C', 'H', '6' };
+
+		struct CompiledHeader {
+			char tag[8];
+			// Bytes per character of the string pool, files do not move between POSIX and Windows
+			std::uint32_t charSize;
+			std::uint32_t reserved;
+			// 64 bit FNV-1a over the 8 byte words following the header
+			std::uint64_t checksum;
+			std::uint64_t directiveBytes;
+			std::uint64_t groupCount;
+			std::uint64_t jobCount;
+			std::uint64_t argumentCount;
+			// Characters in the string pool, including terminators
+			std::uint64_t stringChars;
+		};
+		static_assert(sizeof(CompiledHeader) == 64, "compiled headers are 64 bytes");
+
+		// Contiguous processes of one launchgroup
+		struct CompiledGroup {
+			std::uint64_t group;
+			std::uint64_t first;
+			std::uint64_t count;
+		};
+		static_assert(sizeof(CompiledGroup) == 24, "compiled launchgroups are 24 bytes");
+
+		// One process, strings are character offsets into the string pool
+		struct CompiledJob {
+			std::uint64_t group;
+			std::uint64_t command;
+			std::uint32_t commandLength;
+			std::uint32_t appLength;
+			std::uint64_t id;
+			std::uint64_t dependencies;
+			std::uint64_t inputs;
+			// Placement settings in batch file form, empty for none
+			std::uint64_t placement;
+			std::uint32_t idLength;
+			std::uint32_t dependenciesLength;
+			std::uint32_t inputsLength;
+			std::uint32_t placementLength;
+			// Environment text and working directory
+			std::uint64_t environment;
+			std::uint64_t directory;
+			std::uint32_t environmentLength;
+			std::uint32_t directoryLength;
+			std::int64_t timeout;
+			// First entry of the argument table, argv on POSIX
+			std::uint64_t arguments;
+			std::uint32_t argumentCount;
+			std::uint16_t reserved;
+			std::uint8_t outputMode;
+			std::uint8_t cacheable;
+			// Sweep axes in batch file form, empty for a single job
+			std::uint64_t sweep;
+			std::uint32_t sweepLength;
+			// Job ids piped into stdin
+			std::uint32_t sourcesLength;
+			std::uint64_t sources;
+			// Retry settings of the job in batch file form, empty for its launchgroup's
+			std::uint64_t retry;
+			std::uint32_t retryLength;
+			std::uint32_t reservedRetry;
+			std::int64_t grace;
+		};
+		static_assert(sizeof(CompiledJob) == 168, "compiled jobs are 168 bytes");
+
+		// Method: Padded
+		// Purpose: Rounds a section size up to the next 8 bytes
+		inline std::uint64_t Padded(std::uint64_t bytes) {
+			return (bytes + 7) & ~std::uint64_t(7);
+		}
+
+		// Method: Checksum
+		// Purpose: 64 bit FNV-1a over 8 byte words, the sections are padded so there is no remainder
+		std::uint64_t Checksum(char const* data, std::uint64_t bytes) {
+			std::uint64_t hash = 14695981039346656037ULL;
+			for (std::uint64_t offset = 0; offset + 8 <= bytes; offset += 8) {
+				std::uint64_t word;
+				std::memcpy(&word, data + offset, sizeof(word));
+				hash ^= word;
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		// Method: FromNative
+		// Purpose: Converts native text to UTF-8, on POSIX it already is
+		std::string FromNative(native_string_view text) {
+#ifdef _WIN32
+			return ToUtf8(std::wstring(text));
+#else
+			return std::string(text);
+#endif
+		}
+	}
+
+/// Begin Launcher::Operations
+	// Method: rm::Launcher::IsCompiled
+	// Input: opened batch file
+	// Output: Whether it is a compiled batch file rather than text
+	bool rm::Launcher::IsCompiled(BatchFile& file) {
+		return file.Size() >= sizeof(FILE_TAG) && std::memcmp(file.Data(), FILE_TAG, sizeof(FILE_TAG) - 1) == 0;
+	}
+
+	// Method: rm::Launcher::Compile
+	// Input: path of the compiled file to write
+	// Output: Whether the file was written
+	// Purpose: Writes the parsed processes and directives so a later run can load them without parsing
+	bool rm::Launcher::Compile(std::string const& path) {
+		BuildIndex();
+
+		std::string directives;
+		for (std::pair<size_type, std::string> const& directive : _directives) {
+			directives += directive.second;
+			directives += '\n';
+		}
+
+		// Every string is followed by its terminator, as in the pool
+		std::vector<native_char> strings;
+		auto add = [&strings](native_string_view text) {
+			std::uint64_t offset = strings.size();
+			strings.insert(strings.end(), text.begin(), text.end());
+			strings.push_back(0);
+			return offset;
+		};
+		// Environments and working directories are shared by many processes and written once
+		std::map<native_string_view, std::uint64_t> shared;
+		auto share = [&shared, &add](native_string_view text) {
+			std::map<native_string_view, std::uint64_t>::iterator found = shared.find(text);
+			return found != shared.end() ? found->second : shared[text] = add(text);
+		};
+
+		std::vector<CompiledGroup> groups;
+		std::vector<CompiledJob> jobs;
+		std::vector<std::uint64_t> arguments;
+		jobs.reserve(_processes.size());
+		for (Process& proc : _processes) {
+			if (groups.empty() || groups.back().group != proc.GetLaunchGroup()) {
+				groups.push_back(CompiledGroup{ proc.GetLaunchGroup(), jobs.size(), 0 });
+			}
+			++groups.back().count;
+
+			CompiledJob job = {};
+			job.group = proc.GetLaunchGroup();
+			job.command = add(proc.GetCommand());
+			job.commandLength = static_cast<std::uint32_t>(proc.GetCommand().size());
+			job.appLength = static_cast<std::uint32_t>(proc.GetApp().size());
+			job.id = add(proc.GetId());
+			job.idLength = static_cast<std::uint32_t>(proc.GetId().size());
+			job.dependencies = add(proc.GetDependencyList());
+			job.dependenciesLength = static_cast<std::uint32_t>(proc.GetDependencyList().size());
+			job.inputs = add(proc.GetInputList());
+			job.inputsLength = static_cast<std::uint32_t>(proc.GetInputList().size());
+			job.sources = add(proc.GetSourceList());
+			job.sourcesLength = static_cast<std::uint32_t>(proc.GetSourceList().size());
+			if (proc.GetPlacement() != nullptr) {
+				native_string placement(ToNative(ToUtf8(proc.GetPlacement()->Describe())));
+				job.placement = add(placement);
+				job.placementLength = static_cast<std::uint32_t>(placement.size());
+			}
+			if (proc.GetRetry() != nullptr) {
+				native_string retry(ToNative(proc.GetRetry()->Describe()));
+				job.retry = add(retry);
+				job.retryLength = static_cast<std::uint32_t>(retry.size());
+			}
+			if (proc.GetSweep() != nullptr) {
+				native_string sweep(ToNative(proc.GetSweep()->Describe()));
+				job.sweep = add(sweep);
+				job.sweepLength = static_cast<std::uint32_t>(sweep.size());
+			}
+			job.environment = share(proc.GetEnvironmentText());
+			job.environmentLength = static_cast<std::uint32_t>(proc.GetEnvironmentText().size());
+			job.directory = share(proc.GetDirectory());
+			job.directoryLength = static_cast<std::uint32_t>(proc.GetDirectory().size());
+			job.timeout = proc.GetTimeout().count();
+			job.grace = proc.GetGrace().count();
+			job.outputMode = static_cast<std::uint8_t>(proc.GetOutputMode());
+			job.cacheable = proc.IsCacheable() ? 1 : 0;
+			job.arguments = arguments.size();
+#ifndef _WIN32
+			for (native_char** argument = proc.GetArguments(); argument != nullptr && *argument != nullptr; ++argument) {
+				arguments.push_back(add(*argument));
+			}
+#endif
+			job.argumentCount = static_cast<std::uint32_t>(arguments.size() - job.arguments);
+			jobs.push_back(job);
+		}
+
+		// Sections are laid out in memory first, so the checksum can go in the header
+		CompiledHeader header = {};
+		std::memcpy(header.tag, FILE_TAG, sizeof(FILE_TAG));
+		header.charSize = sizeof(native_char);
+		header.directiveBytes = directives.size();
+		header.groupCount = groups.size();
+		header.jobCount = jobs.size();
+		header.argumentCount = arguments.size();
+		header.stringChars = strings.size();
+
+		std::vector<char> body(static_cast<size_type>(Padded(directives.size()) + groups.size() * sizeof(CompiledGroup)
+			+ jobs.size() * sizeof(CompiledJob) + arguments.size() * sizeof(std::uint64_t) + Padded(strings.size() * sizeof(native_char))), 0);
+		char* output = body.data();
+		std::memcpy(output, directives.data(), directives.size());
+		output += Padded(directives.size());
+		std::memcpy(output, groups.data(), groups.size() * sizeof(CompiledGroup));
+		output += groups.size() * sizeof(CompiledGroup);
+		std::memcpy(output, jobs.data(), jobs.size() * sizeof(CompiledJob));
+		output += jobs.size() * sizeof(CompiledJob);
+		std::memcpy(output, arguments.data(), arguments.size() * sizeof(std::uint64_t));
+		output += arguments.size() * sizeof(std::uint64_t);
+		std::memcpy(output, strings.data(), strings.size() * sizeof(native_char));
+		header.checksum = Checksum(body.data(), body.size());
+
+		// Written aside and renamed so a crash never leaves half a file
+		std::filesystem::path target(path);
+		std::filesystem::path partial = target;
+		partial += RM_TEXT(".partial");
+		{
+			std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			file.write(body.data(), body.size());
+			if (!file) {
+				std::wcerr << L"Error: Compiled file " << FromUtf8(path) << L" could not be written." << std::endl;
+				return false;
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(partial, target, error);
+		if (error) {
+			std::wcerr << L"Error: Compiled file " << FromUtf8(path) << L" could not be replaced." << std::endl;
+			std::filesystem::remove(partial, error);
+			return false;
+		}
+		return true;
+	}
+
+	// Method: rm::Launcher::LoadCompiled
+	// Input: opened compiled batch file
+	// Output: Whether the file was valid and its processes were added
+	bool rm::Launcher::LoadCompiled(BatchFile& file) {
+		CompiledHeader header;
+		if (file.Size() < sizeof(header)) {
+			*_errors << L"Error: Compiled file is truncated." << std::endl;
+			return false;
+		}
+		std::memcpy(&header, file.Data(), sizeof(header));
+		if (std::memcmp(header.tag, FILE_TAG, sizeof(FILE_TAG)) != 0) {
+			*_errors << L"Error: Compiled file was written by another version, compile it again." << std::endl;
+			return false;
+		}
+		if (header.charSize != sizeof(native_char)) {
+			*_errors << L"Error: Compiled file was written on another platform, compile it again here." << std::endl;
+			return false;
+		}
+
+		// Every section must be where the header says, and nothing may have changed since it was written
+		std::uint64_t directivesAt = sizeof(header);
+		std::uint64_t groupsAt = directivesAt + Padded(header.directiveBytes);
+		std::uint64_t jobsAt = groupsAt + header.groupCount * sizeof(CompiledGroup);
+		std::uint64_t argumentsAt = jobsAt + header.jobCount * sizeof(CompiledJob);
+		std::uint64_t stringsAt = argumentsAt + header.argumentCount * sizeof(std::uint64_t);
+		std::uint64_t end = stringsAt + Padded(header.stringChars * sizeof(native_char));
+		if (end != file.Size() || header.stringChars == 0) {
+			*_errors << L"Error: Compiled file is truncated." << std::endl;
+			return false;
+		}
+		if (Checksum(file.Data() + sizeof(header), file.Size() - sizeof(header)) != header.checksum) {
+			*_errors << L"Error: Compiled file is corrupt, its checksum does not match." << std::endl;
+			return false;
+		}
+
+		// Directives are applied as a text file would, or held back for the launcher this one is merged into
+		std::string_view directives(file.Data() + directivesAt, static_cast<size_type>(header.directiveBytes));
+		for (size_type begin = 0, lineNumber = 1; begin < directives.size(); ++lineNumber) {
+			size_type newline = directives.find('\n', begin);
+			std::string_view directive = directives.substr(begin, newline - begin);
+			begin = newline == std::string_view::npos ? directives.size() : newline + 1;
+			_directives.emplace_back(lineNumber, std::string(directive));
+			if (!_deferDirectives) {
+				// Invalid settings were reported when the file was compiled
+				ApplyDirective(directive);
+			}
+		}
+
+		// The whole string pool is copied in one block, processes point into it
+		native_char* strings = _strings.Allocate(static_cast<size_type>(header.stringChars));
+		std::memcpy(strings, file.Data() + stringsAt, static_cast<size_type>(header.stringChars * sizeof(native_char)));
+		std::vector<std::uint64_t> arguments(static_cast<size_type>(header.argumentCount));
+		std::memcpy(arguments.data(), file.Data() + argumentsAt, arguments.size() * sizeof(std::uint64_t));
+		auto fits = [&header](std::uint64_t offset, std::uint64_t length) {
+			return offset < header.stringChars && length < header.stringChars - offset;
+		};
+
+		bool fresh = _processes.empty();
+		Reserve(_processes.size() + static_cast<size_type>(header.jobCount));
+		for (std::uint64_t index = 0; index < header.jobCount; ++index) {
+			CompiledJob job;
+			std::memcpy(&job, file.Data() + jobsAt + index * sizeof(CompiledJob), sizeof(job));
+			if (!fits(job.command, job.commandLength) || job.appLength + 3 > job.commandLength || !fits(job.id, job.idLength)
+				|| !fits(job.dependencies, job.dependenciesLength) || !fits(job.inputs, job.inputsLength)
+				|| !fits(job.placement, job.placementLength) || !fits(job.environment, job.environmentLength)
+				|| !fits(job.directory, job.directoryLength) || !fits(job.sweep, job.sweepLength) || !fits(job.sources, job.sourcesLength) || !fits(job.retry, job.retryLength) || job.arguments + job.argumentCount > arguments.size()) {
+				*_errors << L"Error: Compiled file has an invalid job " << index + 1 << L", it was skipped." << std::endl;
+				fresh = false;
+				continue;
+			}
+
+			_processes.emplace_back(static_cast<size_type>(job.group), strings + job.command, job.commandLength, job.appLength);
+			Process& proc = _processes.back();
+			if (job.idLength > 0) {
+				proc.SetId(native_string_view(strings + job.id, job.idLength));
+			}
+			if (job.dependenciesLength > 0) {
+				proc.SetDependencyList(native_string_view(strings + job.dependencies, job.dependenciesLength));
+			}
+			if (job.inputsLength > 0) {
+				proc.SetInputList(native_string_view(strings + job.inputs, job.inputsLength));
+			}
+			if (job.sourcesLength > 0) {
+				proc.SetSourceList(native_string_view(strings + job.sources, job.sourcesLength));
+			}
+			// Equal texts were written once, so processes share them as they did when parsed
+			if (job.environmentLength > 0) {
+				proc.SetEnvironmentText(strings + job.environment);
+			}
+			if (job.directoryLength > 0) {
+				proc.SetDirectory(strings + job.directory);
+			}
+			proc.SetOutputMode(static_cast<OutputMode>(job.outputMode));
+			proc.SetCacheable(job.cacheable != 0);
+			proc.SetTimeout(Process::duration_type(job.timeout));
+			proc.SetGrace(Process::duration_type(job.grace));
+			if (job.retryLength > 0) {
+				RetryPolicy retry;
+				std::string text = FromNative(native_string_view(strings + job.retry, job.retryLength));
+				for (std::string_view setting : SplitWhitespace(text)) {
+					std::string_view key, value;
+					if (SplitKeyValue(setting, key, value)) {
+						retry.ApplySetting(key, value);
+					}
+				}
+				proc.SetRetry(retry);
+			}
+			if (job.placementLength > 0) {
+				// Rare enough that its settings are simply parsed again
+				Placement placement;
+				std::string text = FromNative(native_string_view(strings + job.placement, job.placementLength));
+				for (std::string_view setting : SplitWhitespace(text)) {
+					std::string_view key, value;
+					if (SplitKeyValue(setting, key, value)) {
+						placement.ApplySetting(key, value);
+					}
+				}
+				proc.SetPlacement(placement);
+			}
+			if (job.sweepLength > 0) {
+				Sweep sweep;
+				std::string text = FromNative(native_string_view(strings + job.sweep, job.sweepLength));
+				for (std::string_view setting : SplitWhitespace(text)) {
+					std::string_view key, value;
+					if (SplitKeyValue(setting, key, value) && key.compare(0, 6, "sweep.") == 0) {
+						sweep.AddAxis(key.substr(6), value);
+					}
+				}
+				proc.SetSweep(sweep);
+			}
+#ifndef _WIN32
+			native_char** argv = _strings.AllocatePointers(job.argumentCount + 1);
+			for (std::uint32_t argument = 0; argument < job.argumentCount; ++argument) {
+				std::uint64_t offset = arguments[static_cast<size_type>(job.arguments + argument)];
+				argv[argument] = strings + (offset < header.stringChars ? offset : header.stringChars);
+			}
+			argv[job.argumentCount] = nullptr;
+			proc.SetArguments(argv);
+#endif
+		}
+
+		// Into an empty launcher the processes are already grouped, the launchgroup index is used as is
+		_indexed = false;
+		if (fresh) {
+			for (std::uint64_t index = 0; index < header.groupCount; ++index) {
+				CompiledGroup group;
+				std::memcpy(&group, file.Data() + groupsAt + index * sizeof(CompiledGroup), sizeof(group));
+				if (group.first + group.count > _processes.size()) {
+					return true;
+				}
+			}
+			for (container_type::value_type& group : _launchGroups) {
+				group.second.Assign(nullptr, 0);
+			}
+			for (std::uint64_t index = 0; index < header.groupCount; ++index) {
+				CompiledGroup group;
+				std::memcpy(&group, file.Data() + groupsAt + index * sizeof(CompiledGroup), sizeof(group));
+				_launchGroups[static_cast<size_type>(group.group)].Assign(&_processes[static_cast<size_type>(group.first)], static_cast<size_type>(group.count));
+			}
+			_indexed = true;
+		}
+		return true;
+	}
+/// End Launcher::Operations
+}
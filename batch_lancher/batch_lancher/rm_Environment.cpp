@@ -0,0 +1,200 @@
+/*
+File: rm_Environment.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Named environment templates and the environment blocks built from them
+*/
+#include "rm_Environment.hpp"
+#include <iostream>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+extern char** environ;
+#endif
+
+namespace rm {
+/// Begin Environment::Constructors
+	Environment::Environment(variable_map const& variables) {
+		size_type size = 1;
+		for (variable_map::value_type const& variable : variables) {
+			size += variable.first.size() + 1 + variable.second.size() + 1;
+		}
+		block.reserve(size);
+		for (variable_map::value_type const& variable : variables) {
+			block += variable.first;
+			block += '=';
+			block += variable.second;
+			block += native_char(0);
+		}
+		// An empty block still needs both of its terminators
+		if (variables.empty()) {
+			block += native_char(0);
+		}
+		block += native_char(0);
+
+#ifndef _WIN32
+		pointers.reserve(variables.size() + 1);
+		for (size_type offset = 0; offset < block.size() && block[offset] != 0; offset += std::char_traits<char>::length(&block[offset]) + 1) {
+			pointers.push_back(&block[offset]);
+		}
+		pointers.push_back(nullptr);
+#endif
+	}
+/// End Environment::Constructors
+
+/// Begin Environment::Operations
+	// Method: Environment::NameLess::operator()
+	// Output: Whether lhs is ordered before rhs
+	bool Environment::NameLess::operator()(native_string const& lhs, native_string const& rhs) const {
+#ifdef _WIN32
+		// CreateProcess expects the block sorted without regard to case
+		return CompareStringOrdinal(lhs.c_str(), -1, rhs.c_str(), -1, TRUE) == CSTR_LESS_THAN;
+#else
+		return lhs < rhs;
+#endif
+	}
+
+	// Method: Environment::Current
+	// Output: Variables of the launcher's own environment
+	Environment::variable_map Environment::Current() {
+		variable_map variables;
+#ifdef _WIN32
+		wchar_t* strings = GetEnvironmentStringsW();
+		if (strings == NULL) {
+			return variables;
+		}
+		for (wchar_t const* variable = strings; *variable != L'\0'; variable += wcslen(variable) + 1) {
+			// Names of the hidden per drive directories start with '='
+			native_string_view entry(variable);
+			size_type equals = entry.find(L'=', 1);
+			if (equals != native_string_view::npos) {
+				variables[native_string(entry.substr(0, equals))] = native_string(entry.substr(equals + 1));
+			}
+		}
+		FreeEnvironmentStringsW(strings);
+#else
+		for (char** variable = environ; *variable != nullptr; ++variable) {
+			native_string_view entry(*variable);
+			size_type equals = entry.find('=');
+			if (equals != native_string_view::npos) {
+				variables[native_string(entry.substr(0, equals))] = native_string(entry.substr(equals + 1));
+			}
+		}
+#endif
+		return variables;
+	}
+
+	// Method: Environment::GetMemoryFootprint
+	// Output: Bytes used by the block
+	Environment::size_type Environment::GetMemoryFootprint() const {
+		size_type bytes = sizeof(*this) + block.capacity() * sizeof(native_char);
+#ifndef _WIN32
+		bytes += pointers.capacity() * sizeof(native_char*);
+#endif
+		return bytes;
+	}
+/// End Environment::Operations
+
+/// Begin EnvironmentTable::Constructors
+	EnvironmentTable::EnvironmentTable()
+		: loaded(false) {
+
+	}
+/// End EnvironmentTable::Constructors
+
+/// Begin EnvironmentTable::Operations
+	// Method: EnvironmentTable::Define
+	// Input: template name, its settings from the batch file
+	// Output: Whether every setting is valid, the template is only defined if they are
+	bool EnvironmentTable::Define(std::string_view name, std::vector<std::string_view> const& settings) {
+		// Names are used in job settings, which are split at whitespace
+		if (name.empty() || name.find('=') != std::string_view::npos) {
+			return false;
+		}
+		std::vector<std::string> valid;
+		for (std::string_view setting : settings) {
+			bool removal = setting.size() > 1 && setting[0] == '-' && setting.find('=') == std::string_view::npos;
+			if (setting != "clear" && !removal && (setting.find('=') == std::string_view::npos || setting[0] == '=')) {
+				return false;
+			}
+			valid.emplace_back(setting);
+		}
+		templates[std::string(name)] = valid;
+		return true;
+	}
+
+	// Method: EnvironmentTable::Resolve
+	// Input: environment of a process as "[template][ NAME=value]...", template used when it names none
+	// Output: Environment to start the process with, null to inherit the launcher's
+	Environment const* EnvironmentTable::Resolve(native_string_view text, std::string const& fallback) {
+		native_string key(text);
+		if (key.empty() || key[0] == ' ') {
+			key.insert(0, ToNative(fallback));
+		}
+		if (key.empty()) {
+			return nullptr;
+		}
+		std::map<native_string, std::unique_ptr<Environment>>::iterator found = built.find(key);
+		if (found != built.end()) {
+			return found->second.get();
+		}
+
+		if (!loaded) {
+			current = Environment::Current();
+			loaded = true;
+		}
+		Environment::variable_map variables = current;
+		size_type space = key.find(' ');
+		native_string name = key.substr(0, space);
+		if (!name.empty()) {
+			std::map<std::string, std::vector<std::string>>::iterator definition = templates.find(ToUtf8(ToWide(name)));
+			if (definition != templates.end()) {
+				for (std::string const& setting : definition->second) {
+					Apply(variables, ToNative(setting));
+				}
+			}
+			else if (missing.insert(name).second) {
+				std::wcerr << L"Error: Environment " << ToWide(name) << L" is not defined, its processes start from the launcher's environment." << std::endl;
+			}
+		}
+		// Overrides of the process follow the template
+		while (space != native_string::npos) {
+			size_type next = key.find(' ', space + 1);
+			Apply(variables, native_string_view(key).substr(space + 1, next == native_string::npos ? native_string::npos : next - space - 1));
+			space = next;
+		}
+
+		std::unique_ptr<Environment>& environment = built[key];
+		environment.reset(new Environment(variables));
+		return environment.get();
+	}
+
+	// Method: EnvironmentTable::GetMemoryFootprint
+	// Output: Bytes used by the environments built
+	EnvironmentTable::size_type EnvironmentTable::GetMemoryFootprint() {
+		size_type bytes = 0;
+		for (std::map<native_string, std::unique_ptr<Environment>>::value_type const& environment : built) {
+			bytes += environment.first.capacity() * sizeof(native_char) + environment.second->GetMemoryFootprint();
+		}
+		return bytes;
+	}
+
+	// Method: EnvironmentTable::Apply
+	// Input: variables to change, one template setting
+	void EnvironmentTable::Apply(Environment::variable_map& variables, native_string_view setting) {
+		if (setting == RM_TEXT("clear")) {
+			variables.clear();
+			return;
+		}
+		if (!setting.empty() && setting[0] == '-') {
+			variables.erase(native_string(setting.substr(1)));
+			return;
+		}
+		size_type equals = setting.find('=');
+		if (equals != native_string_view::npos && equals > 0) {
+			variables[native_string(setting.substr(0, equals))] = native_string(setting.substr(equals + 1));
+		}
+	}
+/// End EnvironmentTable::Operations
+}
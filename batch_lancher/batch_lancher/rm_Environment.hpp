@@ -0,0 +1,125 @@
+/*
+File: rm_Environment.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Named environment templates and the environment blocks built from them
+		Each distinct environment is built once and every process using it shares the block,
+		so memory does not grow with the number of processes
+*/
+#ifndef RM_ENVIRONMENT_HEADER_GUARD
+#define RM_ENVIRONMENT_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <map>
+#include <set>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rm {
+	// A complete environment, ready to pass to the operating system
+	class Environment {
+	public:		/// Types
+		using size_type = size_t;
+
+		// Orders variable names the way the operating system does, Windows ignores case
+		struct NameLess {
+			bool operator()(native_string const& lhs, native_string const& rhs) const;
+		};
+		using variable_map = std::map<native_string, native_string, NameLess>;
+	private:	/// Variables
+		// "NAME=value" entries, each null terminated, then a final null
+		native_string block;
+#ifndef _WIN32
+		// Null terminated pointers into block, in the form of environ
+		std::vector<native_char*> pointers;
+#endif
+	public:		/// Methods
+		/// Constructors
+		// Input: every variable of the environment
+		explicit Environment(variable_map const& variables);
+
+		Environment(Environment const&) = delete;
+		Environment& operator=(Environment const&) = delete;
+
+		/// Operations
+		// Method: Environment::Current
+		// Output: Variables of the launcher's own environment
+		static variable_map Current();
+
+#ifdef _WIN32
+		// Method: Environment::GetBlock
+		// Output: Block for CreateProcess, which needs CREATE_UNICODE_ENVIRONMENT
+		inline void* GetBlock() const {
+			return const_cast<native_char*>(block.data());
+		}
+#else
+		// Method: Environment::GetBlock
+		// Output: Null terminated array of "NAME=value" for posix_spawn
+		inline char** GetBlock() const {
+			return const_cast<char**>(pointers.data());
+		}
+#endif
+
+		// Method: Environment::GetText
+		// Output: Every variable as "NAME=value" entries separated by nulls, in name order
+		inline native_string_view GetText() const {
+			return block;
+		}
+
+		// Method: Environment::GetMemoryFootprint
+		// Output: Bytes used by the block
+		size_type GetMemoryFootprint() const;
+	};
+
+	// Environment templates of a batch file and the environments built from them
+	class EnvironmentTable {
+	public:		/// Types
+		using size_type = size_t;
+	private:	/// Variables
+		// Settings of each template, as written after "@env <name>"
+		std::map<std::string, std::vector<std::string>> templates;
+		// Environments built so far, by template name and per process overrides
+		std::map<native_string, std::unique_ptr<Environment>> built;
+		// Templates that were used without being defined, reported once
+		std::set<native_string> missing;
+		// Launcher's environment, read when the first environment is built
+		bool loaded;
+		Environment::variable_map current;
+	public:		/// Methods
+		/// Constructors
+		EnvironmentTable();
+
+		/// Operations
+		// Method: EnvironmentTable::Define
+		// Input: template name, its settings from the batch file
+		// Output: Whether every setting is valid, the template is only defined if they are
+		//			@env build CC=gcc CFLAGS=-O2 -DEBUG
+		//			Templates start from the launcher's environment, "clear" starts from an empty one
+		//			and "-NAME" removes a variable
+		bool Define(std::string_view name, std::vector<std::string_view> const& settings);
+
+		// Method: EnvironmentTable::Resolve
+		// Input: environment of a process as "[template][ NAME=value]...", template used when it names none
+		// Output: Environment to start the process with, null to inherit the launcher's
+		// Purpose: Builds the environment the first time it is asked for, later requests share it
+		Environment const* Resolve(native_string_view text, std::string const& fallback);
+
+		// Method: EnvironmentTable::GetCount
+		// Output: Number of environments built
+		inline size_type GetCount() {
+			return built.size();
+		}
+
+		// Method: EnvironmentTable::GetMemoryFootprint
+		// Output: Bytes used by the environments built
+		size_type GetMemoryFootprint();
+	private:
+		// Method: EnvironmentTable::Apply
+		// Input: variables to change, one template setting
+		static void Apply(Environment::variable_map& variables, native_string_view setting);
+	};
+}
+
+#endif
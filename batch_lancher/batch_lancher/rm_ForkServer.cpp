@@ -0,0 +1,44 @@
+/*
+File: rm_ForkServer.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Platform independent parts of rm::ForkServer
+		Helpers and their requests live in rm_ForkServer_posix.cpp and rm_ForkServer_win32.cpp
+*/
+#include "rm_ForkServer.hpp"
+
+namespace rm {
+/// Begin ForkServer::Constructors
+	ForkServer::ForkServer()
+		: count(0),
+#ifndef _WIN32
+		next(0),
+#endif
+		spawned(0), fallbacks(0) {
+
+	}
+
+	ForkServer::~ForkServer() {
+		Close();
+	}
+/// End ForkServer::Constructors
+
+/// Begin ForkServer::Operations
+	// Method: ForkServer::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid fork server setting
+	bool ForkServer::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "fork_server") {
+			// Number of helpers, one is enough unless launches outpace it, 0 spawns directly
+			size_type helpers;
+			if (!ParseUnsigned(value, helpers) || helpers > MAX_HELPERS) {
+				return false;
+			}
+			count = helpers;
+			return true;
+		}
+		return false;
+	}
+/// End ForkServer::Operations
+}
@@ -0,0 +1,137 @@
+/*
+File: rm_ForkServer.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Pool of small helper processes that spawn children for the launcher
+		Each helper is the launcher's own executable started once in fork server mode, before any job runs,
+		so its image is loaded, linked and small when it forks, whatever the size of the batch
+		Requests carry the arguments, environment, working directory and standard handles over a local socket,
+		the helper replies with the pid as soon as the child exists and the child's exec runs alongside the launcher
+		Linux only, children are created with CLONE_PARENT so the launcher reaps them as its own
+*/
+#ifndef RM_FORK_SERVER_HEADER_GUARD
+#define RM_FORK_SERVER_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <string_view>
+#include <vector>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+namespace rm {
+	class ForkServer {
+	public:		/// Types
+		using size_type = size_t;
+
+		// Most helpers a batch file may ask for
+		static const size_type MAX_HELPERS = 16;
+
+#ifndef _WIN32
+		// What a child is started with, unset handles are inherited from the helper, which has the launcher's
+		struct Request {
+			char* const* argv;
+			// Null for the launcher's environment
+			char* const* environment;
+			// Null for the launcher's working directory
+			char const* directory;
+			int input;
+			int output;
+			int error;
+			// Whether the child leads its own process group
+			bool ownGroup;
+		};
+#endif
+	private:
+#ifndef _WIN32
+		// One running helper and the launcher's end of its socket
+		struct Helper {
+			pid_t pid;
+			int socket;
+		};
+#endif
+	private:	/// Variables
+		// Helpers asked for by the batch file, 0 to spawn directly
+		size_type count;
+#ifndef _WIN32
+		std::vector<Helper> helpers;
+		// Helper the next request goes to
+		size_type next;
+		// Request being sent, reused between requests
+		std::vector<char> message;
+#endif
+		// Children spawned by helpers, and requests spawned directly because no helper could take them
+		size_type spawned;
+		size_type fallbacks;
+	public:		/// Methods
+		/// Constructors
+		ForkServer();
+
+		~ForkServer();
+
+		ForkServer(ForkServer const&) = delete;
+		ForkServer& operator=(ForkServer const&) = delete;
+
+		/// Operations
+		// Method: ForkServer::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid fork server setting
+		//			fork_server=2
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: ForkServer::SetCount
+		// Input: number of helpers, 0 to spawn directly
+		inline void SetCount(size_type helperCount) {
+			count = helperCount;
+		}
+
+		// Method: ForkServer::Enabled
+		// Output: Whether helpers were asked for
+		inline bool Enabled() {
+			return count > 0;
+		}
+
+		// Method: ForkServer::Open
+		// Output: Whether at least one helper is running
+		// Purpose: Starts the helpers, children are spawned directly if none could be started
+		bool Open();
+
+		// Method: ForkServer::Close
+		// Purpose: Stops the helpers, children they spawned keep running
+		void Close();
+
+#ifndef _WIN32
+		// Method: ForkServer::Spawn
+		// Input: what to start, pid of the child and the error that kept it from starting
+		// Output: Whether a helper took the request, if not the caller spawns the child itself
+		//			A taken request sets either the pid or the error
+		bool Spawn(Request const& request, pid_t& pid, int& error);
+#endif
+
+		// Method: ForkServer::GetSpawnCount
+		// Output: Children spawned by helpers since the fork server was created
+		inline size_type GetSpawnCount() {
+			return spawned;
+		}
+
+		// Method: ForkServer::GetFallbackCount
+		// Output: Children spawned directly while helpers were running
+		inline size_type GetFallbackCount() {
+			return fallbacks;
+		}
+
+		// Method: ForkServer::Serve
+		// Input: helper's end of the socket
+		// Output: Exit code of the helper
+		// Purpose: Body of a helper, started by main for --fork-server, serves requests until the launcher closes the socket
+		static int Serve(int socket);
+	private:
+#ifndef _WIN32
+		// Method: ForkServer::Drop
+		// Input: index of a helper that stopped answering
+		void Drop(size_type index);
+#endif
+	};
+}
+
+#endif
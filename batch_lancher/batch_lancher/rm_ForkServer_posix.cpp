@@ -0,0 +1,517 @@
+/*
+File: rm_ForkServer_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::ForkServer
+		Requests are single SOCK_SEQPACKET messages with the standard handles attached as SCM_RIGHTS
+		A helper forks with clone(CLONE_PARENT), the child's parent is the launcher so its pidfd,
+		waitid and wait4 work as for a child the launcher spawned itself
+		The child answers with its pid before it executes, exec still loads the application but the launcher
+		no longer waits for it, several helpers let several children load at once
+*/
+#ifndef _WIN32
+#include "rm_ForkServer.hpp"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+extern char** environ;
+
+namespace rm {
+	namespace {
+		// Largest request sent to a helper, larger ones are spawned directly
+		const size_t MAX_REQUEST = 256 * 1024;
+		// Descriptor a helper finds its socket on
+		const int HELPER_SOCKET = 3;
+		// Environment count of a request for the launcher's environment
+		const uint32_t INHERIT_ENVIRONMENT = UINT32_MAX;
+		// Request flags
+		const uint32_t FLAG_OWN_GROUP = 1;
+		const uint32_t FLAG_DIRECTORY = 2;
+
+		// Start of every request, followed by the null terminated arguments, environment and working directory
+		struct RequestHeader {
+			uint32_t argc;
+			uint32_t envc;
+			uint32_t flags;
+			// Bit per standard handle attached, stdin first, in the order they are attached
+			uint32_t handles;
+		};
+
+		// Answer to every request, the pid of the child or the error that kept it from starting
+		struct Reply {
+			int32_t pid;
+			int32_t error;
+		};
+
+		// Method: AppendString
+		// Purpose: Appends a string and its terminator to a request
+		void AppendString(std::vector<char>& message, char const* text) {
+			message.insert(message.end(), text, text + std::strlen(text) + 1);
+		}
+
+		// Method: NextString
+		// Output: String starting at position, null if the message ends first
+		// Purpose: Steps through the strings of a request
+		char* NextString(char* message, size_t size, size_t& position) {
+			if (position >= size) {
+				return nullptr;
+			}
+			char* text = message + position;
+			void* end = std::memchr(text, 0, size - position);
+			if (end == nullptr) {
+				return nullptr;
+			}
+			position = static_cast<size_t>(static_cast<char*>(end) - message) + 1;
+			return text;
+		}
+
+		// Method: IsExecutable
+		// Purpose: Whether a path names a file the helper may execute
+		bool IsExecutable(std::string const& path) {
+			struct stat info;
+			return stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode) && access(path.c_str(), X_OK) == 0;
+		}
+
+		// Method: Resolve
+		// Input: application as given, environment and working directory of the child or null, applications already found
+		// Output: Path to execute, null with errno set if there is no such application or working directory
+		// Purpose: Finds the application as posix_spawnp would, before forking, so a missing one fails to start
+		//			rather than exiting 127, searches of PATH are remembered for later requests with the same PATH and directory
+		char const* Resolve(char const* app, char* const* environment, char const* directory, std::unordered_map<std::string, std::string>& found) {
+			// A working directory the child could not change to would only show as exit code 127
+			if (directory != nullptr) {
+				struct stat info;
+				if (stat(directory, &info) != 0 || access(directory, X_OK) != 0) {
+					return nullptr;
+				}
+				if (!S_ISDIR(info.st_mode)) {
+					errno = ENOTDIR;
+					return nullptr;
+				}
+			}
+			if (std::strchr(app, '/') != nullptr) {
+				// The child changes directory first, a relative path is checked from there
+				std::string path = directory != nullptr && app[0] != '/' ? std::string(directory) + '/' + app : std::string(app);
+				if (!IsExecutable(path)) {
+					errno = access(path.c_str(), F_OK) == 0 ? EACCES : ENOENT;
+					return nullptr;
+				}
+				return app;
+			}
+
+			// The child searches its own PATH, the launcher's if it inherits the environment
+			char const* search = nullptr;
+			if (environment == nullptr) {
+				search = std::getenv("PATH");
+			}
+			else {
+				for (char* const* variable = environment; *variable != nullptr && search == nullptr; ++variable) {
+					if (std::strncmp(*variable, "PATH=", 5) == 0) {
+						search = *variable + 5;
+					}
+				}
+			}
+			std::string_view paths = search != nullptr ? search : "/bin:/usr/bin";
+
+			// Relative entries of PATH depend on the directory as well
+			std::string key = std::string(app) + '\0' + std::string(paths) + '\0' + (directory != nullptr ? directory : "");
+			std::unordered_map<std::string, std::string>::iterator known = found.find(key);
+			if (known != found.end()) {
+				return known->second.c_str();
+			}
+			while (true) {
+				size_t end = paths.find(':');
+				std::string_view entry = paths.substr(0, end);
+				std::string path = (entry.empty() ? std::string(".") : std::string(entry)) + '/' + app;
+				if (IsExecutable(directory != nullptr && path[0] != '/' ? std::string(directory) + '/' + path : path)) {
+					return found.emplace(std::move(key), path).first->second.c_str();
+				}
+				if (end == std::string_view::npos) {
+					break;
+				}
+				paths.remove_prefix(end + 1);
+			}
+			errno = ENOENT;
+			return nullptr;
+		}
+
+		// What a child needs once forked, on the helper's stack as the child shares its memory
+		struct ChildStart {
+			char const* path;
+			char* const* argv;
+			char* const* environment;
+			char const* directory;
+			int const* handles;
+			bool ownGroup;
+			int socket;
+		};
+
+		// Method: RunChild
+		// Purpose: Body of a child after the helper has forked, sets itself up as posix_spawnp would,
+		//			answers the launcher with its pid and executes the application
+		int RunChild(void* argument) {
+			ChildStart const& start = *static_cast<ChildStart const*>(argument);
+			// The helper inherited the launcher's signal mask, the child starts with no signals blocked
+			sigset_t mask;
+			sigemptyset(&mask);
+			sigprocmask(SIG_SETMASK, &mask, nullptr);
+			// The group exists before the launcher has the pid, so signalling the group can not miss the child
+			bool ready = !start.ownGroup || setpgid(0, 0) == 0;
+			for (int target = STDIN_FILENO; ready && target <= STDERR_FILENO; ++target) {
+				ready = start.handles[target] == -1 || dup2(start.handles[target], target) != -1;
+			}
+			ready = ready && (start.directory == nullptr || chdir(start.directory) == 0);
+
+			// The launcher carries on while the application loads, setup or exec failing exits 127
+			Reply reply = { static_cast<int32_t>(getpid()), 0 };
+			while (send(start.socket, &reply, sizeof(reply), MSG_NOSIGNAL) == -1 && errno == EINTR) {
+			}
+			if (!ready) {
+				_exit(127);
+			}
+			execve(start.path, start.argv, start.environment != nullptr ? start.environment : environ);
+			// Follow the shell convention for a command that could not be executed
+			_exit(127);
+		}
+
+		// Stack the child runs on until it executes
+		const size_t CHILD_STACK = 64 * 1024;
+
+		// Method: Fork
+		// Input: what the child starts, stack for it
+		// Output: Pid of the child, -1 if it could not be created
+		// Purpose: Creates a child whose parent is the launcher rather than the helper
+		//			As with vfork the child shares the helper's memory, so no page tables are copied,
+		//			and the helper waits until the child has executed or exited
+		pid_t Fork(ChildStart& start, std::vector<char>& stack) {
+#ifdef __linux__
+			// Stacks grow down on every architecture Linux runs the launcher on
+			uintptr_t top = reinterpret_cast<uintptr_t>(stack.data() + stack.size()) & ~static_cast<uintptr_t>(15);
+			return clone(RunChild, reinterpret_cast<void*>(top), CLONE_VM | CLONE_VFORK | CLONE_PARENT | SIGCHLD, &start);
+#else
+			(void)start;
+			(void)stack;
+			errno = ENOSYS;
+			return -1;
+#endif
+		}
+	}
+
+/// Begin ForkServer::Operations
+	// Method: ForkServer::Open
+	// Output: Whether at least one helper is running
+	// Purpose: Starts the helpers, children are spawned directly if none could be started
+	bool ForkServer::Open() {
+		Close();
+		if (count == 0) {
+			return false;
+		}
+#ifdef __linux__
+		// Helpers run the launcher's own executable, which is loaded fresh rather than copied from the launcher
+		char self[] = "/proc/self/exe";
+		char name[] = "batch_launcher";
+		char mode[] = "--fork-server";
+		std::string socketText = std::to_string(HELPER_SOCKET);
+		char* args[] = { name, mode, &socketText[0], nullptr };
+
+		for (size_type index = 0; index < count; ++index) {
+			int ends[2];
+			if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, ends) != 0) {
+				break;
+			}
+			// dup2 onto the same descriptor would leave it closed on exec
+			if (ends[1] == HELPER_SOCKET) {
+				ends[1] = fcntl(HELPER_SOCKET, F_DUPFD_CLOEXEC, HELPER_SOCKET + 1);
+				close(HELPER_SOCKET);
+			}
+			int size = static_cast<int>(MAX_REQUEST);
+			setsockopt(ends[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+			posix_spawn_file_actions_t actions;
+			posix_spawn_file_actions_init(&actions);
+			posix_spawn_file_actions_adddup2(&actions, ends[1], HELPER_SOCKET);
+			pid_t pid;
+			int error = posix_spawn(&pid, self, &actions, nullptr, args, environ);
+			posix_spawn_file_actions_destroy(&actions);
+			close(ends[1]);
+			if (error != 0) {
+				close(ends[0]);
+				break;
+			}
+			helpers.push_back(Helper{ pid, ends[0] });
+		}
+		next = 0;
+
+		if (helpers.size() < count) {
+			std::wcerr << L"Error: Only " << helpers.size() << L" of " << count << L" fork server helpers could be started"
+				<< (helpers.empty() ? L", processes are spawned directly." : L".") << std::endl;
+		}
+		return !helpers.empty();
+#else
+		std::wcerr << L"Error: The fork server is not supported on this system, processes are spawned directly." << std::endl;
+		return false;
+#endif
+	}
+
+	// Method: ForkServer::Close
+	// Purpose: Stops the helpers, children they spawned keep running
+	void ForkServer::Close() {
+		// A helper exits once its socket is closed
+		for (Helper const& helper : helpers) {
+			close(helper.socket);
+		}
+		for (Helper const& helper : helpers) {
+			while (waitpid(helper.pid, nullptr, 0) == -1 && errno == EINTR) {
+			}
+		}
+		helpers.clear();
+	}
+
+	// Method: ForkServer::Spawn
+	// Input: what to start, pid of the child and the error that kept it from starting
+	// Output: Whether a helper took the request, if not the caller spawns the child itself
+	//			A taken request sets either the pid or the error
+	bool ForkServer::Spawn(Request const& request, pid_t& pid, int& error) {
+		if (helpers.empty()) {
+			return false;
+		}
+
+		RequestHeader header = {};
+		message.resize(sizeof(header));
+		for (char* const* arg = request.argv; *arg != nullptr; ++arg) {
+			AppendString(message, *arg);
+			++header.argc;
+		}
+		header.envc = INHERIT_ENVIRONMENT;
+		if (request.environment != nullptr) {
+			header.envc = 0;
+			for (char* const* variable = request.environment; *variable != nullptr; ++variable) {
+				AppendString(message, *variable);
+				++header.envc;
+			}
+		}
+		if (request.directory != nullptr) {
+			header.flags |= FLAG_DIRECTORY;
+			AppendString(message, request.directory);
+		}
+		if (request.ownGroup) {
+			header.flags |= FLAG_OWN_GROUP;
+		}
+		if (message.size() > MAX_REQUEST) {
+			++fallbacks;
+			return false;
+		}
+
+		int handles[3];
+		size_type attached = 0;
+		int const requested[3] = { request.input, request.output, request.error };
+		for (size_type index = 0; index < 3; ++index) {
+			if (requested[index] != -1) {
+				header.handles |= 1u << index;
+				handles[attached++] = requested[index];
+			}
+		}
+		std::memcpy(message.data(), &header, sizeof(header));
+
+		iovec part = { message.data(), message.size() };
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(handles))];
+		msghdr sent = {};
+		sent.msg_iov = &part;
+		sent.msg_iovlen = 1;
+		if (attached > 0) {
+			sent.msg_control = control;
+			sent.msg_controllen = CMSG_SPACE(attached * sizeof(int));
+			cmsghdr* rights = CMSG_FIRSTHDR(&sent);
+			rights->cmsg_level = SOL_SOCKET;
+			rights->cmsg_type = SCM_RIGHTS;
+			rights->cmsg_len = CMSG_LEN(attached * sizeof(int));
+			std::memcpy(CMSG_DATA(rights), handles, attached * sizeof(int));
+		}
+
+		// Helpers take requests in turn, one that has gone is dropped and the next is tried
+		while (!helpers.empty()) {
+			size_type index = next % helpers.size();
+			next = index + 1;
+			ssize_t result;
+			do {
+				result = sendmsg(helpers[index].socket, &sent, MSG_NOSIGNAL);
+			} while (result == -1 && errno == EINTR);
+			if (result == -1 && errno == EMSGSIZE) {
+				++fallbacks;
+				return false;
+			}
+			if (result == -1) {
+				Drop(index);
+				continue;
+			}
+
+			Reply reply;
+			do {
+				result = recv(helpers[index].socket, &reply, sizeof(reply), 0);
+			} while (result == -1 && errno == EINTR);
+			if (result != static_cast<ssize_t>(sizeof(reply))) {
+				// The child may have been forked, starting it again could run it twice
+				Drop(index);
+				pid = -1;
+				error = ECHILD;
+				return true;
+			}
+			pid = reply.pid;
+			error = reply.error;
+			if (error == 0) {
+				++spawned;
+			}
+			return true;
+		}
+		++fallbacks;
+		return false;
+	}
+
+	// Method: ForkServer::Drop
+	// Input: index of a helper that stopped answering
+	void ForkServer::Drop(size_type index) {
+		close(helpers[index].socket);
+		kill(helpers[index].pid, SIGKILL);
+		while (waitpid(helpers[index].pid, nullptr, 0) == -1 && errno == EINTR) {
+		}
+		helpers.erase(helpers.begin() + static_cast<std::ptrdiff_t>(index));
+		std::wcerr << L"Error: A fork server helper stopped, " << helpers.size() << L" remain." << std::endl;
+	}
+
+	// Method: ForkServer::Serve
+	// Input: helper's end of the socket
+	// Output: Exit code of the helper
+	// Purpose: Body of a helper, started by main for --fork-server, serves requests until the launcher closes the socket
+	int ForkServer::Serve(int socket) {
+		// Children must not hold the socket, the launcher would never see the helper go
+		if (fcntl(socket, F_SETFD, FD_CLOEXEC) != 0) {
+			return EXIT_FAILURE;
+		}
+		std::vector<char> buffer(MAX_REQUEST);
+		std::vector<char> stack(CHILD_STACK);
+		std::vector<char*> strings;
+		std::unordered_map<std::string, std::string> found;
+
+		while (true) {
+			iovec part = { buffer.data(), buffer.size() };
+			alignas(cmsghdr) char control[CMSG_SPACE(3 * sizeof(int))];
+			msghdr received = {};
+			received.msg_iov = &part;
+			received.msg_iovlen = 1;
+			received.msg_control = control;
+			received.msg_controllen = sizeof(control);
+			ssize_t size = recvmsg(socket, &received, MSG_CMSG_CLOEXEC);
+			if (size == -1 && errno == EINTR) {
+				continue;
+			}
+			if (size <= 0) {
+				// The launcher has closed its end
+				return size == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+			}
+
+			// Handles arrive closed on exec, the child's dup2 clears that for its own copies
+			std::vector<int> attached;
+			for (cmsghdr* rights = CMSG_FIRSTHDR(&received); rights != nullptr; rights = CMSG_NXTHDR(&received, rights)) {
+				if (rights->cmsg_level == SOL_SOCKET && rights->cmsg_type == SCM_RIGHTS) {
+					size_t handleCount = (rights->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+					size_t first = attached.size();
+					attached.resize(first + handleCount);
+					std::memcpy(attached.data() + first, CMSG_DATA(rights), handleCount * sizeof(int));
+				}
+			}
+
+			Reply reply = { -1, 0 };
+			bool answered = false;
+			RequestHeader header;
+			bool valid = static_cast<size_t>(size) >= sizeof(header) && (received.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0;
+			if (valid) {
+				std::memcpy(&header, buffer.data(), sizeof(header));
+			}
+
+			// Arguments and environment are split in place into one pointer array
+			int handles[3] = { -1, -1, -1 };
+			char const* directory = nullptr;
+			size_t environment = 0;
+			if (valid) {
+				size_t position = sizeof(header);
+				size_t envc = header.envc == INHERIT_ENVIRONMENT ? 0 : header.envc;
+				strings.clear();
+				for (size_t index = 0; valid && index < header.argc + envc; ++index) {
+					char* text = NextString(buffer.data(), static_cast<size_t>(size), position);
+					valid = text != nullptr;
+					strings.push_back(text);
+					if (index + 1 == header.argc) {
+						strings.push_back(nullptr);
+						environment = strings.size();
+					}
+				}
+				strings.push_back(nullptr);
+				if (valid && (header.flags & FLAG_DIRECTORY) != 0) {
+					directory = NextString(buffer.data(), static_cast<size_t>(size), position);
+					valid = directory != nullptr;
+				}
+				valid = valid && header.argc > 0;
+
+				size_t next = 0;
+				for (int target = 0; valid && target < 3; ++target) {
+					if ((header.handles & (1u << target)) != 0) {
+						valid = next < attached.size();
+						handles[target] = valid ? attached[next++] : -1;
+					}
+				}
+			}
+
+			if (!valid) {
+				reply.error = EINVAL;
+			}
+			else {
+				char* const* variables = header.envc == INHERIT_ENVIRONMENT ? nullptr : strings.data() + environment;
+				char const* path = Resolve(strings[0], variables, directory, found);
+				if (path == nullptr) {
+					reply.error = errno;
+				}
+				else {
+					ChildStart start = { path, strings.data(), variables, directory, handles, (header.flags & FLAG_OWN_GROUP) != 0, socket };
+					if (Fork(start, stack) != -1) {
+						// The child has answered
+						answered = true;
+					}
+					reply.error = errno;
+				}
+			}
+
+			for (int handle : attached) {
+				close(handle);
+			}
+			if (answered) {
+				continue;
+			}
+			ssize_t result;
+			do {
+				result = send(socket, &reply, sizeof(reply), MSG_NOSIGNAL);
+			} while (result == -1 && errno == EINTR);
+			if (result == -1) {
+				return EXIT_FAILURE;
+			}
+		}
+	}
+/// End ForkServer::Operations
+}
+#endif
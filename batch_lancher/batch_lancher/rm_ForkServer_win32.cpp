@@ -0,0 +1,37 @@
+/*
+File: rm_ForkServer_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::ForkServer
+		Windows has no fork, CreateProcess always builds the child from its image, so processes are spawned directly
+*/
+#ifdef _WIN32
+#include "rm_ForkServer.hpp"
+#include <iostream>
+#include <cstdlib>
+
+namespace rm {
+/// Begin ForkServer::Operations
+	// Method: ForkServer::Open
+	// Output: Whether at least one helper is running
+	bool ForkServer::Open() {
+		std::wcerr << L"Error: The fork server is not supported on this system, processes are spawned directly." << std::endl;
+		return false;
+	}
+
+	// Method: ForkServer::Close
+	void ForkServer::Close() {
+
+	}
+
+	// Method: ForkServer::Serve
+	// Input: helper's end of the socket
+	// Output: Exit code of the helper
+	int ForkServer::Serve(int socket) {
+		(void)socket;
+		return EXIT_FAILURE;
+	}
+/// End ForkServer::Operations
+}
+#endif
@@ -0,0 +1,154 @@
+/*
+File: rm_History.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Remembers how long each command ran in earlier runs
+		The file is an 8 byte tag, a record count and 24 byte records of
+		key, expected nanoseconds, run count and age, in the byte order of the machine
+*/
+#include "rm_History.hpp"
+#include "rm_lib.hpp"
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <vector>
+#include <algorithm>
+
+namespace rm {
+	namespace {
+		// Identifies the file and its layout
+		char const FILE_TAG[8] = { 'R', 'M', 'H', 'I', 'S', 'T', '0', '1' };
+
+		// One record as stored in the file
+		struct StoredRecord {
+			std::uint64_t key;
+			std::int64_t expected;
+			std::uint32_t runs;
+			std::uint32_t age;
+		};
+		static_assert(sizeof(StoredRecord) == 24, "history records are 24 bytes");
+	}
+
+/// Begin RuntimeHistory::Constructors
+	RuntimeHistory::RuntimeHistory() {
+
+	}
+
+	RuntimeHistory::~RuntimeHistory() {
+
+	}
+/// End RuntimeHistory::Constructors
+
+/// Begin RuntimeHistory::Operations
+	// Method: RuntimeHistory::Load
+	// Purpose: Reads the database, a missing file is an empty history
+	void RuntimeHistory::Load() {
+		entries.clear();
+		std::ifstream file(std::filesystem::path(path), std::ios::binary);
+		if (!file) {
+			return;
+		}
+
+		char tag[sizeof(FILE_TAG)];
+		std::uint64_t count = 0;
+		file.read(tag, sizeof(tag));
+		file.read(reinterpret_cast<char*>(&count), sizeof(count));
+		if (!file || !std::equal(tag, tag + sizeof(tag), FILE_TAG)) {
+			std::wcerr << L"Error: History file " << ToWide(path) << L" is not recognised, it will be replaced." << std::endl;
+			return;
+		}
+
+		std::vector<StoredRecord> records(static_cast<size_type>(count));
+		file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(StoredRecord));
+		if (!file) {
+			std::wcerr << L"Error: History file " << ToWide(path) << L" is truncated, it will be replaced." << std::endl;
+			return;
+		}
+		entries.reserve(records.size());
+		for (StoredRecord const& record : records) {
+			Entry& entry = entries[record.key];
+			entry.expected = duration_type(record.expected);
+			entry.runs = record.runs;
+			entry.age = record.age;
+		}
+	}
+
+	// Method: RuntimeHistory::Save
+	// Purpose: Writes the database, forgetting commands that have not run for MAX_AGE saves
+	void RuntimeHistory::Save() {
+		std::vector<StoredRecord> records;
+		records.reserve(entries.size());
+		for (std::unordered_map<key_type, Entry>::value_type& entry : entries) {
+			if (entry.second.seen) {
+				entry.second.age = 0;
+				entry.second.seen = false;
+			}
+			else if (++entry.second.age > MAX_AGE) {
+				continue;
+			}
+			records.push_back(StoredRecord{ entry.first, entry.second.expected.count(), entry.second.runs, entry.second.age });
+		}
+
+		// Written aside and renamed so a crash never leaves half a database
+		std::filesystem::path target(path);
+		std::filesystem::path partial = target;
+		partial += RM_TEXT(".partial");
+		{
+			std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+			std::uint64_t count = records.size();
+			file.write(FILE_TAG, sizeof(FILE_TAG));
+			file.write(reinterpret_cast<char const*>(&count), sizeof(count));
+			file.write(reinterpret_cast<char const*>(records.data()), records.size() * sizeof(StoredRecord));
+			if (!file) {
+				std::wcerr << L"Error: History file " << ToWide(path) << L" could not be written." << std::endl;
+				return;
+			}
+		}
+		std::error_code error;
+		std::filesystem::rename(partial, target, error);
+		if (error) {
+			std::wcerr << L"Error: History file " << ToWide(path) << L" could not be replaced." << std::endl;
+			std::filesystem::remove(partial, error);
+		}
+	}
+
+	// Method: RuntimeHistory::Predict
+	// Input: process about to be scheduled
+	// Purpose: Sets the expected time of the process if its command has run before
+	void RuntimeHistory::Predict(Process& proc) {
+		std::unordered_map<key_type, Entry>::iterator found = entries.find(Key(proc.GetCommand()));
+		if (found != entries.end()) {
+			proc.SetExpectedTime(found->second.expected);
+		}
+	}
+
+	// Method: RuntimeHistory::Record
+	// Input: finished process
+	// Purpose: Folds the wall time of a successful run into the history of its command
+	void RuntimeHistory::Record(Process& proc) {
+		// Failures and restored results say little about how long the command takes
+		if (!proc.DidRun() || proc.IsCached() || proc.IsResumed() || !proc.Succeded()) {
+			return;
+		}
+		duration_type actual = proc.GetEndTime() - proc.GetStartTime();
+		Entry& entry = entries[Key(proc.GetCommand())];
+		// Recent runs count for half, so a changed command settles within a few runs
+		entry.expected = entry.runs == 0 ? actual : entry.expected + (actual - entry.expected) / 2;
+		++entry.runs;
+		entry.seen = true;
+	}
+
+	// Method: RuntimeHistory::Key
+	// Input: command of a process
+	// Output: 64 bit FNV-1a hash of the command
+	RuntimeHistory::key_type RuntimeHistory::Key(native_string_view command) {
+		key_type hash = 14695981039346656037ULL;
+		for (native_char ch : command) {
+			hash ^= static_cast<key_type>(ch);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+/// End RuntimeHistory::Operations
+}
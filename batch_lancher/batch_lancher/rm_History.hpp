@@ -0,0 +1,90 @@
+/*
+File: rm_History.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Remembers how long each command ran in earlier runs
+		Predictions let the scheduler start the longest jobs of a launchgroup first
+		The database is a small binary file of fixed size records keyed by a hash of the command
+*/
+#ifndef RM_HISTORY_HEADER_GUARD
+#define RM_HISTORY_HEADER_GUARD
+#include "rm_Process.hpp"
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace rm {
+	class RuntimeHistory {
+	public:		/// Types
+		using size_type = size_t;
+		using key_type = std::uint64_t;
+		using duration_type = Process::duration_type;
+
+		// Runs a command may go unseen before it is forgotten
+		static const std::uint32_t MAX_AGE = 64;
+	private:
+		// What is known about one command
+		struct Entry {
+			// Exponentially weighted average of successful wall times
+			duration_type expected = duration_type::zero();
+			std::uint32_t runs = 0;
+			// Saves since the command last ran
+			std::uint32_t age = 0;
+			bool seen = false;
+		};
+	private:	/// Variables
+		// Database file, empty when history is off
+		native_string path;
+		std::unordered_map<key_type, Entry> entries;
+	public:		/// Methods
+		/// Constructors
+		RuntimeHistory();
+
+		~RuntimeHistory();
+
+		/// Operations
+		// Method: RuntimeHistory::SetPath
+		// Input: Database file, read by Load and written by Save
+		inline void SetPath(native_string_view file) {
+			path = native_string(file);
+		}
+
+		// Method: RuntimeHistory::Enabled
+		// Output: Whether a database file has been set
+		inline bool Enabled() {
+			return !path.empty();
+		}
+
+		// Method: RuntimeHistory::Load
+		// Purpose: Reads the database, a missing file is an empty history
+		void Load();
+
+		// Method: RuntimeHistory::Save
+		// Purpose: Writes the database, forgetting commands that have not run for MAX_AGE saves
+		void Save();
+
+		// Method: RuntimeHistory::Predict
+		// Input: process about to be scheduled
+		// Purpose: Sets the expected time of the process if its command has run before
+		void Predict(Process& proc);
+
+		// Method: RuntimeHistory::Record
+		// Input: finished process
+		// Purpose: Folds the wall time of a successful run into the history of its command
+		void Record(Process& proc);
+
+		// Method: RuntimeHistory::Size
+		// Output: Number of commands remembered
+		inline size_type Size() {
+			return entries.size();
+		}
+
+		// Method: RuntimeHistory::Key
+		// Input: command of a process
+		// Output: 64 bit FNV-1a hash of the command
+		static key_type Key(native_string_view command);
+	};
+}
+
+#endif
@@ -0,0 +1,286 @@
+/*
+File: rm_Journal.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Append only journal of job starts and finishes
+		The file is text, a header line then one record per line:
+			S <group> <command hash> <repeat> <attempt>
+			F <group> <command hash> <repeat> <started> <exit code> <wall ns> <user ns> <kernel ns>
+		A line without its newline was cut short by a crash and is ignored
+*/
+#include "rm_Journal.hpp"
+#include "rm_History.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <filesystem>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace rm {
+	namespace {
+		// First line of every journal
+		char const HEADER[] = "RMJOURNAL 1\n";
+
+		// Method: SyncFile
+		// Output: Whether everything written to the file has reached the disk
+		bool SyncFile(std::FILE* file) {
+			if (std::fflush(file) != 0) {
+				return false;
+			}
+#ifdef _WIN32
+			return _commit(_fileno(file)) == 0;
+#elif defined(__linux__)
+			return fdatasync(fileno(file)) == 0;
+#else
+			return fsync(fileno(file)) == 0;
+#endif
+		}
+	}
+
+/// Begin Journal::Constructors
+	Journal::Journal()
+		: resume(false), syncInterval(DEFAULT_SYNC), file(nullptr), stopping(false), records(0), syncs(0), failed(false) {
+
+	}
+
+	Journal::~Journal() {
+		Close();
+	}
+/// End Journal::Constructors
+
+/// Begin Journal::Operations
+	// Method: Journal::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid journal setting
+	bool Journal::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "journal") {
+			if (value.empty()) {
+				return false;
+			}
+			path = ToNative(value);
+			return true;
+		}
+		if (key == "journal_sync") {
+			// Zero syncs every record as soon as the writer sees it
+			return ParseDuration(value, syncInterval) && syncInterval >= duration_type::zero();
+		}
+		return false;
+	}
+
+	// Method: Journal::Open
+	// Input: launchgroups about to run
+	// Output: Whether the journal is ready for records
+	// Purpose: Keys every process, loads the journal when resuming, otherwise starts a new one
+	bool Journal::Open(group_map& groups) {
+		keys.clear();
+		completed.clear();
+		records = 0;
+		syncs = 0;
+		failed = false;
+
+		// Repeats of a command within a launchgroup are told apart by their order
+		char hash[17];
+		for (group_map::value_type& group : groups) {
+			std::unordered_map<RuntimeHistory::key_type, size_type> repeats;
+			for (Process& proc : group.second) {
+				RuntimeHistory::key_type command = RuntimeHistory::Key(proc.GetCommand());
+				std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(command));
+				keys[&proc] = std::to_string(group.first) + ' ' + hash + ' ' + std::to_string(repeats[command]++);
+			}
+		}
+
+		// Resuming appends to the journal so it keeps covering every earlier run
+		pending.clear();
+		if (resume) {
+			if (!Load()) {
+				return false;
+			}
+		}
+		else {
+			pending = HEADER;
+		}
+#ifdef _WIN32
+		file = _wfopen(path.c_str(), resume ? L"ab" : L"wb");
+#else
+		file = std::fopen(path.c_str(), resume ? "ab" : "wb");
+#endif
+		if (file == nullptr) {
+			std::wcerr << L"Error: Journal " << ToWide(path) << L" could not be opened, jobs are not journaled." << std::endl;
+			return false;
+		}
+
+		stopping = false;
+		writer = std::thread(&Journal::Write, this);
+		return true;
+	}
+
+	// Method: Journal::Load
+	// Output: Whether the journal could be read, a missing journal is empty
+	bool Journal::Load() {
+		std::ifstream input(std::filesystem::path(path), std::ios::binary);
+		std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+		if (text.empty()) {
+			pending = HEADER;
+			return true;
+		}
+		if (text.compare(0, sizeof(HEADER) - 1, HEADER) != 0) {
+			std::wcerr << L"Error: " << ToWide(path) << L" is not a journal, it was left alone and jobs are not journaled." << std::endl;
+			return false;
+		}
+
+		// The last line is dropped if it was cut short, and the next record starts on a line of its own
+		size_type end = text.rfind('\n') + 1;
+		if (end != text.size()) {
+			pending = "\n";
+		}
+		std::istringstream lines(text.substr(sizeof(HEADER) - 1, end - (sizeof(HEADER) - 1)));
+		std::string line;
+		while (std::getline(lines, line)) {
+			std::istringstream fields(line);
+			std::string type, group, hash, repeat;
+			int started;
+			long long exitCode, wall, user, kernel;
+			if (!(fields >> type >> group >> hash >> repeat) || type != "F"
+				|| !(fields >> started >> exitCode >> wall >> user >> kernel)) {
+				continue;
+			}
+
+			// A later failure replaces an earlier success, the job has to run again
+			std::string key = group + ' ' + hash + ' ' + repeat;
+			if (started == 1 && exitCode == 0) {
+				Result& result = completed[key];
+				result.exitCode = 0;
+				result.usage = {};
+				result.usage.wallTime = std::chrono::nanoseconds(wall);
+				result.usage.userTime = std::chrono::nanoseconds(user);
+				result.usage.kernelTime = std::chrono::nanoseconds(kernel);
+			}
+			else {
+				completed.erase(key);
+			}
+		}
+		return true;
+	}
+
+	// Method: Journal::Expand
+	// Input: process of a job of a sweep, the sweep, index of the job within the whole sweep
+	// Purpose: Keys the job after its sweep, the same whichever launcher of a shard runs it
+	void Journal::Expand(Process& job, Process& sweep, size_type index) {
+		// "group hash repeat.index", still four fields to Load
+		keys[&job] = keys[&sweep] + '.' + std::to_string(index);
+	}
+
+	// Method: Journal::Forget
+	// Input: process of a finished job of a sweep, which is about to be reused
+	void Journal::Forget(Process& job) {
+		keys.erase(&job);
+	}
+
+	// Method: Journal::Resume
+	// Input: process about to start for the first time
+	// Output: Whether an earlier run finished it successfully, its results are then restored
+	bool Journal::Resume(Process& proc) {
+		if (completed.empty()) {
+			return false;
+		}
+		std::unordered_map<std::string, Result>::iterator found = completed.find(keys[&proc]);
+		if (found == completed.end()) {
+			return false;
+		}
+		proc.Restore(found->second.exitCode, found->second.usage, true);
+		return true;
+	}
+
+	// Method: Journal::Started
+	// Input: process that was just started, including retries and copies of stragglers
+	void Journal::Started(Process& proc) {
+		Append("S " + keys[&proc] + ' ' + std::to_string(proc.GetAttemptCount()) + '\n');
+	}
+
+	// Method: Journal::Finished
+	// Input: process whose job is complete, and the run that completed it
+	void Journal::Finished(Process& proc, Process& result) {
+		bool started = result.DidRun();
+		ResourceUsage usage = started ? result.GetResourceUsage() : ResourceUsage{};
+		long long exitCode = started ? static_cast<long long>(result.GetExitCode()) : 0;
+		Append("F " + keys[&proc] + (started ? " 1 " : " 0 ") + std::to_string(exitCode)
+			+ ' ' + std::to_string(usage.wallTime.count()) + ' ' + std::to_string(usage.userTime.count())
+			+ ' ' + std::to_string(usage.kernelTime.count()) + '\n');
+	}
+
+	// Method: Journal::Close
+	// Purpose: Syncs every record and closes the file
+	void Journal::Close() {
+		if (!writer.joinable()) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_one();
+		writer.join();
+
+		if (std::fclose(file) != 0) {
+			failed = true;
+		}
+		file = nullptr;
+		if (failed) {
+			std::wcerr << L"Error: Journal " << ToWide(path) << L" could not be fully written, a resume may rerun finished jobs." << std::endl;
+		}
+	}
+
+	// Method: Journal::Append
+	// Purpose: Queues a record for the writer thread
+	void Journal::Append(std::string const& record) {
+		bool idle;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			idle = pending.empty();
+			pending += record;
+			++records;
+		}
+		// The writer only needs waking for the first record of a batch
+		if (idle) {
+			wake.notify_one();
+		}
+	}
+
+	// Method: Journal::Write
+	// Purpose: Body of the writer thread, writes and syncs what has queued up once per sync interval
+	void Journal::Write() {
+		std::string batch;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			wake.wait(lock, [this] { return stopping || !pending.empty(); });
+			// Let records gather, closing syncs straight away
+			if (!stopping) {
+				wake.wait_for(lock, syncInterval, [this] { return stopping; });
+			}
+			batch.swap(pending);
+			bool last = stopping;
+			lock.unlock();
+
+			if (!batch.empty()) {
+				if (std::fwrite(batch.data(), 1, batch.size(), file) != batch.size() || !SyncFile(file)) {
+					failed = true;
+				}
+				++syncs;
+				batch.clear();
+			}
+
+			lock.lock();
+			if (last && pending.empty()) {
+				break;
+			}
+		}
+	}
+/// End Journal::Operations
+}
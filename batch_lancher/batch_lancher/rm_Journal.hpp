@@ -0,0 +1,151 @@
+/*
+File: rm_Journal.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Append only journal of job starts and finishes, so an interrupted batch can be resumed
+		Records are buffered and a writer thread syncs them in batches, launches never wait for the disk
+		Jobs are keyed by launchgroup, a hash of their command and which repeat of that command they are
+*/
+#ifndef RM_JOURNAL_HEADER_GUARD
+#define RM_JOURNAL_HEADER_GUARD
+#include "rm_LaunchGroup.hpp"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+
+namespace rm {
+	class Journal {
+	public:		/// Types
+		using size_type = size_t;
+		using pointer_type = Process*;
+		using group_map = std::map<size_type, LaunchGroup>;
+		using duration_type = std::chrono::nanoseconds;
+
+		// Longest time a record waits to be synced unless set otherwise
+		static constexpr std::chrono::milliseconds DEFAULT_SYNC = std::chrono::milliseconds(100);
+	private:
+		// A successful run read back from the journal
+		struct Result {
+			Process::exit_code exitCode;
+			ResourceUsage usage;
+		};
+	private:	/// Variables
+		// Journal file, empty when journaling is off
+		native_string path;
+		// Skip jobs the journal shows as successful instead of starting afresh
+		bool resume;
+		duration_type syncInterval;
+		// Key of every process, assigned by Open
+		std::unordered_map<pointer_type, std::string> keys;
+		// Successful jobs of earlier runs, loaded when resuming
+		std::unordered_map<std::string, Result> completed;
+		std::FILE* file;
+
+		// Records not yet written, guarded by mutex
+		std::string pending;
+		std::thread writer;
+		std::mutex mutex;
+		std::condition_variable wake;
+		bool stopping;
+		// Written by the writer thread, read once it has stopped
+		size_type records;
+		size_type syncs;
+		bool failed;
+	public:		/// Methods
+		/// Constructors
+		Journal();
+
+		~Journal();
+
+		Journal(Journal const&) = delete;
+		Journal& operator=(Journal const&) = delete;
+
+		/// Operations
+		// Method: Journal::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid journal setting
+		//			journal=batch.journal journal_sync=100ms
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: Journal::SetResume
+		// Input: Whether Open reads the existing journal and keeps appending to it
+		inline void SetResume(bool value) {
+			resume = value;
+		}
+
+		// Method: Journal::IsResuming
+		inline bool IsResuming() {
+			return resume;
+		}
+
+		// Method: Journal::Enabled
+		// Output: Whether a journal file has been set
+		inline bool Enabled() {
+			return !path.empty();
+		}
+
+		// Method: Journal::Open
+		// Input: launchgroups about to run
+		// Output: Whether the journal is ready for records
+		// Purpose: Keys every process, loads the journal when resuming, otherwise starts a new one
+		bool Open(group_map& groups);
+
+		// Method: Journal::Expand
+		// Input: process of a job of a sweep, the sweep, index of the job within the whole sweep
+		// Purpose: Keys the job after its sweep, the same whichever launcher of a shard runs it
+		void Expand(Process& job, Process& sweep, size_type index);
+
+		// Method: Journal::Forget
+		// Input: process of a finished job of a sweep, which is about to be reused
+		void Forget(Process& job);
+
+		// Method: Journal::Resume
+		// Input: process about to start for the first time
+		// Output: Whether an earlier run finished it successfully, its results are then restored
+		bool Resume(Process& proc);
+
+		// Method: Journal::Started
+		// Input: process that was just started, including retries and copies of stragglers
+		void Started(Process& proc);
+
+		// Method: Journal::Finished
+		// Input: process whose job is complete, and the run that completed it
+		void Finished(Process& proc, Process& result);
+
+		// Method: Journal::Close
+		// Purpose: Syncs every record and closes the file
+		void Close();
+
+		// Method: Journal::GetRecords
+		// Output: Records written by the last run
+		inline size_type GetRecords() {
+			return records;
+		}
+
+		// Method: Journal::GetSyncs
+		// Output: Number of times the records of the last run were synced to disk
+		inline size_type GetSyncs() {
+			return syncs;
+		}
+	private:
+		// Method: Journal::Load
+		// Output: Whether the journal could be read, a missing journal is empty
+		bool Load();
+
+		// Method: Journal::Append
+		// Purpose: Queues a record for the writer thread
+		void Append(std::string const& record);
+
+		// Method: Journal::Write
+		// Purpose: Body of the writer thread, writes and syncs what has queued up once per sync interval
+		void Write();
+	};
+}
+
+#endif
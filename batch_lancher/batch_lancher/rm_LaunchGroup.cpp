@@ -1,14 +1,19 @@
 /*
-File: rm_LaunchGroup.hpp
+File: rm_LaunchGroup.cpp
 Author: Ryan McNamee
 Date Created: Monday, 25, September, 2017
-Date Updated: Monday, 9, October, 2017
-Purpose: Holds and manipulates an unordered list of processes
+Date Updated: Saturday, 17, October, 2026
+Purpose: Holds and manipulates a contiguous run of processes owned by the Launcher
 */
 #include "rm_LaunchGroup.hpp"
+#include "rm_lib.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <chrono>
 
 namespace rm {
 /// Begin LaunchGroup::Constructors
@@ -17,22 +22,17 @@ namespace rm {
 	}
 
 	LaunchGroup::~LaunchGroup() {
-		// Clear unordered list
-		for (pointer_type proc : procs) {
-			if (proc != nullptr) {
-				delete proc;
-			}
-		}
+
 	}
 /// End LaunchGroup::Constructors
 
 /// Begin LaunchGroup::Operations
-	// Method: LaunchGroup::Add
-	// Input: Pointer to rm::Process
-	// Output: Void
-	// Purpose: Add process to unordered list
-	void LaunchGroup::Add(pointer_type proc) {
-		procs.push_back(proc);
+	// Method: LaunchGroup::Assign
+	// Input: First process of the group and number of processes
+	// Purpose: Points the group at its processes, which the Launcher owns
+	void LaunchGroup::Assign(pointer_type procs, size_type size) {
+		first = procs;
+		count = size;
 	}
 
 	// Method: LaunchGroup::Done
@@ -41,9 +41,9 @@ namespace rm {
 	// DEPRECIATED: More reliable method created
 	bool LaunchGroup::Done() {
 		bool done = true;
-		for (pointer_type proc : procs) {
+		for (reference_type proc : *this) {
 			// Check if any processes have not completed
-			if (proc->Done() == false) {
+			if (proc.Done() == false) {
 				done = false;
 			}
 		}
@@ -54,47 +54,157 @@ namespace rm {
 	// Method: LaunchGroup::RunAll
 	// Purpose: Start all processes synchronously
 	void LaunchGroup::RunAll() {
-		for (pointer_type proc : procs) {
-			proc->Start();
+		for (reference_type proc : *this) {
+			proc.Start();
 		}
 	}
 
-	// Method: LaunchGroup::RunAllAsync
-	// Purpose: Start all processes asynchronously
-	void LaunchGroup::RunAllAsync() {
-		for (pointer_type proc : procs) {
-			proc->StartAsync();
-			if (proc->DidRun()) {
-				procHandles.push_back(proc->GetHandle());
-			}
-		}
-		WaitForMultipleObjects(procHandles.size(), procHandles.data(), TRUE, INFINITE);
+	// Method: LaunchGroup::SetConcurrency
+	// Input: Maximum number of processes to run at once, 0 to use the launcher default
+	void LaunchGroup::SetConcurrency(size_type limit) {
+		concurrency = limit;
 	}
 
 	// Method: LaunchGroup::Print
 	// Input: output stream to print to
 	// Purpose: Print data from each started process
 	void LaunchGroup::Print(std::wostream& outstream) {
-		for (pointer_type proc : procs) {
-			if (proc->DidRun()) {
-				outstream << *proc;
+		for (reference_type proc : *this) {
+			proc.ForEachJob([&outstream](Process& job) {
+				if (job.DidRun()) {
+					outstream << job;
+				}
+			});
+		}
+	}
+
+	// Method: LaunchGroup::PredictMakespan
+	// Input: Processes the launcher runs at once, the group's own limit applies if lower
+	// Output: Time to run the group longest predicted first, zero without predictions
+	//			Processes without a prediction are expected to take the group's average
+	Process::duration_type LaunchGroup::PredictMakespan(size_type slots) {
+		using duration_type = Process::duration_type;
+
+		std::vector<duration_type> expected;
+		duration_type known = duration_type::zero();
+		size_type predicted = 0;
+		for (reference_type proc : *this) {
+			// Every job of a sweep is expected to take as long as the sweep's prediction
+			size_type jobs = proc.GetSweep() == nullptr ? 1 : proc.GetSweep()->GetCount();
+			expected.insert(expected.end(), jobs, proc.GetExpectedTime());
+			if (proc.GetExpectedTime() > duration_type::zero()) {
+				known += proc.GetExpectedTime() * static_cast<duration_type::rep>(jobs);
+				predicted += jobs;
+			}
+		}
+		if (predicted == 0) {
+			return duration_type::zero();
+		}
+		duration_type fallback = known / static_cast<duration_type::rep>(predicted);
+		for (duration_type& time : expected) {
+			if (time == duration_type::zero()) {
+				time = fallback;
 			}
 		}
+
+		// Each process goes to the slot that frees up first
+		if (concurrency > 0 && concurrency < slots) {
+			slots = concurrency;
+		}
+		std::sort(expected.begin(), expected.end(), std::greater<duration_type>());
+		std::priority_queue<duration_type, std::vector<duration_type>, std::greater<duration_type>> free;
+		for (size_type slot = 0; slot < std::max<size_type>(slots, 1); ++slot) {
+			free.push(duration_type::zero());
+		}
+		duration_type makespan = duration_type::zero();
+		for (duration_type time : expected) {
+			duration_type finish = free.top() + time;
+			free.pop();
+			free.push(finish);
+			makespan = std::max(makespan, finish);
+		}
+		return makespan;
+	}
+
+	// Method: LaunchGroup::GetMakespan
+	// Output: Time from the first process of the group starting to the last finishing
+	Process::duration_type LaunchGroup::GetMakespan() {
+		Process::clock_type::time_point begin = Process::clock_type::time_point::max();
+		Process::clock_type::time_point end = Process::clock_type::time_point::min();
+		for (reference_type proc : *this) {
+			proc.ForEachJob([&begin, &end](Process& job) {
+				if (job.DidRun() && !job.IsCached()) {
+					begin = std::min(begin, job.GetStartTime());
+					end = std::max(end, job.GetEndTime());
+				}
+			});
+		}
+		return end > begin ? end - begin : Process::duration_type::zero();
+	}
+
+	// Method: LaunchGroup::PrintSummary
+	// Input: output stream to print to, processes the launcher runs at once
+	// Purpose: Print process count and concurrency of the group, and predicted against actual time
+	void LaunchGroup::PrintSummary(std::wostream& outstream, size_type slots) {
+		using seconds = std::chrono::duration<double>;
+
+		size_type jobs = 0;
+		for (reference_type proc : *this) {
+			jobs += proc.GetSweep() == nullptr ? 1 : proc.GetSweep()->GetCount();
+		}
+		outstream << jobs << L" processes, peak running " << peakRunning;
+		if (concurrency > 0) {
+			outstream << L", concurrency limit " << concurrency;
+		}
+		// Starts held back by system pressure, and why
+		size_type held = 0;
+		for (size_type reason = 0; reason < THROTTLE_REASONS; ++reason) {
+			held += throttles[reason];
+		}
+		if (held > 0) {
+			outstream << std::fixed << std::setprecision(3)
+				<< L", throttled " << held << L" times for (s) " << seconds(throttledTime).count() << L" (";
+			outstream.unsetf(std::ios_base::floatfield);
+			outstream.precision(6);
+			bool first = true;
+			for (size_type reason = 0; reason < THROTTLE_REASONS; ++reason) {
+				if (throttles[reason] > 0) {
+					outstream << (first ? L"" : L", ") << ThrottleName(static_cast<Throttle>(reason + 1)) << L" " << throttles[reason];
+					first = false;
+				}
+			}
+			outstream << L")";
+		}
+		Process::duration_type predicted = PredictMakespan(slots);
+		if (predicted > Process::duration_type::zero()) {
+			outstream << std::fixed << std::setprecision(3)
+				<< L", predicted (s) " << seconds(predicted).count()
+				<< L", actual (s) " << seconds(GetMakespan()).count();
+			outstream.unsetf(std::ios_base::floatfield);
+			outstream.precision(6);
+		}
+		outstream << std::endl;
 	}
 
 	// Method: LaunchGroup::PrintErrors
-	// Input: output stream to print to
+	// Input: output stream to print to, output captured from the processes if any
 	// Purpose: Print any processes which failed to start or exited with an error
-	void LaunchGroup::PrintErrors(std::wostream& outstream) {
-		for (pointer_type proc : procs) {
-			if (!proc->DidRun()) {
-				outstream << L"ERROR - Application not run: " 
-					<< proc->GetLaunchGroup() << L": " << proc->GetApp() << L", Parameters: " << proc->GetParams() << std::endl;
-			}
-			else if (!proc->Succeded()) {
-				outstream << L"ERROR - Application exited with error: " 
-					<< proc->GetExitCode() << L" App: " << proc->GetLaunchGroup() << L": " << proc->GetApp() << L", Parameters: " << proc->GetParams() << std::endl;
-			}
+	void LaunchGroup::PrintErrors(std::wostream& outstream, OutputCapture* capture) {
+		for (reference_type proc : *this) {
+			// Each job of a sweep is reported with its own parameters
+			proc.ForEachJob([&outstream, capture](Process& job) {
+				if (!job.DidRun()) {
+					outstream << L"ERROR - Application not run: " 
+						<< job.GetLaunchGroup() << L": " << ToWide(job.GetApp()) << L", Parameters: " << ToWide(job.GetParams()) << std::endl;
+				}
+				else if (!job.Succeded()) {
+					outstream << L"ERROR - Application exited with error: " 
+						<< job.GetExitCode() << L" App: " << job.GetLaunchGroup() << L": " << ToWide(job.GetApp()) << L", Parameters: " << ToWide(job.GetParams()) << std::endl;
+					if (capture != nullptr) {
+						capture->PrintTail(outstream, &job);
+					}
+				}
+			});
 		}
 	}
 
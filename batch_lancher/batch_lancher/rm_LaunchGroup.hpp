@@ -2,13 +2,16 @@
 File: rm_LaunchGroup.hpp
 Author: Ryan McNamee
 Date Created: Monday, 25, September, 2017
-Date Updated: Monday, 9, October, 2017
-Purpose: Holds and manipulates an unordered list of processes
+Date Updated: Saturday, 17, October, 2026
+Purpose: Holds and manipulates a contiguous run of processes owned by the Launcher
 */
 #ifndef RM_LAUNCHGROUP_HEADER_GUARD
 #define RM_LAUNCHGROUP_HEADER_GUARD
 #include "rm_Process.hpp"
-#include <list>
+#include "rm_OutputCapture.hpp"
+#include "rm_TimeLimits.hpp"
+#include "rm_RetryPolicy.hpp"
+#include "rm_Admission.hpp"
 #include <vector>
 #include <sstream>
 #include <string>
@@ -22,9 +25,28 @@ namespace rm {
 		using const_reference_type = const reference_type;
 
 		using size_type = size_t;
-	public:		/// Variables
-		std::list<pointer_type> procs;
-		std::vector<Process::process_handle> procHandles;
+	private:	/// Variables
+		// Processes of the group, stored contiguously by the Launcher
+		pointer_type first = nullptr;
+		size_type count = 0;
+		// Maximum number of processes running at once, 0 if not set
+		size_type concurrency = 0;
+		// Most processes of the group that were running at once during Launcher::RunAll
+		size_type peakRunning = 0;
+		// Placement of processes that do not set their own
+		Placement placement;
+		// Timeout and straggler handling of the processes
+		TimeLimits limits;
+		// When failed processes are run again
+		RetryPolicy retry;
+		// System pressure that holds back starts of the processes
+		AdmissionPolicy admission;
+		// Times starts were held back for each reason, and for how long in all
+		size_type throttles[THROTTLE_REASONS] = {};
+		Process::duration_type throttledTime = Process::duration_type::zero();
+		// Environment template and working directory of processes that do not set their own, empty if not set
+		std::string environment;
+		native_string directory;
 	public:		/// Methods
 		/// Constructors
 		LaunchGroup();
@@ -32,11 +54,34 @@ namespace rm {
 		~LaunchGroup();
 
 		/// Operations
-		// Method: LaunchGroup::Add
-		// Input: Pointer to rm::Process
-		// Output: Void
-		// Purpose: Add process to unordered list
-		void Add(pointer_type proc);
+		// Method: LaunchGroup::Assign
+		// Input: First process of the group and number of processes
+		// Purpose: Points the group at its processes, which the Launcher owns
+		void Assign(pointer_type procs, size_type size);
+
+		// Method: LaunchGroup::begin
+		// Output: First process of the group
+		inline pointer_type begin() {
+			return first;
+		}
+
+		// Method: LaunchGroup::end
+		// Output: One past the last process of the group
+		inline pointer_type end() {
+			return first + count;
+		}
+
+		// Method: LaunchGroup::Size
+		// Output: Number of processes in the group
+		inline size_type Size() {
+			return count;
+		}
+
+		// Method: LaunchGroup::Empty
+		// Output: Whether the group has no processes
+		inline bool Empty() {
+			return count == 0;
+		}
 
 		// Method: LaunchGroup::Done
 		// Output: If all processes in launchgroup have completed
@@ -48,9 +93,116 @@ namespace rm {
 		// Purpose: Start all processes synchronously
 		void RunAll();
 
-		// Method: LaunchGroup::RunAllAsync
-		// Purpose: Start all processes asynchronously
-		void RunAllAsync();
+		// Method: LaunchGroup::SetConcurrency
+		// Input: Maximum number of processes to run at once, 0 to use the launcher default
+		void SetConcurrency(size_type limit);
+
+		// Method: LaunchGroup::GetConcurrency
+		// Output: Maximum number of processes to run at once, 0 if not set
+		inline size_type GetConcurrency() {
+			return concurrency;
+		}
+
+		// Method: LaunchGroup::GetPlacement
+		// Output: Placement of processes that do not set their own, empty if not set
+		inline Placement& GetPlacement() {
+			return placement;
+		}
+
+		// Method: LaunchGroup::GetLimits
+		// Output: Timeout and straggler handling of the processes
+		inline TimeLimits& GetLimits() {
+			return limits;
+		}
+
+		// Method: LaunchGroup::GetRetry
+		// Output: When failed processes are run again
+		inline RetryPolicy& GetRetry() {
+			return retry;
+		}
+
+		// Method: LaunchGroup::GetAdmission
+		// Output: System pressure that holds back starts of the processes
+		inline AdmissionPolicy& GetAdmission() {
+			return admission;
+		}
+
+		// Method: LaunchGroup::NoteThrottled
+		// Input: Why starts were held back, and for how long once they resume
+		// Purpose: Counts a decision to hold back starts, then the time they were held back
+		inline void NoteThrottled(Throttle reason) {
+			++throttles[static_cast<size_type>(reason) - 1];
+		}
+		inline void NoteThrottled(Process::duration_type time) {
+			throttledTime += time;
+		}
+
+		// Method: LaunchGroup::GetThrottles
+		// Input: Reason starts were held back
+		// Output: Number of times they were held back for it
+		inline size_type GetThrottles(Throttle reason) {
+			return throttles[static_cast<size_type>(reason) - 1];
+		}
+
+		// Method: LaunchGroup::GetThrottledTime
+		// Output: Time starts were held back in all
+		inline Process::duration_type GetThrottledTime() {
+			return throttledTime;
+		}
+
+		// Method: LaunchGroup::GetEnvironment
+		// Output: Environment template of processes that do not name their own, empty if not set
+		inline std::string const& GetEnvironment() {
+			return environment;
+		}
+
+		// Method: LaunchGroup::SetEnvironment
+		// Input: Environment template name
+		inline void SetEnvironment(std::string_view name) {
+			environment = name;
+		}
+
+		// Method: LaunchGroup::GetDirectory
+		// Output: Working directory of processes that do not set their own, empty if not set
+		inline native_string const& GetDirectory() {
+			return directory;
+		}
+
+		// Method: LaunchGroup::SetDirectory
+		// Input: Working directory
+		inline void SetDirectory(native_string_view path) {
+			directory = path;
+		}
+
+		// Method: LaunchGroup::GetPeakRunning
+		// Output: Most processes that were running at once
+		inline size_type GetPeakRunning() {
+			return peakRunning;
+		}
+
+		// Method: LaunchGroup::NoteRunning
+		// Input: Number of the group's processes currently running
+		// Purpose: Records the most processes that were running at once
+		inline void NoteRunning(size_type running) {
+			if (running > peakRunning) {
+				peakRunning = running;
+			}
+		}
+
+		// Method: LaunchGroup::PredictMakespan
+		// Input: Processes the launcher runs at once, the group's own limit applies if lower
+		// Output: Time to run the group longest predicted first, zero without predictions
+		//			Processes without a prediction are expected to take the group's average
+		Process::duration_type PredictMakespan(size_type slots);
+
+		// Method: LaunchGroup::GetMakespan
+		// Output: Time from the first process of the group starting to the last finishing
+		Process::duration_type GetMakespan();
+
+		// Method: LaunchGroup::PrintSummary
+		// Input: output stream to print to, processes the launcher runs at once
+		// Purpose: Print process count and concurrency of the group, and predicted against actual time
+		void PrintSummary(std::wostream& outstream, size_type slots);
 
 		// Method: LaunchGroup::Print
 		// Input: output stream to print to
@@ -58,9 +210,9 @@ namespace rm {
 		void Print(std::wostream& outstream);
 
 		// Method: LaunchGroup::PrintErrors
-		// Input: output stream to print to
+		// Input: output stream to print to, output captured from the processes if any
 		// Purpose: Print any processes which failed to start or exited with an error
-		void PrintErrors(std::wostream& outstream);
+		void PrintErrors(std::wostream& outstream, OutputCapture* capture = nullptr);
 	};
 
 	/// Operators
@@ -2,7 +2,7 @@
 File: rm_Launcher.cpp
 Author: Ryan McNamee
 Date Created: Friday, 29, September, 2017
-Date Updated: Monday, 9, October, 2017
+Date Updated: Saturday, 17, October, 2026
 Purpose: Parse input file, generate sorted launchgroups and processes
 		Output basic information about run
 */
@@ -11,11 +11,45 @@ Purpose: Parse input file, generate sorted launchgroups and processes
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <memory>
+#include <sstream>
+#include <atomic>
+#include <filesystem>
+#include <cstdint>
 
 namespace rm {
+	namespace {
+		// Method: ParseOutputMode
+		// Input: none, tail or log, output mode
+		// Output: Whether the name was valid
+		bool ParseOutputMode(std::string_view name, OutputMode& mode) {
+			if (name == "none") {
+				mode = OutputMode::Console;
+			}
+			else if (name == "tail") {
+				mode = OutputMode::Tail;
+			}
+			else if (name == "log") {
+				mode = OutputMode::Log;
+			}
+			else {
+				return false;
+			}
+			return true;
+		}
+	}
+
 /// Begin Launcher::Constructors
-	Launcher::Launcher() {
-	
+	Launcher::Launcher()
+		: _indexed(true), _concurrency(std::thread::hardware_concurrency()), _output(OutputMode::Console),
+		_trace(nullptr), _errors(&std::wcerr), _deferDirectives(false) {
+		// hardware_concurrency may not be computable
+		if (_concurrency == 0) {
+			_concurrency = 1;
+		}
 	}
 
 	Launcher::~Launcher() {
@@ -25,16 +59,797 @@ namespace rm {
 
 /// Begin Launcher::Operations
 	// Method: rm::Launcher::Add
-	// Purpose: Handles the sorting of processes into launchgroups
-	void rm::Launcher::Add(value_type::pointer_type const& proc) {
-		_launchGroups[proc->GetLaunchGroup()].Add(proc);
+	// Input: launchgroup, application and parameters of a new process
+	// Output: The new process, valid until the next call to Add
+	// Purpose: Stores the process and its text, sorting into launchgroups is left to BuildIndex
+	Process& rm::Launcher::Add(size_type group, native_string_view app, native_string_view params) {
+		_indexed = false;
+		_processes.emplace_back(group, _strings, app, params);
+		return _processes.back();
+	}
+
+	// Method: rm::Launcher::BuildIndex
+	// Purpose: Sorts processes by launchgroup and points each launchgroup at its processes
+	//			Called once parsing has finished
+	void rm::Launcher::BuildIndex() {
+		if (_indexed) {
+			return;
+		}
+
+		bool sorted = std::is_sorted(_processes.begin(), _processes.end(), [](Process const& lhs, Process const& rhs) {
+			return lhs.GetLaunchGroup() < rhs.GetLaunchGroup();
+		});
+		if (sorted) {
+			_processes.shrink_to_fit();
+		}
+		else {
+			// Processes are large, so sort their positions and move each process once
+			// File order is kept within each launchgroup
+			std::vector<std::pair<size_type, size_type>> order;
+			order.reserve(_processes.size());
+			for (size_type index = 0; index < _processes.size(); ++index) {
+				order.emplace_back(_processes[index].GetLaunchGroup(), index);
+			}
+			std::sort(order.begin(), order.end());
+
+			std::vector<Process> grouped;
+			grouped.reserve(_processes.size());
+			for (std::pair<size_type, size_type> const& position : order) {
+				grouped.push_back(std::move(_processes[position.second]));
+			}
+			_processes.swap(grouped);
+		}
+
+		for (container_type::value_type& group : _launchGroups) {
+			group.second.Assign(nullptr, 0);
+		}
+		size_type begin = 0;
+		while (begin < _processes.size()) {
+			size_type end = begin;
+			while (end < _processes.size() && _processes[end].GetLaunchGroup() == _processes[begin].GetLaunchGroup()) {
+				++end;
+			}
+			_launchGroups[_processes[begin].GetLaunchGroup()].Assign(&_processes[begin], end - begin);
+			begin = end;
+		}
+		_indexed = true;
+	}
+
+	// Method: rm::Launcher::GetJobCount
+	// Output: Number of jobs, counting each job of a sweep
+	rm::Launcher::size_type rm::Launcher::GetJobCount() {
+		size_type jobs = 0;
+		for (Process& proc : _processes) {
+			jobs += proc.GetSweep() == nullptr ? 1 : proc.GetSweep()->GetCount();
+		}
+		return jobs;
+	}
+
+	// Method: rm::Launcher::GetMemoryFootprint
+	// Output: Bytes used to store processes, their text and launchgroups
+	rm::Launcher::size_type rm::Launcher::GetMemoryFootprint() {
+		size_type sweeps = 0;
+		for (Process& proc : _processes) {
+			if (proc.GetSweep() != nullptr) {
+				sweeps += proc.GetSweep()->GetMemoryFootprint();
+			}
+		}
+		return _processes.capacity() * sizeof(Process)
+			+ _strings.Capacity()
+			+ sweeps
+			+ _environments.GetMemoryFootprint()
+			+ _launchGroups.size() * (sizeof(container_type::value_type) + 4 * sizeof(void*));
+	}
+
+	// Method: rm::Launcher::ParseFiles
+	// Input: batch files and directories of batch files, in the order their jobs are merged
+	// Output: Whether every file could be read
+	// Purpose: Parses the files at once on worker threads and merges their jobs
+	bool rm::Launcher::ParseFiles(std::vector<std::string> const& paths) {
+		// Directories contribute their files in name order
+		std::vector<std::string> files;
+		for (std::string const& path : paths) {
+			std::error_code error;
+			if (!std::filesystem::is_directory(path, error)) {
+				files.push_back(path);
+				continue;
+			}
+			std::vector<std::string> entries;
+			for (std::filesystem::directory_iterator entry(path, error), end; !error && entry != end; entry.increment(error)) {
+				if (entry->is_regular_file(error)) {
+					entries.push_back(entry->path().string());
+				}
+			}
+			if (entries.empty()) {
+				std::wcerr << L"Error: Directory " << FromUtf8(path) << L" has no batch files." << std::endl;
+				return false;
+			}
+			std::sort(entries.begin(), entries.end());
+			files.insert(files.end(), entries.begin(), entries.end());
+		}
+
+		// A single file is parsed in place
+		if (files.size() == 1) {
+			BatchFile file;
+			if (!file.Open(files[0])) {
+				std::wcerr << L"Error: File " << FromUtf8(files[0]) << L" could not be opened" << std::endl;
+				return false;
+			}
+			if (IsCompiled(file)) {
+				bool loaded = LoadCompiled(file);
+				BuildIndex();
+				return loaded;
+			}
+			file >> *this;
+			return true;
+		}
+
+		// Each file is parsed into a launcher of its own, which buffers its errors and holds back its directives
+		std::vector<std::unique_ptr<Launcher>> parts(files.size());
+		std::vector<std::wostringstream> errors(files.size());
+		std::vector<char> opened(files.size(), 0);
+		std::atomic<size_type> next(0);
+		auto work = [&]() {
+			for (size_type index = next++; index < files.size(); index = next++) {
+				parts[index].reset(new Launcher);
+				parts[index]->_errors = &errors[index];
+				parts[index]->_deferDirectives = true;
+				BatchFile file;
+				if (file.Open(files[index])) {
+					opened[index] = 1;
+					if (IsCompiled(file)) {
+						parts[index]->LoadCompiled(file);
+					}
+					else {
+						file >> *parts[index];
+					}
+				}
+			}
+		};
+		size_type workers = std::min<size_type>(files.size(), std::max(1u, std::thread::hardware_concurrency()));
+		std::vector<std::thread> threads;
+		for (size_type worker = 1; worker < workers; ++worker) {
+			threads.emplace_back(work);
+		}
+		work();
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		// Merged in file order, so processes of a launchgroup keep the order the files were given in
+		size_type jobs = _processes.size();
+		for (std::unique_ptr<Launcher>& part : parts) {
+			jobs += part->_processes.size();
+		}
+		Reserve(jobs);
+		bool valid = true;
+		for (size_type index = 0; index < files.size(); ++index) {
+			if (!opened[index]) {
+				std::wcerr << L"Error: File " << FromUtf8(files[index]) << L" could not be opened" << std::endl;
+				valid = false;
+				continue;
+			}
+			std::wostream* errorOutput = _errors;
+			_errors = &errors[index];
+			for (std::pair<size_type, std::string> const& directive : parts[index]->_directives) {
+				ParseLine(directive.first, directive.second);
+			}
+			_errors = errorOutput;
+
+			std::wstring text = errors[index].str();
+			if (!text.empty()) {
+				*_errors << L"In " << FromUtf8(files[index]) << L":" << std::endl << text;
+			}
+			Absorb(*parts[index]);
+		}
+		BuildIndex();
+		return valid;
+	}
+
+	// Method: rm::Launcher::Absorb
+	// Input: launcher a file was parsed into
+	// Purpose: Takes over its processes and their text
+	void rm::Launcher::Absorb(Launcher& part) {
+		_strings.Absorb(part._strings);
+		_shared.insert(part._shared.begin(), part._shared.end());
+		for (Process& proc : part._processes) {
+			_processes.push_back(std::move(proc));
+		}
+		part._processes.clear();
+		part._indexed = true;
+		_indexed = false;
+	}
+
+	// Method: rm::Launcher::Share
+	// Input: text a process refers to
+	// Output: Pooled, null terminated copy, the same one for equal texts
+	native_string_view rm::Launcher::Share(native_string_view text) {
+		std::set<native_string_view>::iterator found = _shared.find(text);
+		if (found != _shared.end()) {
+			return *found;
+		}
+		native_string_view pooled = _strings.Add(text);
+		_shared.insert(pooled);
+		return pooled;
+	}
+
+	// Method: rm::Launcher::Shard
+	// Input: index of this launcher instance from 0, number of instances
+	// Output: Number of jobs kept
+	// Purpose: Keeps only the jobs assigned to this instance, every instance given the same files agrees
+	rm::Launcher::size_type rm::Launcher::Shard(size_type index, size_type count) {
+		BuildIndex();
+
+		// Jobs joined by job id dependencies or pipes form one unit, rooted at its first job
+		std::vector<size_type> roots(_processes.size());
+		for (size_type job = 0; job < roots.size(); ++job) {
+			roots[job] = job;
+		}
+		auto find = [&roots](size_type job) {
+			while (roots[job] != job) {
+				job = roots[job] = roots[roots[job]];
+			}
+			return job;
+		};
+		std::map<native_string_view, size_type> ids;
+		for (size_type job = 0; job < _processes.size(); ++job) {
+			if (!_processes[job].GetId().empty()) {
+				ids.insert(std::make_pair(_processes[job].GetId(), job));
+			}
+		}
+		for (size_type job = 0; job < _processes.size(); ++job) {
+			for (std::vector<native_string_view> const& links : { _processes[job].GetDependencies(), _processes[job].GetSources() }) {
+				for (native_string_view dependency : links) {
+					std::map<native_string_view, size_type>::iterator found = ids.find(dependency);
+					if (found == ids.end()) {
+						continue;
+					}
+					size_type lhs = find(job), rhs = find(found->second);
+					roots[std::max(lhs, rhs)] = std::min(lhs, rhs);
+				}
+			}
+		}
+
+		// A unit goes to the instance picked by its first job's launchgroup, command and repeat of that command
+		std::vector<std::uint64_t> keys(_processes.size());
+		std::map<std::pair<size_type, RuntimeHistory::key_type>, size_type> repeats;
+		for (size_type job = 0; job < _processes.size(); ++job) {
+			RuntimeHistory::key_type command = RuntimeHistory::Key(_processes[job].GetCommand());
+			std::uint64_t key = command ^ (_processes[job].GetLaunchGroup() * 0x9E3779B97F4A7C15ULL) ^ (repeats[std::make_pair(_processes[job].GetLaunchGroup(), command)]++ * 0xC2B2AE3D27D4EB4FULL);
+			// splitmix64 finaliser, so every bit of the key decides the instance
+			key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+			keys[job] = key ^ (key >> 31);
+		}
+
+		// A sweep on its own is split by job instead, every instance keeps every count-th job
+		std::vector<size_type> members(_processes.size());
+		for (size_type job = 0; job < _processes.size(); ++job) {
+			++members[find(job)];
+		}
+		std::vector<Process> kept;
+		for (size_type job = 0; job < _processes.size(); ++job) {
+			if (_processes[job].GetSweep() != nullptr && members[find(job)] == 1) {
+				_processes[job].GetSweep()->SetShard(index, count);
+				kept.push_back(std::move(_processes[job]));
+			}
+			else if (keys[find(job)] % count == index) {
+				kept.push_back(std::move(_processes[job]));
+			}
+		}
+		_processes.swap(kept);
+		_indexed = false;
+		BuildIndex();
+		return GetJobCount();
+	}
+
+	// Method: rm::Launcher::ParseLine
+	// Input: line number for error messages, UTF-8 line without its line ending
+	// Purpose: Parses one line of the input file into a process or directive
+	//			Lines are "launchgroup [settings], application, parameters"
+	void rm::Launcher::ParseLine(size_type lineNumber, std::string_view line) {
+		// Blank lines are ignored
+		if (line.find_first_not_of(" \t") == std::string_view::npos) {
+			return;
+		}
+
+		// Directives configure the launcher rather than naming an application
+		// They are kept in file order, for the launcher this one is merged into and for compiled files
+		if (line[0] == '@') {
+			_directives.emplace_back(lineNumber, std::string(line));
+			if (_deferDirectives) {
+				return;
+			}
+			if (!ApplyDirective(line)) {
+				*_errors << L"Error at line: " << lineNumber << L". Invalid directive." << std::endl;
+			}
+			return;
+		}
+
+		// Skip line if there is only a launchgroup
+		size_t firstComma = line.find(',');
+		if (firstComma == std::string_view::npos) {
+			*_errors << L"Error at line: " << lineNumber << L". No application found." << std::endl;
+			return;
+		}
+		std::string_view launchgroup = line.substr(0, firstComma);
+		std::string_view app = line.substr(firstComma + 1);
+		std::string_view params;
+		// Check if parameters exist
+		size_t secondComma = app.find(',');
+		if (secondComma != std::string_view::npos) {
+			params = app.substr(secondComma + 1);
+			app = app.substr(0, secondComma);
+		}
+
+		// Skip line if there is no launchgroup
+		if (launchgroup.size() == 0) {
+			*_errors << L"Error at line: " << lineNumber << L". No launchgroup found." << std::endl;
+			return;
+		}
+
+		// Skip line if launchgroup is not a number
+		// Anything after the number is a list of key=value process settings
+		std::vector<std::string_view> settings = SplitWhitespace(launchgroup);
+		size_t launchnumber;
+		if (settings.empty() || !ParseUnsigned(settings[0], launchnumber)) {
+			*_errors << L"Error at line: " << lineNumber << L". Non-integer value in launchgroup." << std::endl;
+			return;
+		}
+
+		// trim start of app string
+		// all other invalid symbols are expected to be handled by user
+		while (!app.empty() && app[0] == ' ') {
+			app.remove_prefix(1);
+		}
+
+		// Launcher handles process order
+		Process& proc = Add(launchnumber, ToNative(app), ToNative(params));
+		for (size_t i = 1; i < settings.size(); ++i) {
+			std::string_view key, value;
+			if (!SplitKeyValue(settings[i], key, value) || !ApplyJobSetting(proc, key, value)) {
+				*_errors << L"Error at line: " << lineNumber << L". Invalid setting " << FromUtf8(settings[i]) << L"." << std::endl;
+			}
+		}
+	}
+
+	// Method: rm::Launcher::ApplyDirective
+	// Input: directive line from the input file, including the leading '@'
+	// Output: directive was understood
+	// Purpose: Applies launcher or launchgroup settings
+	bool rm::Launcher::ApplyDirective(std::string_view directive) {
+		std::vector<std::string_view> tokens = SplitWhitespace(directive.substr(1));
+		if (tokens.empty()) {
+			return false;
+		}
+
+		// Pick the target of the settings
+		pointer_type group = nullptr;
+		size_t first;
+		if (tokens[0] == "set") {
+			first = 1;
+		}
+		else if (tokens[0] == "env") {
+			// Environment templates are named, their settings are not launcher settings
+			return tokens.size() >= 2 && _environments.Define(tokens[1], std::vector<std::string_view>(tokens.begin() + 2, tokens.end()));
+		}
+		else if (tokens[0] == "group") {
+			size_t key;
+			if (tokens.size() < 2 || !ParseUnsigned(tokens[1], key)) {
+				return false;
+			}
+			group = &_launchGroups[key];
+			first = 2;
+		}
+		else {
+			return false;
+		}
+
+		bool valid = true;
+		for (size_t i = first; i < tokens.size(); ++i) {
+			std::string_view key, value;
+			if (!SplitKeyValue(tokens[i], key, value) || !ApplySetting(group, key, value)) {
+				valid = false;
+			}
+		}
+		return valid;
+	}
+
+	// Method: rm::Launcher::ApplySetting
+	// Input: launchgroup to configure or nullptr for the launcher, setting name and value
+	// Output: setting was understood
+	bool rm::Launcher::ApplySetting(pointer_type group, std::string_view key, std::string_view value) {
+		if (key == "concurrency") {
+			size_t limit;
+			if (!ParseUnsigned(value, limit) || limit == 0) {
+				return false;
+			}
+			if (group == nullptr) {
+				_concurrency = limit;
+			}
+			else {
+				group->SetConcurrency(limit);
+			}
+			return true;
+		}
+
+		// Placement is set for the launcher, a launchgroup or a process
+		if (group == nullptr ? _placement.ApplySetting(key, value) : group->GetPlacement().ApplySetting(key, value)) {
+			return true;
+		}
+		if (group == nullptr ? _limits.ApplySetting(key, value) : group->GetLimits().ApplySetting(key, value)) {
+			return true;
+		}
+		if (group == nullptr ? _retry.ApplySetting(key, value) : group->GetRetry().ApplySetting(key, value)) {
+			return true;
+		}
+		if (group == nullptr ? _admission.ApplySetting(key, value) : group->GetAdmission().ApplySetting(key, value)) {
+			return true;
+		}
+
+		// Environment template and working directory of processes that do not set their own
+		if (key == "env") {
+			if (value.empty()) {
+				return false;
+			}
+			if (group == nullptr) {
+				_environment = value;
+			}
+			else {
+				group->SetEnvironment(value);
+			}
+			return true;
+		}
+		if (key == "cwd") {
+			if (value.empty()) {
+				return false;
+			}
+			if (group == nullptr) {
+				_directory = ToNative(value);
+			}
+			else {
+				group->SetDirectory(ToNative(value));
+			}
+			return true;
+		}
+
+		// Output capture is set for the whole launcher or per process, progress only for the launcher
+		if (group != nullptr) {
+			return false;
+		}
+		if (_progress.ApplySetting(key, value) || _journal.ApplySetting(key, value) || _pressure.ApplySetting(key, value)
+			|| _forkServer.ApplySetting(key, value)) {
+			return true;
+		}
+		if (key == "capture") {
+			return ParseOutputMode(value, _output);
+		}
+		if (key == "capture_tail") {
+			// Kilobytes kept from each stream
+			size_t kilobytes;
+			if (!ParseUnsigned(value, kilobytes)) {
+				return false;
+			}
+			_capture.SetTailSize(kilobytes * 1024);
+			return true;
+		}
+		if (key == "capture_dir") {
+			if (value.empty()) {
+				return false;
+			}
+			_capture.SetDirectory(ToNative(value));
+			return true;
+		}
+		if (key == "cache") {
+			// Directory of the result cache, caching is off until it is set
+			if (value.empty()) {
+				return false;
+			}
+			_cache.SetDirectory(ToNative(value));
+			return true;
+		}
+		if (key == "history") {
+			// Database of earlier run times, used to start long processes first
+			if (value.empty()) {
+				return false;
+			}
+			_history.SetPath(ToNative(value));
+			return true;
+		}
+		if (key == "cgroup") {
+			// Delegated cgroup v2 directory memory_max and cpu_max are enforced in
+			if (value.empty()) {
+				return false;
+			}
+			_placement.cgroup = ToNative(value);
+			return true;
+		}
+		return false;
+	}
+
+	// Method: rm::Launcher::ApplyJobSetting
+	// Input: process to configure, setting name and value from the launchgroup column
+	// Output: setting was understood
+	bool rm::Launcher::ApplyJobSetting(Process& proc, std::string_view key, std::string_view value) {
+		if (key == "id") {
+			if (value.empty()) {
+				return false;
+			}
+			proc.SetId(_strings.Add(ToNative(value)));
+			return true;
+		}
+		if (key == "after") {
+			// Dependencies are separated by ';' as ',' separates columns
+			if (value.empty()) {
+				return false;
+			}
+			native_string previous(proc.GetDependencyList());
+			native_string list = previous.empty() ? native_string(ToNative(value)) : previous + RM_TEXT(';') + native_string(ToNative(value));
+			proc.SetDependencyList(_strings.Add(list));
+			return true;
+		}
+		if (key == "stdin") {
+			// Job ids whose stdout is piped in, several are merged and a job may be read by several
+			if (value.empty()) {
+				return false;
+			}
+			native_string previous(proc.GetSourceList());
+			native_string list = previous.empty() ? native_string(ToNative(value)) : previous + RM_TEXT(';') + native_string(ToNative(value));
+			proc.SetSourceList(_strings.Add(list));
+			return true;
+		}
+		if (key == "capture") {
+			OutputMode mode;
+			if (!ParseOutputMode(value, mode)) {
+				return false;
+			}
+			proc.SetOutputMode(mode);
+			return true;
+		}
+		if (key == "inputs") {
+			// Files whose contents decide the result, separated by ';' like dependencies
+			if (value.empty()) {
+				return false;
+			}
+			native_string previous(proc.GetInputList());
+			native_string list = previous.empty() ? native_string(ToNative(value)) : previous + RM_TEXT(';') + native_string(ToNative(value));
+			proc.SetInputList(_strings.Add(list));
+			return true;
+		}
+		if (key == "cache") {
+			if (value == "yes") {
+				proc.SetCacheable(true);
+			}
+			else if (value == "no") {
+				proc.SetCacheable(false);
+			}
+			else {
+				return false;
+			}
+			return true;
+		}
+
+		// The environment is kept as text until RunAll, when templates defined anywhere in the batch are known
+		if (key == "env") {
+			// Names the template, overrides already given are kept
+			native_string_view previous = proc.GetEnvironmentText();
+			if (value.empty()) {
+				return false;
+			}
+			native_string text(ToNative(value));
+			text += previous.substr(std::min(previous.find(' '), previous.size()));
+			proc.SetEnvironmentText(Share(text).data());
+			return true;
+		}
+		if (key.compare(0, 4, "env.") == 0) {
+			// env.NAME=value sets one variable on top of the template
+			if (key.size() == 4 || key[4] == '-') {
+				return false;
+			}
+			native_string text(proc.GetEnvironmentText());
+			text += RM_TEXT(' ');
+			text += ToNative(key.substr(4));
+			text += RM_TEXT('=');
+			text += ToNative(value);
+			proc.SetEnvironmentText(Share(text).data());
+			return true;
+		}
+		if (key == "cwd") {
+			if (value.empty()) {
+				return false;
+			}
+			proc.SetDirectory(Share(ToNative(value)).data());
+			return true;
+		}
+
+		if (key == "timeout") {
+			Process::duration_type timeout;
+			if (!ParseDuration(value, timeout) || timeout <= Process::duration_type::zero()) {
+				return false;
+			}
+			proc.SetTimeout(timeout);
+			return true;
+		}
+		if (key == "grace") {
+			Process::duration_type grace;
+			if (!ParseDuration(value, grace) || grace <= Process::duration_type::zero()) {
+				return false;
+			}
+			proc.SetGrace(grace);
+			return true;
+		}
+		if (key.compare(0, 6, "sweep.") == 0) {
+			// sweep.NAME=first..last[:step] or sweep.NAME=a;b;c, each axis multiplies the jobs
+			Sweep sweep = proc.GetSweep() == nullptr ? Sweep() : *proc.GetSweep();
+			if (!sweep.AddAxis(key.substr(6), value)) {
+				return false;
+			}
+			proc.SetSweep(sweep);
+			return true;
+		}
+
+		// Retry settings are collected in the process's own retry policy
+		RetryPolicy retry;
+		if (retry.ApplySetting(key, value)) {
+			if (proc.GetRetry() == nullptr) {
+				proc.SetRetry(retry);
+			}
+			return proc.GetRetry()->ApplySetting(key, value);
+		}
+
+		// Placement settings are collected in the process's own placement
+		Placement placement;
+		if (placement.ApplySetting(key, value)) {
+			if (proc.GetPlacement() == nullptr) {
+				proc.SetPlacement(placement);
+			}
+			return proc.GetPlacement()->ApplySetting(key, value);
+		}
+		return false;
 	}
 
 	// Method: rm::Launcher::RunAll
-	// Purpose: Calls launchgroups to launch processes
+	// Purpose: Runs every process as soon as its prerequisites have finished
+	//			Processes without explicit dependencies wait for the previous launchgroup
 	void rm::Launcher::RunAll() {
+		Process::clock_type::time_point begin = Process::clock_type::now();
+		BuildIndex();
+
+		// Logs are named after the job id, or the launchgroup and position within it
 		for (container_type::value_type& group : _launchGroups) {
-			group.second.RunAllAsync();
+			size_type position = 0;
+			for (Process& proc : group.second) {
+				++position;
+				OutputMode mode = proc.GetOutputMode() == OutputMode::Default ? _output : proc.GetOutputMode();
+				if (proc.GetSweep() != nullptr) {
+					// Jobs of a sweep are expanded as they start and share the console
+					if (mode == OutputMode::Tail || mode == OutputMode::Log) {
+						std::wcerr << L"Error: Output of a sweep can not be captured, " << ToWide(proc.GetApp()) << L" shares the console." << std::endl;
+					}
+					continue;
+				}
+				if (mode == OutputMode::Tail || mode == OutputMode::Log) {
+					native_string name = proc.GetId().empty()
+						? native_string(ToNative(std::to_string(group.first) + "-" + std::to_string(position)))
+						: native_string(proc.GetId());
+					_capture.Register(&proc, mode, name);
+				}
+			}
+		}
+
+		// Processes inherit the placement of their launchgroup, then of the launcher
+		// and launchgroups inherit the time limits, retry policy and pressure thresholds of the launcher
+		bool automatic = false;
+		bool limited = false;
+		AdmissionPolicy admission;
+		for (container_type::value_type& group : _launchGroups) {
+			group.second.GetLimits().Merge(_limits);
+			group.second.GetRetry().Merge(_retry);
+			group.second.GetAdmission().Merge(_admission);
+			admission.Merge(group.second.GetAdmission());
+			for (Process& proc : group.second) {
+				if (proc.GetRetry() != nullptr) {
+					proc.GetRetry()->Merge(group.second.GetRetry());
+				}
+				if (proc.GetPlacement() == nullptr) {
+					if (group.second.GetPlacement().Empty() && _placement.Empty()) {
+						continue;
+					}
+					proc.SetPlacement(Placement());
+				}
+				Placement& placement = *proc.GetPlacement();
+				placement.Merge(group.second.GetPlacement());
+				placement.Merge(_placement);
+				automatic = automatic || placement.automatic;
+				limited = limited || placement.memoryMax != 0 || placement.cpuMax != 0;
+			}
+		}
+
+		// Processes sharing an environment share one block, built the first time it is needed
+		for (container_type::value_type& group : _launchGroups) {
+			std::string const& environment = group.second.GetEnvironment().empty() ? _environment : group.second.GetEnvironment();
+			native_string const& directory = group.second.GetDirectory().empty() ? _directory : group.second.GetDirectory();
+			std::map<native_string_view::const_pointer, Environment const*> resolved;
+			for (Process& proc : group.second) {
+				native_string_view text = proc.GetEnvironmentText();
+				std::map<native_string_view::const_pointer, Environment const*>::iterator found = resolved.find(text.data());
+				if (found == resolved.end()) {
+					found = resolved.insert(std::make_pair(text.data(), _environments.Resolve(text, environment))).first;
+				}
+				proc.SetEnvironment(found->second);
+				if (proc.GetDirectory().empty() && !directory.empty()) {
+					proc.SetDirectory(directory.c_str());
+				}
+			}
+		}
+#ifndef _WIN32
+		if (limited && !_placement.cgroup.empty()) {
+			Placement::PrepareCgroup(_placement.cgroup);
+		}
+#endif
+
+		// Long processes start first when earlier run times are known
+		if (_history.Enabled()) {
+			_history.Load();
+			for (Process& proc : _processes) {
+				_history.Predict(proc);
+			}
+		}
+
+		// Automatic placements give each slot of the scheduler its own CPUs
+		std::unique_ptr<CpuLayout> layout;
+		if (automatic) {
+			layout.reset(new CpuLayout(_concurrency));
+		}
+
+		// An interrupted batch resumes where its journal left off
+		bool journaled = false;
+		if (_journal.Enabled()) {
+			journaled = _journal.Open(_launchGroups);
+		}
+		else if (_journal.IsResuming()) {
+			std::wcerr << L"Error: Nothing to resume from, set a journal with @set journal=<file>. Every job will run." << std::endl;
+		}
+
+		// Pressure is only sampled when some launchgroup has a threshold
+		if (admission.Enabled()) {
+			_pressure.Open(admission);
+		}
+
+		// Helpers are started before the first process, launches go through them until the run ends
+		if (_forkServer.Enabled() && _forkServer.Open()) {
+			Process::SetForkServer(&_forkServer);
+		}
+
+		Scheduler scheduler(_launchGroups, _concurrency, _capture.Empty() ? nullptr : &_capture,
+			_cache.Enabled() ? &_cache : nullptr, layout.get(), &_progress, journaled ? &_journal : nullptr,
+			admission.Enabled() ? &_pressure : nullptr, _trace);
+		_progress.Start(GetJobCount());
+		Process::clock_type::time_point scheduled = Process::clock_type::now();
+		scheduler.Run();
+		_progress.Stop();
+		Process::SetForkServer(nullptr);
+		_forkServer.Close();
+		if (_trace != nullptr) {
+			_trace->Phase("prepare", begin, scheduled);
+			_trace->Phase("schedule", scheduled, Process::clock_type::now());
+		}
+		_journal.Close();
+		_pressure.Close();
+		_capture.Finish();
+		_schedule = scheduler.GetStats();
+
+		// Results are stored once their output has been drained
+		if (_cache.Enabled()) {
+			for (Process& proc : _processes) {
+				_cache.Store(proc, _capture.Empty() ? nullptr : &_capture);
+			}
+		}
+		if (_history.Enabled()) {
+			for (Process& proc : _processes) {
+				_history.Record(proc);
+			}
+			_history.Save();
 		}
 	}
 
@@ -47,9 +862,100 @@ namespace rm {
 		}
 		outstream << std::endl;
 		for (container_type::value_type& group : _launchGroups) {
-			group.second.PrintErrors(outstream);
+			group.second.PrintErrors(outstream, &_capture);
+		}
+	}
+
+	// Method: rm::Launcher::PrintFootprint
+	// Purpose: Prints the memory used to store processes
+	void rm::Launcher::PrintFootprint(std::wostream& outstream) {
+		outstream << L"Storage: " << _processes.size() << L" processes, "
+			<< _processes.capacity() * sizeof(Process) << L" bytes of records, "
+			<< _strings.Capacity() << L" bytes of text, "
+			<< GetMemoryFootprint() << L" bytes total" << std::endl;
+		if (GetJobCount() != _processes.size()) {
+			size_type sweeps = 0;
+			for (Process& proc : _processes) {
+				sweeps += proc.GetSweep() == nullptr ? 0 : 1;
+			}
+			outstream << L"Sweeps: " << GetJobCount() - (_processes.size() - sweeps) << L" jobs expanded from " << sweeps
+				<< L" lines, " << sizeof(SweepResult) << L" bytes of results per job" << std::endl;
+		}
+		if (_environments.GetCount() > 0) {
+			outstream << L"Environments: " << _environments.GetCount() << L" built, "
+				<< _environments.GetMemoryFootprint() << L" bytes shared by every process" << std::endl;
+		}
+	}
+
+	// Method: rm::Launcher::PrintCacheStats
+	// Purpose: Prints how many processes the result cache restored, if it is on
+	void rm::Launcher::PrintCacheStats(std::wostream& outstream) {
+		if (_cache.Enabled()) {
+			outstream << _cache.GetStats();
+		}
+	}
+
+	// Method: rm::Launcher::PrintJournalStats
+	// Purpose: Prints how many records the journal wrote and how often it synced them, if it is on
+	void rm::Launcher::PrintJournalStats(std::wostream& outstream) {
+		if (_journal.Enabled()) {
+			outstream << L"Journal: " << _journal.GetRecords() << L" records in " << _journal.GetSyncs() << L" syncs" << std::endl;
 		}
 	}
+
+	// Method: rm::Launcher::PrintGroupSummary
+	// Purpose: Prints the size, concurrency and predicted against actual time of every launchgroup
+	void rm::Launcher::PrintGroupSummary(std::wostream& outstream) {
+		for (container_type::value_type& group : _launchGroups) {
+			outstream << L"Launchgroup " << group.first << L": ";
+			group.second.PrintSummary(outstream, _concurrency);
+		}
+		outstream << _schedule;
+	}
+
+	// Method: rm::Launcher::PrintSpawnStats
+	// Purpose: Prints spawn latency and launch overhead of every started process, and how many a fork server spawned
+	void rm::Launcher::PrintSpawnStats(std::wostream& outstream) {
+		using microseconds = std::chrono::duration<double, std::micro>;
+
+		size_type launches = 0;
+		Process::duration_type totalSpawn = Process::duration_type::zero();
+		Process::duration_type totalOverhead = Process::duration_type::zero();
+		Process::duration_type minSpawn = Process::duration_type::max();
+		Process::duration_type maxSpawn = Process::duration_type::zero();
+		for (container_type::value_type& group : _launchGroups) {
+			for (Process& proc : group.second) {
+				proc.ForEachJob([&](Process& job) {
+					if (!job.DidRun() || job.IsCached() || job.IsResumed()) {
+						return;
+					}
+					++launches;
+					totalSpawn += job.GetSpawnLatency();
+					totalOverhead += job.GetLaunchOverhead();
+					minSpawn = std::min(minSpawn, job.GetSpawnLatency());
+					maxSpawn = std::max(maxSpawn, job.GetSpawnLatency());
+				});
+			}
+		}
+
+		if (launches == 0) {
+			return;
+		}
+
+		outstream << std::fixed << std::setprecision(1)
+			<< L"Launches: " << launches << std::endl
+			<< L"Spawn latency (us): mean " << microseconds(totalSpawn).count() / launches
+			<< L", min " << microseconds(minSpawn).count()
+			<< L", max " << microseconds(maxSpawn).count() << std::endl
+			<< L"Launch overhead (us): mean " << microseconds(totalOverhead).count() / launches
+			<< L", total " << microseconds(totalOverhead).count() << std::endl;
+		if (_forkServer.GetSpawnCount() != 0 || _forkServer.GetFallbackCount() != 0) {
+			outstream << L"Fork server: " << _forkServer.GetSpawnCount() << L" spawned by helpers, "
+				<< _forkServer.GetFallbackCount() << L" fell back to spawning directly" << std::endl;
+		}
+		outstream.unsetf(std::ios_base::floatfield);
+		outstream.precision(6);
+	}
 /// End Launcher::Operations
 
 /// Begin Launcher::Operators
@@ -58,51 +964,36 @@ namespace rm {
 	// Output: input file
 	// Purpose: Parses through input file for launchgroup and application information
 	//			generates process object, sorting of processes is handled elsewhere
-	std::wifstream& rm::operator>>(std::wifstream& lhs, rm::Launcher& rhs) {
+	std::wifstream& operator>>(std::wifstream& lhs, rm::Launcher& rhs) {
 		size_t currLine = 0;
 		while (!lhs.eof()) {
 			++currLine;
 
-			std::wstring launchgroup;
-			std::wstring app;
-			std::wstring params;
-
-			// Parse Line
-			// Skip line if there is only a launchgroup
-			if (!GetLine(lhs, launchgroup, L',')) {
-				std::cerr << "Error at line: " << currLine << ". No application found." << std::endl;
-				continue;
-			}
-			// Check if parameters exist
-			if (GetLine(lhs, app, L',')) {
-				GetLine(lhs, params);
-			}
-
-			// Skip line if there is no launchgroup
-			if (launchgroup.size() == 0) {
-				std::cerr << "Error at line: " << currLine << ". No launchgroup found." << std::endl;
-				continue;
-			}
-
-			// Skip line if launchgroup is not a number
-			rm::Process::size_type launchnumber;
-			try {
-				launchnumber = std::stoul(launchgroup);
-			}
-			catch (std::invalid_argument e) {
-				std::cerr << "Error at line: " << currLine << ". Non-integer value in launchgroup." << std::endl;
-				continue;
+			std::wstring line;
+			GetLine(lhs, line);
+			// Accept Windows line endings
+			if (!line.empty() && line.back() == L'\r') {
+				line.pop_back();
 			}
+			rhs.ParseLine(currLine, ToUtf8(line));
+		}
+		rhs.BuildIndex();
 
-			// trim start of app string
-			// all other invalid symbols are expected to be handled by user
-			while (app[0] == ' ') {
-				app.erase(0, 1);
-			}
+		return lhs;
+	}
 
-			// Launcher handles process order
-			rhs.Add(new rm::Process(launchnumber, app, params));
+	// Method: operator>>
+	// Input: memory mapped input file, Launcher to parse into
+	// Output: input file
+	// Purpose: Parses each line of the file in place, without copying it through a stream
+	BatchFile& operator>>(BatchFile& lhs, rm::Launcher& rhs) {
+		BatchFile::line_type line;
+		// Most lines are processes, counting them is cheaper than growing the process list
+		rhs.Reserve(lhs.CountLines());
+		while (lhs.NextLine(line)) {
+			rhs.ParseLine(lhs.GetLineNumber(), line);
 		}
+		rhs.BuildIndex();
 
 		return lhs;
 	}
@@ -111,7 +1002,7 @@ namespace rm {
 	// Input: output stream, Launcher to parse from
 	// Output: output stream
 	// Purpose: Prints Table Headers and error data
-	std::wostream& rm::operator<<(std::wostream& lhs, rm::Launcher& rhs) {
+	std::wostream& operator<<(std::wostream& lhs, rm::Launcher& rhs) {
 		// Print table headers
 		lhs << std::setw(3) << std::right
 			<< L"LG" << L" |"
@@ -126,6 +1017,12 @@ namespace rm {
 
 		// Call launchgroups to print process info
 		rhs.PrintData(lhs);
+		lhs << std::endl;
+		rhs.PrintGroupSummary(lhs);
+		rhs.PrintSpawnStats(lhs);
+		rhs.PrintCacheStats(lhs);
+		rhs.PrintJournalStats(lhs);
+		rhs.PrintFootprint(lhs);
 
 		// Return ostream
 		return lhs;
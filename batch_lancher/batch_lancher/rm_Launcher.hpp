@@ -2,16 +2,28 @@
 File: rm_Launcher.hpp
 Author: Ryan McNamee
 Date Created: Friday, 29, September, 2017
-Date Updated: Monday, 9, October, 2017
+Date Updated: Saturday, 17, October, 2026
 Purpose: Parse input file, generate sorted launchgroups and processes
 		Output basic information about run
 */
 #ifndef RM_LAUNCHER_HEADER_GUARD
 #define RM_LAUNCHER_HEADER_GUARD
 #include "rm_LaunchGroup.hpp"
+#include "rm_Scheduler.hpp"
+#include "rm_ResultCache.hpp"
+#include "rm_History.hpp"
+#include "rm_BatchFile.hpp"
+#include "rm_StringPool.hpp"
+#include "rm_Environment.hpp"
+#include "rm_ForkServer.hpp"
 #include <set>
 #include <fstream>
 #include <map>
+#include <vector>
+#include <string_view>
+#include <string>
+#include <utility>
+#include <ostream>
 
 namespace rm {
 	class Launcher {
@@ -24,7 +36,54 @@ namespace rm {
 
 		using size_type = size_t;
 	private:	/// Variables
+		// Text of every process, must outlive _processes
+		StringPool _strings;
+		// Every process, grouped by launchgroup once indexed
+		std::vector<Process> _processes;
+		// Whether each launchgroup points at its processes
+		bool _indexed;
 		container_type _launchGroups;
+		// Maximum number of processes running at once across all launchgroups
+		size_type _concurrency;
+		// Summary of the last RunAll
+		Scheduler::Stats _schedule;
+		// Where output goes for processes that do not choose
+		OutputMode _output;
+		OutputCapture _capture;
+		// Skips processes whose results are unchanged, off unless a directory is set
+		ResultCache _cache;
+		// Run times of earlier runs, off unless a database file is set
+		RuntimeHistory _history;
+		// Placement of processes that neither they nor their launchgroup set
+		// Its cgroup is the delegated directory quotas are created in
+		Placement _placement;
+		// Timeout and straggler handling of launchgroups that do not set their own
+		TimeLimits _limits;
+		// Retry policy of launchgroups that do not set their own
+		RetryPolicy _retry;
+		// Pressure thresholds of launchgroups that do not set their own, and the monitor sampling it
+		AdmissionPolicy _admission;
+		PressureMonitor _pressure;
+		// Status line and metrics file while processes run
+		Progress _progress;
+		// Journal of job starts and finishes, off unless a file is set
+		Journal _journal;
+		// Helpers spawning processes for RunAll, off unless a number of helpers is set
+		ForkServer _forkServer;
+		// Timeline of the run, null unless a trace was asked for
+		Trace* _trace;
+		// Environment templates and the environments built from them for RunAll
+		EnvironmentTable _environments;
+		// Environment template and working directory of launchgroups that do not set their own
+		std::string _environment;
+		native_string _directory;
+		// Pooled environment texts and working directories, so processes setting the same one share it
+		std::set<native_string_view> _shared;
+		// Where parse errors go, the launchers ParseFiles parses each file into buffer theirs
+		std::wostream* _errors;
+		// Directives held back in file order, to be applied by the launcher this one is merged into
+		bool _deferDirectives;
+		std::vector<std::pair<size_type, std::string>> _directives;
 	public:		/// Methods
 		/// Constructors
 		Launcher();
@@ -33,17 +92,173 @@ namespace rm {
 
 		/// Operations
 		// Method: rm::Launcher::Add
-		// Purpose: Handles the sorting of processes into launchgroups
-		void Add(value_type::pointer_type const& proc);
+		// Input: launchgroup, application and parameters of a new process
+		// Output: The new process, valid until the next call to Add
+		// Purpose: Stores the process and its text, sorting into launchgroups is left to BuildIndex
+		Process& Add(size_type group, native_string_view app, native_string_view params);
+
+		// Method: rm::Launcher::Reserve
+		// Input: expected number of processes
+		// Purpose: Avoids moving processes while parsing
+		inline void Reserve(size_type count) {
+			_processes.reserve(count);
+		}
+
+		// Method: rm::Launcher::BuildIndex
+		// Purpose: Sorts processes by launchgroup and points each launchgroup at its processes
+		//			Called once parsing has finished
+		void BuildIndex();
+
+		// Method: rm::Launcher::GetProcessCount
+		// Output: Number of processes parsed
+		inline size_type GetProcessCount() {
+			return _processes.size();
+		}
+
+		// Method: rm::Launcher::GetJobCount
+		// Output: Number of jobs, counting each job of a sweep
+		size_type GetJobCount();
+
+		// Method: rm::Launcher::GetProcesses
+		// Output: Every process, ordered by launchgroup once indexed
+		inline std::vector<Process>& GetProcesses() {
+			return _processes;
+		}
+
+		// Method: rm::Launcher::GetSchedule
+		// Output: Summary of the last RunAll
+		inline Scheduler::Stats const& GetSchedule() {
+			return _schedule;
+		}
+
+		// Method: rm::Launcher::SetResume
+		// Input: Whether RunAll skips jobs its journal shows finished successfully before an interruption
+		inline void SetResume(bool resume) {
+			_journal.SetResume(resume);
+		}
+
+		// Method: rm::Launcher::SetTrace
+		// Input: Open trace RunAll writes the run to, which must outlive it
+		inline void SetTrace(Trace* trace) {
+			_trace = trace;
+		}
+
+		// Method: rm::Launcher::GetMemoryFootprint
+		// Output: Bytes used to store processes, their text and launchgroups
+		size_type GetMemoryFootprint();
+
+		// Method: rm::Launcher::ParseFiles
+		// Input: batch files and directories of batch files, in the order their jobs are merged
+		// Output: Whether every file could be read
+		// Purpose: Parses the files at once on worker threads and merges their jobs
+		//			Directives are applied afterwards in file order, so later files override earlier ones
+		bool ParseFiles(std::vector<std::string> const& paths);
+
+		// Method: rm::Launcher::Shard
+		// Input: index of this launcher instance from 0, number of instances
+		// Output: Number of jobs kept
+		// Purpose: Keeps only the jobs assigned to this instance, every instance given the same files agrees
+		//			Jobs linked by job id dependencies stay together, launchgroup barriers only hold within an instance
+		//			A sweep linked to no other job is split by job across every instance
+		size_type Shard(size_type index, size_type count);
+
+		// Method: rm::Launcher::Compile
+		// Input: path of the compiled file to write
+		// Output: Whether the file was written
+		// Purpose: Writes the parsed processes and directives so a later run can load them without parsing
+		bool Compile(std::string const& path);
+
+		// Method: rm::Launcher::IsCompiled
+		// Input: opened batch file
+		// Output: Whether it is a compiled batch file rather than text
+		static bool IsCompiled(BatchFile& file);
+
+		// Method: rm::Launcher::ParseLine
+		// Input: line number for error messages, UTF-8 line without its line ending
+		// Purpose: Parses one line of the input file into a process or directive
+		//			Lines are "launchgroup [settings], application, parameters"
+		void ParseLine(size_type lineNumber, std::string_view line);
+
+		// Method: rm::Launcher::ApplyDirective
+		// Input: directive line from the input file, including the leading '@'
+		// Output: directive was understood
+		// Purpose: Applies launcher or launchgroup settings, e.g.
+		//			@set concurrency=8
+		//			@set status=on status_interval=2s metrics=batch.prom
+		//			@set journal=batch.journal journal_sync=100ms
+		//			@group 3 concurrency=2 placement=auto
+		//			@group 4 timeout=30s straggler=relaunch straggler_factor=2
+		//			@group 5 attempts=3 backoff=1s retry_on=start;75
+		//			@set pressure_memory=10 memory_available=2G pressure_interval=250ms
+		//			@set fork_server=1
+		//			@env build CC=gcc CFLAGS=-O2 -DEBUG
+		//			@group 6 env=build cwd=out/release
+		bool ApplyDirective(std::string_view directive);
+
+		// Method: rm::Launcher::ApplyJobSetting
+		// Input: process to configure, setting name and value from the launchgroup column
+		// Output: setting was understood
+		// Purpose: Applies per process settings, e.g.
+		//			2 id=link after=compile;group:1, app, params
+		//			3 inputs=a.obj;b.obj cache=no, app, params
+		//			4 cpus=0-3 nice=5 memory_max=512M, app, params
+		//			5 timeout=10m grace=5s attempts=3 backoff=50ms backoff_max=5s, app, params
+		//			6 env=build env.CFLAGS=-O0 cwd=out/debug, app, params
+		//			7 sweep.seed=1..1000 sweep.model=small;large, app, --seed {seed} --model {model} --out run{index}
+		//			8 id=extract, app, params
+		//			8 stdin=extract;fetch, app, params
+		bool ApplyJobSetting(Process& proc, std::string_view key, std::string_view value);
 
 		// Method: rm::Launcher::RunAll
-		// Purpose: Calls launchgroups to launch processes
+		// Purpose: Runs every process as soon as its prerequisites have finished
+		//			Processes without explicit dependencies wait for the previous launchgroup
 		void RunAll();
 
 		// Method: rm::Launcher::PrintData
 		// Purpose: Calls all launchgroups to print process data
 		// Reason: Did not want to give access to data structure
 		void PrintData(std::wostream& outstream);
+
+		// Method: rm::Launcher::PrintSpawnStats
+		// Purpose: Prints spawn latency and launch overhead of every started process, and how many a fork server spawned
+		void PrintSpawnStats(std::wostream& outstream);
+
+		// Method: rm::Launcher::PrintFootprint
+		// Purpose: Prints the memory used to store processes
+		void PrintFootprint(std::wostream& outstream);
+
+		// Method: rm::Launcher::PrintCacheStats
+		// Purpose: Prints how many processes the result cache restored, if it is on
+		void PrintCacheStats(std::wostream& outstream);
+
+		// Method: rm::Launcher::PrintJournalStats
+		// Purpose: Prints how many records the journal wrote and how often it synced them, if it is on
+		void PrintJournalStats(std::wostream& outstream);
+
+		// Method: rm::Launcher::PrintGroupSummary
+		// Purpose: Prints the size, concurrency and predicted against actual time of every launchgroup
+		void PrintGroupSummary(std::wostream& outstream);
+	private:
+		// Method: rm::Launcher::ApplySetting
+		// Input: launchgroup to configure or nullptr for the launcher, setting name and value
+		// Output: setting was understood
+		bool ApplySetting(pointer_type group, std::string_view key, std::string_view value);
+
+		// Method: rm::Launcher::Share
+		// Input: text a process refers to
+		// Output: Pooled, null terminated copy, the same one for equal texts
+		native_string_view Share(native_string_view text);
+
+		// Method: rm::Launcher::Absorb
+		// Input: launcher a file was parsed into
+		// Purpose: Takes over its processes and their text
+		void Absorb(Launcher& part);
+
+		// Method: rm::Launcher::LoadCompiled
+		// Input: opened compiled batch file
+		// Output: Whether the file was valid and its processes were added
+		// Purpose: Copies the string pool in one block and builds each process from its fixed size record
+		bool LoadCompiled(BatchFile& file);
 	};
 
 	/// Operators
@@ -54,6 +269,11 @@ namespace rm {
 	//			generates process object, sorting of processes is handled elsewhere
 	std::wifstream& operator>>(std::wifstream& lhs, Launcher& rhs);
 	// Method: operator>>
+	// Input: memory mapped input file, Launcher to parse into
+	// Output: input file
+	// Purpose: Parses each line of the file in place, without copying it through a stream
+	BatchFile& operator>>(BatchFile& lhs, Launcher& rhs);
+	// Method: operator>>
 	// Input: output stream, Launcher to parse from
 	// Output: output stream
 	// Purpose: Prints Table Headers and error data
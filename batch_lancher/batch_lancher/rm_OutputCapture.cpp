@@ -0,0 +1,298 @@
+/*
+File: rm_OutputCapture.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Platform independent parts of rm::OutputCapture
+		Pipes and the I/O thread live in rm_OutputCapture_posix.cpp and rm_OutputCapture_win32.cpp
+*/
+#include "rm_OutputCapture.hpp"
+#include "rm_lib.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+namespace rm {
+	namespace {
+		// Names of the captured streams, in the order of Capture::streams
+		wchar_t const* const STREAM_NAMES[] = { L"stdout", L"stderr" };
+		native_char const* const LOG_EXTENSIONS[] = { RM_TEXT(".out"), RM_TEXT(".err") };
+		native_char const* const SAVED_NAMES[] = { RM_TEXT("stdout"), RM_TEXT("stderr") };
+
+		// Method: ReadTail
+		// Purpose: Reads at most size bytes from the end of a file
+		std::string ReadTail(native_string const& path, size_t size, size_t& dropped) {
+			std::ifstream file(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+			dropped = 0;
+			if (!file) {
+				return std::string();
+			}
+			std::streamoff length = file.tellg();
+			if (length > static_cast<std::streamoff>(size)) {
+				dropped = static_cast<size_t>(length) - size;
+			}
+			file.seekg(dropped);
+			std::string output(static_cast<size_t>(length) - dropped, '\0');
+			file.read(&output[0], output.size());
+			output.resize(static_cast<size_t>(file.gcount()));
+			return output;
+		}
+	}
+
+/// Begin OutputCapture::RingBuffer
+	// Method: RingBuffer::Write
+	// Input: bytes to append, capacity to allocate on first use
+	void OutputCapture::RingBuffer::Write(char const* bytes, size_type count, size_type size) {
+		if (data == nullptr) {
+			if (size == 0) {
+				written += count;
+				return;
+			}
+			data.reset(new char[size]);
+			capacity = size;
+		}
+		// Only the last capacity bytes can survive
+		if (count > capacity) {
+			written += count - capacity;
+			bytes += count - capacity;
+			count = capacity;
+		}
+		size_type start = written % capacity;
+		size_type first = std::min(count, capacity - start);
+		std::copy(bytes, bytes + first, data.get() + start);
+		std::copy(bytes + first, bytes + count, data.get());
+		written += count;
+	}
+
+	// Method: RingBuffer::Contents
+	// Output: The last bytes written, oldest first
+	std::string OutputCapture::RingBuffer::Contents() {
+		if (data == nullptr) {
+			return std::string();
+		}
+		if (written <= capacity) {
+			return std::string(data.get(), written);
+		}
+		size_type start = written % capacity;
+		std::string output(data.get() + start, capacity - start);
+		output.append(data.get(), start);
+		return output;
+	}
+/// End OutputCapture::RingBuffer
+
+/// Begin OutputCapture::Operations
+	// Method: OutputCapture::Register
+	// Input: process to capture, OutputMode::Tail or OutputMode::Log, name of its log files
+	// Purpose: Marks the output of a process to be captured when it starts
+	void OutputCapture::Register(pointer_type proc, OutputMode mode, native_string_view name) {
+		if (mode != OutputMode::Tail && mode != OutputMode::Log) {
+			return;
+		}
+		std::unique_ptr<Capture>& capture = captures[proc];
+		capture.reset(new Capture);
+		capture->mode = mode;
+		for (int i = 0; i < 2; ++i) {
+			if (mode == OutputMode::Log) {
+				std::filesystem::path path(directory.empty() ? native_string(RM_TEXT(".")) : directory);
+				path /= native_string(name) + LOG_EXTENSIONS[i];
+				capture->streams[i].path = path.native();
+			}
+		}
+	}
+
+	// Method: OutputCapture::RegisterCopy
+	// Input: copy of a process about to start, the registered original
+	// Purpose: Captures the copy the same way as the original, logs get ".copy" before their extension
+	void OutputCapture::RegisterCopy(pointer_type copy, pointer_type original) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(original);
+		if (found == captures.end()) {
+			return;
+		}
+		std::unique_ptr<Capture> capture(new Capture);
+		capture->mode = found->second->mode;
+		for (int i = 0; i < 2; ++i) {
+			if (capture->mode == OutputMode::Log) {
+				std::filesystem::path path(found->second->streams[i].path);
+				path.replace_extension(native_string(RM_TEXT(".copy")) + LOG_EXTENSIONS[i]);
+				capture->streams[i].path = path.native();
+			}
+		}
+		captures[copy] = std::move(capture);
+	}
+
+	// Method: OutputCapture::Restart
+	// Input: process that finished and will run again, number of the attempt that finished
+	// Purpose: Gives the process fresh streams, logs of the finished attempt are renamed
+	//			to <name>.attempt<n>.out and .err and its tail is dropped
+	void OutputCapture::Restart(pointer_type proc, size_type attempt) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+		std::unique_ptr<Capture> capture(new Capture);
+		capture->mode = found->second->mode;
+		for (int i = 0; i < 2; ++i) {
+			capture->streams[i].path = found->second->streams[i].path;
+			if (capture->mode == OutputMode::Log) {
+				std::filesystem::path path(capture->streams[i].path);
+				std::filesystem::path kept = path;
+				kept.replace_extension(native_string(ToNative(".attempt" + std::to_string(attempt))) + LOG_EXTENSIONS[i]);
+				std::error_code error;
+				std::filesystem::rename(path, kept, error);
+			}
+		}
+
+		// The I/O thread may still be draining the finished attempt
+		retired.push_back(std::move(found->second));
+		found->second = std::move(capture);
+	}
+
+	// Method: OutputCapture::Swap
+	// Input: two registered or unregistered processes
+	// Purpose: Exchanges their captured output, so a process can take the output of a copy that replaced it
+	//			Streams stay where they are, so the I/O thread may still be draining them
+	void OutputCapture::Swap(pointer_type lhs, pointer_type rhs) {
+		std::unique_ptr<Capture> left, right;
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(lhs);
+		if (found != captures.end()) {
+			left = std::move(found->second);
+			captures.erase(found);
+		}
+		found = captures.find(rhs);
+		if (found != captures.end()) {
+			right = std::move(found->second);
+			captures.erase(found);
+		}
+		if (left != nullptr) {
+			captures[rhs] = std::move(left);
+		}
+		if (right != nullptr) {
+			captures[lhs] = std::move(right);
+		}
+	}
+
+	// Method: OutputCapture::PrepareDirectory
+	// Output: Whether the log directory exists, it is created on first use
+	bool OutputCapture::PrepareDirectory() {
+		if (directoryReady || directory.empty()) {
+			return true;
+		}
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(directory), error);
+		if (error) {
+			std::wcerr << L"Error: Log directory " << ToWide(directory) << L" could not be created." << std::endl;
+			return false;
+		}
+		directoryReady = true;
+		return true;
+	}
+
+	// Method: OutputCapture::PrintTail
+	// Input: output stream, process whose output to print
+	// Purpose: Prints the last output of a captured process, if it wrote any
+	void OutputCapture::PrintTail(std::wostream& outstream, pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			Stream& stream = found->second->streams[i];
+			size_type dropped;
+			std::string text;
+			if (found->second->mode == OutputMode::Log) {
+				text = ReadTail(stream.path, tailSize, dropped);
+			}
+			else {
+				text = stream.tail.Contents();
+				dropped = stream.tail.Dropped();
+			}
+			if (text.empty()) {
+				continue;
+			}
+
+			outstream << L"    " << STREAM_NAMES[i];
+			if (dropped > 0) {
+				outstream << L", last " << text.size() << L" bytes";
+			}
+			if (!stream.path.empty()) {
+				outstream << L" (" << ToWide(stream.path) << L")";
+			}
+			outstream << L":" << std::endl << FromUtf8(text);
+			if (text.back() != '\n') {
+				outstream << std::endl;
+			}
+		}
+	}
+
+	// Method: OutputCapture::GetMode
+	// Input: process
+	// Output: How the output of the process is captured, OutputMode::Console if it is not
+	OutputMode OutputCapture::GetMode(pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		return found == captures.end() ? OutputMode::Console : found->second->mode;
+	}
+
+	// Method: OutputCapture::Save
+	// Input: finished process, directory to write its stdout and stderr files to
+	// Output: false if the process was captured but its output could not be saved
+	bool OutputCapture::Save(pointer_type proc, native_string const& target) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return true;
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			Stream& stream = found->second->streams[i];
+			std::filesystem::path saved = std::filesystem::path(target) / SAVED_NAMES[i];
+			if (found->second->mode == OutputMode::Log) {
+				// Logs are kept whole
+				std::error_code error;
+				std::filesystem::copy_file(std::filesystem::path(stream.path), saved, std::filesystem::copy_options::overwrite_existing, error);
+				if (error) {
+					return false;
+				}
+			}
+			else {
+				std::ofstream file(saved, std::ios::binary | std::ios::trunc);
+				std::string text = stream.tail.Contents();
+				file.write(text.data(), text.size());
+				if (!file) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Method: OutputCapture::Restore
+	// Input: process that will not be started, directory written by Save
+	// Purpose: Replays saved output into the tail or log files of a registered process
+	void OutputCapture::Restore(pointer_type proc, native_string const& source) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			Stream& stream = found->second->streams[i];
+			std::filesystem::path saved = std::filesystem::path(source) / SAVED_NAMES[i];
+			if (found->second->mode == OutputMode::Log) {
+				std::error_code error;
+				if (PrepareDirectory()) {
+					std::filesystem::copy_file(saved, std::filesystem::path(stream.path), std::filesystem::copy_options::overwrite_existing, error);
+				}
+				if (error) {
+					std::wcerr << L"Error: Log file " << ToWide(stream.path) << L" could not be restored." << std::endl;
+				}
+			}
+			else {
+				size_type dropped;
+				std::string text = ReadTail(saved.native(), tailSize, dropped);
+				stream.tail.Write(text.data(), text.size(), tailSize);
+			}
+		}
+	}
+/// End OutputCapture::Operations
+}
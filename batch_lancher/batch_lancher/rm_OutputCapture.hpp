@@ -0,0 +1,207 @@
+/*
+File: rm_OutputCapture.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Captures the stdout and stderr of processes
+		Log files are handed to the child directly, tails are read from pipes
+		by a single I/O thread so no child blocks on a full pipe
+		Linux uses epoll, Windows uses overlapped named pipes and an I/O completion port
+*/
+#ifndef RM_OUTPUTCAPTURE_HEADER_GUARD
+#define RM_OUTPUTCAPTURE_HEADER_GUARD
+#include "rm_Process.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <vector>
+#include <ostream>
+
+namespace rm {
+	class OutputCapture {
+	public:		/// Types
+		using size_type = size_t;
+		using pointer_type = Process*;
+		using file_handle = Process::file_handle;
+
+		// Bytes kept from each stream unless set otherwise
+		static const size_type DEFAULT_TAIL = 64 * 1024;
+	private:
+		// Keeps the last bytes written to it, memory is only allocated once output arrives
+		class RingBuffer {
+		private:
+			std::unique_ptr<char[]> data;
+			size_type capacity = 0;
+			// Total bytes ever written
+			size_type written = 0;
+		public:
+			// Method: RingBuffer::Write
+			// Input: bytes to append, capacity to allocate on first use
+			void Write(char const* bytes, size_type count, size_type size);
+
+			// Method: RingBuffer::Contents
+			// Output: The last bytes written, oldest first
+			std::string Contents();
+
+			// Method: RingBuffer::Dropped
+			// Output: Bytes that were overwritten
+			inline size_type Dropped() {
+				return written > capacity ? written - capacity : 0;
+			}
+		};
+
+		// One captured stream of a process
+		struct Stream {
+			RingBuffer tail;
+			// Log file, empty when the stream is kept in memory
+			native_string path;
+#ifdef _WIN32
+			HANDLE read = NULL;
+			OVERLAPPED overlapped = {};
+			char buffer[4096];
+#else
+			int read = -1;
+#endif
+		};
+
+		// Captured output of one process
+		struct Capture {
+			OutputMode mode;
+			// stdout then stderr
+			Stream streams[2];
+			// Ends given to the child, closed once it has started
+			file_handle child[2];
+		};
+	private:	/// Variables
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>> captures;
+		// Captures of earlier attempts of retried processes, kept until their streams are drained
+		std::vector<std::unique_ptr<Capture>> retired;
+		size_type tailSize;
+		native_string directory;
+		bool directoryReady;
+		// Drains every pipe
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable drained;
+		// Streams that have not reached end of file
+		size_type open;
+#ifdef _WIN32
+		HANDLE port;
+		// Makes pipe names unique within the launcher
+		unsigned long pipes;
+#else
+		int poller;
+		// Written to wake the I/O thread
+		int wake[2];
+#ifndef __linux__
+		// Streams polled by the I/O thread, guarded by mutex
+		std::vector<Stream*> polled;
+#endif
+#endif
+	public:		/// Methods
+		/// Constructors
+		OutputCapture();
+
+		~OutputCapture();
+
+		OutputCapture(OutputCapture const&) = delete;
+		OutputCapture& operator=(OutputCapture const&) = delete;
+
+		/// Operations
+		// Method: OutputCapture::SetTailSize
+		// Input: Bytes kept from each stream in memory, and printed from the end of log files
+		inline void SetTailSize(size_type bytes) {
+			tailSize = bytes;
+		}
+
+		// Method: OutputCapture::SetDirectory
+		// Input: Directory log files are written to, created when the first log is opened
+		inline void SetDirectory(native_string_view path) {
+			directory = native_string(path);
+			directoryReady = false;
+		}
+
+		// Method: OutputCapture::Register
+		// Input: process to capture, OutputMode::Tail or OutputMode::Log, name of its log files
+		// Purpose: Marks the output of a process to be captured when it starts
+		void Register(pointer_type proc, OutputMode mode, native_string_view name);
+
+		// Method: OutputCapture::RegisterCopy
+		// Input: copy of a process about to start, the registered original
+		// Purpose: Captures the copy the same way as the original, logs get ".copy" before their extension
+		void RegisterCopy(pointer_type copy, pointer_type original);
+
+		// Method: OutputCapture::Restart
+		// Input: process that finished and will run again, number of the attempt that finished
+		// Purpose: Gives the process fresh streams, logs of the finished attempt are renamed
+		//			to <name>.attempt<n>.out and .err and its tail is dropped
+		void Restart(pointer_type proc, size_type attempt);
+
+		// Method: OutputCapture::Swap
+		// Input: two registered or unregistered processes
+		// Purpose: Exchanges their captured output, so a process can take the output of a copy that replaced it
+		void Swap(pointer_type lhs, pointer_type rhs);
+
+		// Method: OutputCapture::Empty
+		// Output: Whether no process is captured
+		inline bool Empty() {
+			return captures.empty();
+		}
+
+		// Method: OutputCapture::Prepare
+		// Input: process about to start
+		// Purpose: Opens the log files or pipes of a registered process and hands them to it
+		void Prepare(pointer_type proc);
+
+		// Method: OutputCapture::Attach
+		// Input: process that was just started
+		// Purpose: Closes the child's ends and starts draining its pipes
+		void Attach(pointer_type proc);
+
+		// Method: OutputCapture::Finish
+		// Purpose: Waits until every pipe has been drained and stops the I/O thread
+		void Finish();
+
+		// Method: OutputCapture::PrintTail
+		// Input: output stream, process whose output to print
+		// Purpose: Prints the last output of a captured process, if it wrote any
+		void PrintTail(std::wostream& outstream, pointer_type proc);
+
+		// Method: OutputCapture::GetMode
+		// Input: process
+		// Output: How the output of the process is captured, OutputMode::Console if it is not
+		OutputMode GetMode(pointer_type proc);
+
+		// Method: OutputCapture::Save
+		// Input: finished process, directory to write its stdout and stderr files to
+		// Output: false if the process was captured but its output could not be saved
+		bool Save(pointer_type proc, native_string const& target);
+
+		// Method: OutputCapture::Restore
+		// Input: process that will not be started, directory written by Save
+		// Purpose: Replays saved output into the tail or log files of a registered process
+		void Restore(pointer_type proc, native_string const& source);
+	private:
+		// Method: OutputCapture::PrepareDirectory
+		// Output: Whether the log directory exists, it is created on first use
+		bool PrepareDirectory();
+
+		// Method: OutputCapture::OpenLog
+		// Input: log file path
+		// Output: Handle the child can write to, or an unset handle
+		file_handle OpenLog(native_string const& path);
+
+		// Method: OutputCapture::Drain
+		// Purpose: Body of the I/O thread, reads every pipe until it closes
+		void Drain();
+
+		// Method: OutputCapture::Closed
+		// Purpose: Releases a stream that reached end of file and wakes Finish
+		void Closed(Stream& stream);
+	};
+}
+
+#endif
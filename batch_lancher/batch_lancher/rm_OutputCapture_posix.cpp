@@ -0,0 +1,320 @@
+/*
+File: rm_OutputCapture_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::OutputCapture
+		Pipes are non-blocking and drained by one thread, Linux waits on every
+		pipe with epoll, other systems poll
+*/
+#ifndef _WIN32
+#include "rm_OutputCapture.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+namespace rm {
+	namespace {
+		// Bytes read from a pipe at a time
+		const size_t READ_SIZE = 64 * 1024;
+		// Reads from one pipe before others get a turn
+		const int READS_PER_WAKE = 4;
+
+		// Method: CloseFile
+		// Purpose: Closes a descriptor if it is open
+		void CloseFile(int& fd) {
+			if (fd != -1) {
+				close(fd);
+				fd = -1;
+			}
+		}
+
+		// Method: OpenPipe
+		// Output: Whether the pipe was created
+		// Purpose: Creates a pipe closed on exec, Linux sets the flag as the pipe is made so a child
+		//			spawned by another thread in between can not inherit either end
+		bool OpenPipe(int fds[2]) {
+#ifdef __linux__
+			return pipe2(fds, O_CLOEXEC) == 0;
+#else
+			if (pipe(fds) != 0) {
+				return false;
+			}
+			fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+			fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+			return true;
+#endif
+		}
+	}
+
+/// Begin OutputCapture::Constructors
+	OutputCapture::OutputCapture()
+		: tailSize(DEFAULT_TAIL), directoryReady(false), open(0), poller(-1), wake{ -1, -1 } {
+
+	}
+
+	OutputCapture::~OutputCapture() {
+		// Output still in flight is abandoned
+		if (thread.joinable()) {
+			char stop = 0;
+			(void)!write(wake[1], &stop, 1);
+			thread.join();
+		}
+		for (std::unordered_map<pointer_type, std::unique_ptr<Capture>>::value_type& capture : captures) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.second->streams[i].read);
+			}
+		}
+		for (std::unique_ptr<Capture>& capture : retired) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture->streams[i].read);
+			}
+		}
+		CloseFile(wake[0]);
+		CloseFile(wake[1]);
+		CloseFile(poller);
+	}
+/// End OutputCapture::Constructors
+
+/// Begin OutputCapture::Operations
+	// Method: OutputCapture::OpenLog
+	// Input: log file path
+	// Output: Handle the child can write to, or an unset handle
+	OutputCapture::file_handle OutputCapture::OpenLog(native_string const& path) {
+		int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd == -1) {
+			std::wcerr << L"Error: Log file " << ToWide(path) << L" could not be opened." << std::endl;
+		}
+		return fd;
+	}
+
+	// Method: OutputCapture::Prepare
+	// Input: process about to start
+	// Purpose: Opens the log files or pipes of a registered process and hands them to it
+	void OutputCapture::Prepare(pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+		Capture& capture = *found->second;
+		capture.child[0] = capture.child[1] = -1;
+
+		bool ready = true;
+		if (capture.mode == OutputMode::Log) {
+			// The child writes straight to its logs, nothing passes through the launcher
+			ready = PrepareDirectory();
+			for (int i = 0; ready && i < 2; ++i) {
+				capture.child[i] = OpenLog(capture.streams[i].path);
+				ready = capture.child[i] != -1;
+			}
+		}
+		else {
+			for (int i = 0; ready && i < 2; ++i) {
+				int fds[2];
+				ready = OpenPipe(fds);
+				if (ready) {
+					// Only the launcher's end is non-blocking, children see an ordinary pipe
+					fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+					capture.streams[i].read = fds[0];
+					capture.child[i] = fds[1];
+				}
+			}
+			if (!ready) {
+				std::wcerr << L"Error: Could not create pipes to capture output, it is not captured." << std::endl;
+			}
+		}
+
+		if (!ready) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.child[i]);
+				CloseFile(capture.streams[i].read);
+			}
+			return;
+		}
+		proc->SetOutputHandles(capture.child[0], capture.child[1]);
+	}
+
+	// Method: OutputCapture::Attach
+	// Input: process that was just started
+	// Purpose: Closes the child's ends and starts draining its pipes
+	void OutputCapture::Attach(pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+		Capture& capture = *found->second;
+		proc->SetOutputHandles(-1, -1);
+
+		// Without the launcher's copies, end of file arrives once the child exits
+		for (int i = 0; i < 2; ++i) {
+			CloseFile(capture.child[i]);
+		}
+		if (capture.mode != OutputMode::Tail || capture.streams[0].read == -1) {
+			return;
+		}
+		if (!proc->DidRun()) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.streams[i].read);
+			}
+			return;
+		}
+
+		// Start the I/O thread on first use
+		if (!thread.joinable()) {
+			if (!OpenPipe(wake)) {
+				wake[0] = wake[1] = -1;
+			}
+#ifdef __linux__
+			poller = epoll_create1(EPOLL_CLOEXEC);
+			epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.ptr = nullptr;
+			epoll_ctl(poller, EPOLL_CTL_ADD, wake[0], &event);
+#endif
+			thread = std::thread(&OutputCapture::Drain, this);
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int i = 0; i < 2; ++i) {
+			Stream& stream = capture.streams[i];
+#ifdef __linux__
+			epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.ptr = &stream;
+			if (epoll_ctl(poller, EPOLL_CTL_ADD, stream.read, &event) != 0) {
+				CloseFile(stream.read);
+				continue;
+			}
+#else
+			polled.push_back(&stream);
+#endif
+			++open;
+		}
+#ifndef __linux__
+		// The poll list has changed
+		char change = 1;
+		(void)!write(wake[1], &change, 1);
+#endif
+	}
+
+	// Method: OutputCapture::Finish
+	// Purpose: Waits until every pipe has been drained and stops the I/O thread
+	void OutputCapture::Finish() {
+		if (!thread.joinable()) {
+			return;
+		}
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			drained.wait(lock, [this]() {
+				return open == 0;
+			});
+		}
+		char stop = 0;
+		(void)!write(wake[1], &stop, 1);
+		thread.join();
+	}
+
+	// Method: OutputCapture::Closed
+	// Purpose: Releases a stream that reached end of file and wakes Finish
+	void OutputCapture::Closed(Stream& stream) {
+#ifdef __linux__
+		// Closing is not enough, a child being spawned may briefly share the pipe
+		// and epoll would keep reporting a descriptor that is no longer open
+		epoll_ctl(poller, EPOLL_CTL_DEL, stream.read, nullptr);
+#endif
+		CloseFile(stream.read);
+		std::lock_guard<std::mutex> lock(mutex);
+#ifndef __linux__
+		polled.erase(std::find(polled.begin(), polled.end(), &stream));
+#endif
+		if (--open == 0) {
+			drained.notify_all();
+		}
+	}
+
+	// Method: OutputCapture::Drain
+	// Purpose: Body of the I/O thread, reads every pipe until it closes
+	void OutputCapture::Drain() {
+		std::unique_ptr<char[]> buffer(new char[READ_SIZE]);
+
+		// Reads what is available from one pipe, returns whether it is still open
+		auto readStream = [&](Stream& stream) {
+			for (int reads = 0; reads < READS_PER_WAKE; ++reads) {
+				ssize_t count = read(stream.read, buffer.get(), READ_SIZE);
+				if (count > 0) {
+					stream.tail.Write(buffer.get(), static_cast<size_type>(count), tailSize);
+					continue;
+				}
+				if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+					return true;
+				}
+				Closed(stream);
+				return false;
+			}
+			return true;
+		};
+
+#ifdef __linux__
+		epoll_event events[64];
+		while (true) {
+			int ready = epoll_wait(poller, events, 64, -1);
+			if (ready == -1) {
+				if (errno == EINTR) {
+					continue;
+				}
+				std::wcerr << L"Error: Waiting for process output failed." << std::endl;
+				return;
+			}
+			for (int i = 0; i < ready; ++i) {
+				if (events[i].data.ptr == nullptr) {
+					// Woken to stop
+					return;
+				}
+				readStream(*static_cast<Stream*>(events[i].data.ptr));
+			}
+		}
+#else
+		std::vector<pollfd> fds;
+		std::vector<Stream*> streams;
+		while (true) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				streams = polled;
+			}
+			fds.assign(1, pollfd{ wake[0], POLLIN, 0 });
+			for (Stream* stream : streams) {
+				fds.push_back(pollfd{ stream->read, POLLIN, 0 });
+			}
+
+			if (poll(fds.data(), fds.size(), -1) == -1) {
+				if (errno == EINTR) {
+					continue;
+				}
+				std::wcerr << L"Error: Waiting for process output failed." << std::endl;
+				return;
+			}
+			if (fds[0].revents != 0) {
+				char reason = 0;
+				if (read(wake[0], &reason, 1) == 1 && reason == 0) {
+					return;
+				}
+			}
+			for (size_t i = 1; i < fds.size(); ++i) {
+				if (fds[i].revents != 0) {
+					readStream(*streams[i - 1]);
+				}
+			}
+		}
+#endif
+	}
+/// End OutputCapture::Operations
+}
+#endif
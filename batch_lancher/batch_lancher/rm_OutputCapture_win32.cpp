@@ -0,0 +1,230 @@
+/*
+File: rm_OutputCapture_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::OutputCapture
+		Anonymous pipes can not be read asynchronously, so each stream is an
+		overlapped named pipe whose reads complete on one I/O completion port
+*/
+#ifdef _WIN32
+#include "rm_OutputCapture.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <string>
+
+namespace rm {
+	namespace {
+		// Method: CloseFile
+		// Purpose: Closes a handle if it is open
+		void CloseFile(HANDLE& handle) {
+			if (handle != NULL && handle != INVALID_HANDLE_VALUE) {
+				CloseHandle(handle);
+			}
+			handle = NULL;
+		}
+	}
+
+/// Begin OutputCapture::Constructors
+	OutputCapture::OutputCapture()
+		: tailSize(DEFAULT_TAIL), directoryReady(false), open(0), port(NULL), pipes(0) {
+
+	}
+
+	OutputCapture::~OutputCapture() {
+		// Output still in flight is abandoned
+		if (thread.joinable()) {
+			PostQueuedCompletionStatus(port, 0, 0, NULL);
+			thread.join();
+		}
+		for (std::unordered_map<pointer_type, std::unique_ptr<Capture>>::value_type& capture : captures) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.second->streams[i].read);
+			}
+		}
+		for (std::unique_ptr<Capture>& capture : retired) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture->streams[i].read);
+			}
+		}
+		CloseFile(port);
+	}
+/// End OutputCapture::Constructors
+
+/// Begin OutputCapture::Operations
+	// Method: OutputCapture::OpenLog
+	// Input: log file path
+	// Output: Handle the child can write to, or an unset handle
+	OutputCapture::file_handle OutputCapture::OpenLog(native_string const& path) {
+		SECURITY_ATTRIBUTES inherit = { sizeof(inherit), NULL, TRUE };
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &inherit, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) {
+			std::wcerr << L"Error: Log file " << path << L" could not be opened." << std::endl;
+			return NULL;
+		}
+		return file;
+	}
+
+	// Method: OutputCapture::Prepare
+	// Input: process about to start
+	// Purpose: Opens the log files or pipes of a registered process and hands them to it
+	void OutputCapture::Prepare(pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+		Capture& capture = *found->second;
+		capture.child[0] = capture.child[1] = NULL;
+
+		bool ready = true;
+		if (capture.mode == OutputMode::Log) {
+			// The child writes straight to its logs, nothing passes through the launcher
+			ready = PrepareDirectory();
+			for (int i = 0; ready && i < 2; ++i) {
+				capture.child[i] = OpenLog(capture.streams[i].path);
+				ready = capture.child[i] != NULL;
+			}
+		}
+		else {
+			SECURITY_ATTRIBUTES inherit = { sizeof(inherit), NULL, TRUE };
+			for (int i = 0; ready && i < 2; ++i) {
+				std::wstring name = L"\\\\.\\pipe\\rm_batch_launcher_" + std::to_wstring(GetCurrentProcessId()) + L"_" + std::to_wstring(pipes++);
+				HANDLE read = CreateNamedPipeW(name.c_str(), PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+					PIPE_TYPE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS, 1, 0, 64 * 1024, 0, NULL);
+				if (read == INVALID_HANDLE_VALUE) {
+					ready = false;
+					break;
+				}
+				capture.streams[i].read = read;
+
+				// Children see an ordinary synchronous handle
+				HANDLE write = CreateFileW(name.c_str(), GENERIC_WRITE, 0, &inherit, OPEN_EXISTING, 0, NULL);
+				if (write == INVALID_HANDLE_VALUE) {
+					ready = false;
+					break;
+				}
+				capture.child[i] = write;
+			}
+			if (!ready) {
+				std::wcerr << L"Error: Could not create pipes to capture output, it is not captured." << std::endl;
+			}
+		}
+
+		if (!ready) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.child[i]);
+				CloseFile(capture.streams[i].read);
+			}
+			return;
+		}
+		proc->SetOutputHandles(capture.child[0], capture.child[1]);
+	}
+
+	// Method: OutputCapture::Attach
+	// Input: process that was just started
+	// Purpose: Closes the child's ends and starts draining its pipes
+	void OutputCapture::Attach(pointer_type proc) {
+		std::unordered_map<pointer_type, std::unique_ptr<Capture>>::iterator found = captures.find(proc);
+		if (found == captures.end()) {
+			return;
+		}
+		Capture& capture = *found->second;
+		proc->SetOutputHandles(NULL, NULL);
+
+		// Without the launcher's copies, the pipe breaks once the child exits
+		for (int i = 0; i < 2; ++i) {
+			CloseFile(capture.child[i]);
+		}
+		if (capture.mode != OutputMode::Tail || capture.streams[0].read == NULL) {
+			return;
+		}
+		if (!proc->DidRun()) {
+			for (int i = 0; i < 2; ++i) {
+				CloseFile(capture.streams[i].read);
+			}
+			return;
+		}
+
+		// Start the I/O thread on first use
+		if (!thread.joinable()) {
+			port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+			thread = std::thread(&OutputCapture::Drain, this);
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			Stream& stream = capture.streams[i];
+			if (CreateIoCompletionPort(stream.read, port, reinterpret_cast<ULONG_PTR>(&stream), 0) == NULL) {
+				CloseFile(stream.read);
+				continue;
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				++open;
+			}
+
+			// Every read completes on the port, even when it finishes immediately
+			stream.overlapped = {};
+			if (!ReadFile(stream.read, stream.buffer, sizeof(stream.buffer), NULL, &stream.overlapped)
+				&& GetLastError() != ERROR_IO_PENDING) {
+				Closed(stream);
+			}
+		}
+	}
+
+	// Method: OutputCapture::Finish
+	// Purpose: Waits until every pipe has been drained and stops the I/O thread
+	void OutputCapture::Finish() {
+		if (!thread.joinable()) {
+			return;
+		}
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			drained.wait(lock, [this]() {
+				return open == 0;
+			});
+		}
+		PostQueuedCompletionStatus(port, 0, 0, NULL);
+		thread.join();
+	}
+
+	// Method: OutputCapture::Closed
+	// Purpose: Releases a stream that reached end of file and wakes Finish
+	void OutputCapture::Closed(Stream& stream) {
+		CloseFile(stream.read);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--open == 0) {
+			drained.notify_all();
+		}
+	}
+
+	// Method: OutputCapture::Drain
+	// Purpose: Body of the I/O thread, reads every pipe until it closes
+	void OutputCapture::Drain() {
+		while (true) {
+			DWORD count = 0;
+			ULONG_PTR key = 0;
+			LPOVERLAPPED overlapped = NULL;
+			BOOL completed = GetQueuedCompletionStatus(port, &count, &key, &overlapped, INFINITE);
+			if (overlapped == NULL) {
+				// Woken to stop, or the port itself failed
+				return;
+			}
+
+			Stream& stream = *reinterpret_cast<Stream*>(key);
+			if (!completed) {
+				// ERROR_BROKEN_PIPE once the child and its children have exited
+				Closed(stream);
+				continue;
+			}
+			stream.tail.Write(stream.buffer, count, tailSize);
+
+			stream.overlapped = {};
+			if (!ReadFile(stream.read, stream.buffer, sizeof(stream.buffer), NULL, &stream.overlapped)
+				&& GetLastError() != ERROR_IO_PENDING) {
+				Closed(stream);
+			}
+		}
+	}
+/// End OutputCapture::Operations
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+File: rm_Pipeline.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Connects the stdout of jobs to the stdin of others
+		Creating pipes and relaying them is in rm_Pipeline_posix.cpp and rm_Pipeline_win32.cpp
+*/
+#include "rm_Pipeline.hpp"
+#include <algorithm>
+
+namespace rm {
+	namespace {
+		// Handle of a stream the child keeps from the launcher
+#ifdef _WIN32
+		const Pipelines::file_handle NO_HANDLE = NULL;
+#else
+		const Pipelines::file_handle NO_HANDLE = -1;
+#endif
+	}
+
+/// Begin Pipelines::Constructors
+	Pipelines::Pipelines()
+		: pipes(0), relayed(0), empty(NO_HANDLE) {
+
+	}
+
+	Pipelines::~Pipelines() {
+		Close();
+		Finish();
+		CloseEnd(empty);
+	}
+/// End Pipelines::Constructors
+
+/// Begin Pipelines::Operations
+	// Method: Pipelines::Open
+	// Input: connections between the stages of one pipeline
+	// Output: Whether every pipe was created, no stage is given any if not
+	// Purpose: Hands each stage its pipe ends, they take effect when it starts
+	bool Pipelines::Open(std::vector<connection_type> const& connections) {
+		// Relays whose producers have finished are joined, so threads do not pile up over a long batch
+		relays.erase(std::remove_if(relays.begin(), relays.end(), [](std::unique_ptr<Relay>& relay) {
+			if (!relay->done.load()) {
+				return false;
+			}
+			relay->thread.join();
+			return true;
+		}), relays.end());
+
+		// Stages in the order they were connected, with the consumers of each
+		std::vector<pointer_type> stages;
+		std::vector<std::vector<size_type>> readers;
+		std::vector<bool> consumer;
+		auto stage = [&](pointer_type proc) {
+			size_type index = static_cast<size_type>(std::find(stages.begin(), stages.end(), proc) - stages.begin());
+			if (index == stages.size()) {
+				stages.push_back(proc);
+				readers.emplace_back();
+				consumer.push_back(false);
+			}
+			return index;
+		};
+		for (connection_type const& connection : connections) {
+			size_type producer = stage(connection.first);
+			size_type reader = stage(connection.second);
+			consumer[reader] = true;
+			if (std::find(readers[producer].begin(), readers[producer].end(), reader) == readers[producer].end()) {
+				readers[producer].push_back(reader);
+			}
+		}
+
+		// Every consumer reads one pipe, shared by its producers
+		std::vector<file_handle> input(stages.size(), NO_HANDLE);
+		std::vector<file_handle> inputWrite(stages.size(), NO_HANDLE);
+		std::vector<file_handle> output(stages.size(), NO_HANDLE);
+		std::vector<std::unique_ptr<Relay>> opened;
+		bool created = true;
+		for (size_type index = 0; index < stages.size() && created; ++index) {
+			if (consumer[index]) {
+				created = CreatePipe(input[index], inputWrite[index]);
+				if (created) {
+					held.push_back(input[index]);
+					held.push_back(inputWrite[index]);
+					++pipes;
+				}
+			}
+		}
+
+		// A producer with one consumer writes into its pipe, one with several is relayed to each of theirs
+		for (size_type index = 0; index < stages.size() && created; ++index) {
+			if (readers[index].size() == 1) {
+				output[index] = inputWrite[readers[index].front()];
+				continue;
+			}
+			if (readers[index].empty()) {
+				continue;
+			}
+			std::unique_ptr<Relay> relay(new Relay());
+			created = CreatePipe(relay->source, output[index]);
+			if (!created) {
+				break;
+			}
+			held.push_back(output[index]);
+			++pipes;
+			for (size_type reader : readers[index]) {
+				file_handle target = Duplicate(inputWrite[reader]);
+				if (target == NO_HANDLE) {
+					created = false;
+					break;
+				}
+				relay->targets.push_back(target);
+			}
+			opened.push_back(std::move(relay));
+		}
+
+		if (!created) {
+			for (std::unique_ptr<Relay>& relay : opened) {
+				CloseEnd(relay->source);
+				for (file_handle target : relay->targets) {
+					CloseEnd(target);
+				}
+			}
+			Close();
+			return false;
+		}
+
+		for (size_type index = 0; index < stages.size(); ++index) {
+			stages[index]->SetPipeHandles(input[index], output[index]);
+		}
+		wired = std::move(stages);
+		for (std::unique_ptr<Relay>& relay : opened) {
+			Relay* forwarded = relay.get();
+			relay->thread = std::thread([this, forwarded]() {
+				Forward(*forwarded);
+			});
+			relays.push_back(std::move(relay));
+		}
+		return true;
+	}
+
+	// Method: Pipelines::Disconnect
+	// Input: consumer whose pipe sources were all rejected
+	// Output: Whether it was given an empty stdin
+	// Purpose: Keeps the consumer off the launcher's own stdin, it sees the end of its input at once
+	bool Pipelines::Disconnect(pointer_type proc) {
+		if (empty == NO_HANDLE) {
+			empty = OpenEmpty();
+		}
+		if (empty == NO_HANDLE) {
+			return false;
+		}
+		proc->SetPipeHandles(empty, NO_HANDLE);
+		return true;
+	}
+
+	// Method: Pipelines::Close
+	// Purpose: Closes the launcher's ends once every stage of the opened pipeline has started or failed to,
+	//			so consumers see the end of their input when the last of their producers exits
+	void Pipelines::Close() {
+		for (file_handle handle : held) {
+			CloseEnd(handle);
+		}
+		held.clear();
+		for (pointer_type proc : wired) {
+			proc->SetPipeHandles(NO_HANDLE, NO_HANDLE);
+		}
+		wired.clear();
+	}
+
+	// Method: Pipelines::Finish
+	// Purpose: Waits for every relay to reach the end of its producer's output
+	void Pipelines::Finish() {
+		for (std::unique_ptr<Relay>& relay : relays) {
+			relay->thread.join();
+		}
+		relays.clear();
+	}
+/// End Pipelines::Operations
+}
@@ -0,0 +1,112 @@
+/*
+File: rm_Pipeline.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Connects the stdout of jobs to the stdin of others, so staged work streams between them
+		instead of passing through files
+		Producers read by one consumer write straight into its pipe, so several producers share it
+		A producer read by several consumers writes to a pipe of its own that a relay thread duplicates
+		into each of theirs, on Linux with tee and splice so the data never enters the launcher's memory
+*/
+#ifndef RM_PIPELINE_HEADER_GUARD
+#define RM_PIPELINE_HEADER_GUARD
+#include "rm_Process.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rm {
+	class Pipelines {
+	public:		/// Types
+		using size_type = size_t;
+		using pointer_type = Process*;
+		using file_handle = Process::file_handle;
+		// Producer whose stdout is read by the consumer
+		using connection_type = std::pair<pointer_type, pointer_type>;
+	private:
+		// Duplicates the pipe of a producer into the pipes of its consumers
+		struct Relay {
+			file_handle source;
+			std::vector<file_handle> targets;
+			std::thread thread;
+			std::atomic<bool> done{ false };
+		};
+	private:	/// Variables
+		// Ends given to the stages of the pipeline being started, closed once they have all started
+		std::vector<file_handle> held;
+		std::vector<pointer_type> wired;
+		std::vector<std::unique_ptr<Relay>> relays;
+		// Pipes created, and bytes duplicated to more than one consumer
+		size_type pipes;
+		std::atomic<unsigned long long> relayed;
+		// Null device read by consumers whose sources were all dropped, opened on first use
+		file_handle empty;
+	public:		/// Methods
+		/// Constructors
+		Pipelines();
+
+		~Pipelines();
+
+		Pipelines(Pipelines const&) = delete;
+		Pipelines& operator=(Pipelines const&) = delete;
+
+		/// Operations
+		// Method: Pipelines::Open
+		// Input: connections between the stages of one pipeline
+		// Output: Whether every pipe was created, no stage is given any if not
+		// Purpose: Hands each stage its pipe ends, they take effect when it starts
+		bool Open(std::vector<connection_type> const& connections);
+
+		// Method: Pipelines::Disconnect
+		// Input: consumer whose pipe sources were all rejected
+		// Output: Whether it was given an empty stdin
+		// Purpose: Keeps the consumer off the launcher's own stdin, it sees the end of its input at once
+		bool Disconnect(pointer_type proc);
+
+		// Method: Pipelines::Close
+		// Purpose: Closes the launcher's ends once every stage of the opened pipeline has started or failed to,
+		//			so consumers see the end of their input when the last of their producers exits
+		void Close();
+
+		// Method: Pipelines::Finish
+		// Purpose: Waits for every relay to reach the end of its producer's output
+		void Finish();
+
+		// Method: Pipelines::GetPipeCount
+		// Output: Pipes created so far
+		inline size_type GetPipeCount() {
+			return pipes;
+		}
+
+		// Method: Pipelines::GetRelayedBytes
+		// Output: Bytes written by producers with several consumers
+		inline unsigned long long GetRelayedBytes() {
+			return relayed.load();
+		}
+	private:
+		// Method: Pipelines::CreatePipe
+		// Output: Whether the pipe was created, its ends are only inherited by processes they are handed to
+		static bool CreatePipe(file_handle& read, file_handle& write);
+
+		// Method: Pipelines::OpenEmpty
+		// Output: Read end of the null device, only inherited by processes it is handed to, unset if it could not be opened
+		static file_handle OpenEmpty();
+
+		// Method: Pipelines::Duplicate
+		// Output: Another handle to the same end, unset if it could not be duplicated
+		static file_handle Duplicate(file_handle handle);
+
+		// Method: Pipelines::CloseEnd
+		static void CloseEnd(file_handle handle);
+
+		// Method: Pipelines::Forward
+		// Purpose: Body of a relay thread, copies the source to every target until it ends
+		//			A target whose consumer has exited is dropped, the producer is only stopped once all are
+		void Forward(Relay& relay);
+	};
+}
+
+#endif
@@ -0,0 +1,250 @@
+/*
+File: rm_Pipeline_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX pipes and relays for rm::Pipelines
+		Linux duplicates the source pipe into each target with tee and moves it into the last with splice,
+		so relayed data stays in the kernel's pipe buffers, other systems copy through a buffer
+*/
+#ifndef _WIN32
+#include "rm_Pipeline.hpp"
+#include <cerrno>
+#include <csignal>
+#include <climits>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace rm {
+	namespace {
+		// Bytes relayed at a time
+		const size_t RELAY_SIZE = 64 * 1024;
+
+		// Method: WriteAll
+		// Output: Whether every byte was written, false once the reader has gone
+		bool WriteAll(int fd, char const* bytes, size_t count) {
+			while (count > 0) {
+				ssize_t written = write(fd, bytes, count);
+				if (written < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					return false;
+				}
+				bytes += written;
+				count -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+
+		// Method: ReadAll
+		// Output: Bytes read, fewer than asked for only at the end of the pipe
+		size_t ReadAll(int fd, char* bytes, size_t count) {
+			size_t total = 0;
+			while (total < count) {
+				ssize_t got = read(fd, bytes + total, count - total);
+				if (got < 0 && errno == EINTR) {
+					continue;
+				}
+				if (got <= 0) {
+					break;
+				}
+				total += static_cast<size_t>(got);
+			}
+			return total;
+		}
+	}
+
+/// Begin Pipelines::Operations
+	// Method: Pipelines::CreatePipe
+	// Output: Whether the pipe was created, its ends are only inherited by processes they are handed to
+	bool Pipelines::CreatePipe(file_handle& read, file_handle& write) {
+		// Spawning dup2s an end onto stdin or stdout, which clears the flag for that child alone
+		int fds[2];
+#ifdef __linux__
+		// The flag is set as the pipe is made, a child spawned by another thread can not inherit either end
+		if (pipe2(fds, O_CLOEXEC) != 0) {
+			return false;
+		}
+#else
+		if (pipe(fds) != 0) {
+			return false;
+		}
+		fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+		fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+		read = fds[0];
+		write = fds[1];
+		return true;
+	}
+
+	// Method: Pipelines::OpenEmpty
+	// Output: Read end of the null device, only inherited by processes it is handed to, unset if it could not be opened
+	Pipelines::file_handle Pipelines::OpenEmpty() {
+		return open("/dev/null", O_RDONLY | O_CLOEXEC);
+	}
+
+	// Method: Pipelines::Duplicate
+	// Output: Another handle to the same end, unset if it could not be duplicated
+	Pipelines::file_handle Pipelines::Duplicate(file_handle handle) {
+		return fcntl(handle, F_DUPFD_CLOEXEC, 0);
+	}
+
+	// Method: Pipelines::CloseEnd
+	void Pipelines::CloseEnd(file_handle handle) {
+		if (handle != -1) {
+			close(handle);
+		}
+	}
+
+	// Method: Pipelines::Forward
+	// Purpose: Body of a relay thread, copies the source to every target until it ends
+	//			A target whose consumer has exited is dropped, the producer is only stopped once all are
+	void Pipelines::Forward(Relay& relay) {
+		// Writing to a pipe nobody reads raises SIGPIPE in the writing thread, here it is only an error
+		sigset_t mask;
+		sigemptyset(&mask);
+		sigaddset(&mask, SIGPIPE);
+		pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+		std::vector<file_handle>& targets = relay.targets;
+		std::vector<char> buffer;
+		std::vector<size_t> copied;
+#ifdef __linux__
+		bool splicing = true;
+#endif
+		while (!targets.empty()) {
+			size_t chunk = 0;
+			size_t last = targets.size() - 1;
+			copied.assign(targets.size(), 0);
+#ifdef __linux__
+			if (splicing) {
+				// Every target but the last gets a duplicate of what the source holds, without consuming it
+				bool partial = false;
+				for (size_t index = 0; index < last; ++index) {
+					ssize_t teed;
+					do {
+						teed = tee(relay.source, targets[index], index == 0 ? RELAY_SIZE : chunk, 0);
+					} while (teed < 0 && errno == EINTR);
+					if (teed < 0 && errno == EINVAL) {
+						// The pipes do not support tee, they are copied instead
+						splicing = false;
+						break;
+					}
+					if (teed < 0) {
+						// The consumer has gone, it is dropped once this chunk is done
+						copied[index] = SIZE_MAX;
+						if (index == 0) {
+							break;
+						}
+						continue;
+					}
+					if (index == 0) {
+						chunk = static_cast<size_t>(teed);
+						if (chunk == 0) {
+							break;
+						}
+					}
+					copied[index] = static_cast<size_t>(teed);
+					partial = partial || copied[index] < chunk;
+				}
+				if (!splicing) {
+					continue;
+				}
+				if (copied[0] == SIZE_MAX) {
+					close(targets[0]);
+					targets.erase(targets.begin());
+					continue;
+				}
+				if (last > 0 && chunk == 0) {
+					// The producer has closed its end
+					break;
+				}
+
+				if (last > 0 && !partial) {
+					// The last target takes the chunk itself, which consumes it from the source
+					size_t moved = 0;
+					while (moved < chunk) {
+						ssize_t spliced = splice(relay.source, nullptr, targets[last], nullptr, chunk - moved, SPLICE_F_MOVE);
+						if (spliced < 0 && errno == EINTR) {
+							continue;
+						}
+						if (spliced <= 0) {
+							break;
+						}
+						moved += static_cast<size_t>(spliced);
+					}
+					if (moved < chunk) {
+						// The last consumer has gone, the rest of the chunk is discarded
+						copied[last] = SIZE_MAX;
+						buffer.resize(chunk - moved);
+						ReadAll(relay.source, buffer.data(), buffer.size());
+					}
+				}
+				else if (last == 0) {
+					// A single target left takes whatever the source holds
+					ssize_t spliced;
+					do {
+						spliced = splice(relay.source, nullptr, targets[0], nullptr, RELAY_SIZE, SPLICE_F_MOVE);
+					} while (spliced < 0 && errno == EINTR);
+					if (spliced == 0) {
+						break;
+					}
+					if (spliced < 0) {
+						copied[0] = SIZE_MAX;
+					}
+					chunk = spliced < 0 ? 0 : static_cast<size_t>(spliced);
+				}
+				else {
+					// A target took part of the chunk, tee cannot resume within it so the chunk is read out instead
+					buffer.resize(chunk);
+					chunk = ReadAll(relay.source, buffer.data(), chunk);
+					for (size_t index = 0; index <= last; ++index) {
+						if (copied[index] != SIZE_MAX && copied[index] < chunk
+							&& !WriteAll(targets[index], buffer.data() + copied[index], chunk - copied[index])) {
+							copied[index] = SIZE_MAX;
+						}
+					}
+				}
+			}
+			else
+#endif
+			{
+				buffer.resize(RELAY_SIZE);
+				ssize_t got;
+				do {
+					got = read(relay.source, buffer.data(), buffer.size());
+				} while (got < 0 && errno == EINTR);
+				if (got <= 0) {
+					break;
+				}
+				chunk = static_cast<size_t>(got);
+				for (size_t index = 0; index <= last; ++index) {
+					if (!WriteAll(targets[index], buffer.data(), chunk)) {
+						copied[index] = SIZE_MAX;
+					}
+				}
+			}
+			relayed += chunk;
+
+			// Consumers that have exited are dropped
+			for (size_t index = targets.size(); index-- > 0;) {
+				if (copied[index] == SIZE_MAX) {
+					close(targets[index]);
+					targets.erase(targets.begin() + static_cast<std::ptrdiff_t>(index));
+				}
+			}
+		}
+
+		// Closing the source stops the producer with SIGPIPE if every consumer has gone
+		for (file_handle target : targets) {
+			close(target);
+		}
+		targets.clear();
+		close(relay.source);
+		relay.done = true;
+	}
+/// End Pipelines::Operations
+}
+#endif
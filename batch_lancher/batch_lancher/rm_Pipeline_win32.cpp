@@ -0,0 +1,98 @@
+/*
+File: rm_Pipeline_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows pipes and relays for rm::Pipelines
+		Anonymous pipes have no equivalent of tee, relays copy through a buffer
+*/
+#ifdef _WIN32
+#include "rm_Pipeline.hpp"
+
+namespace rm {
+	namespace {
+		// Bytes relayed at a time
+		const DWORD RELAY_SIZE = 64 * 1024;
+
+		// Method: WriteAll
+		// Output: Whether every byte was written, false once the reader has gone
+		bool WriteAll(HANDLE handle, char const* bytes, DWORD count) {
+			while (count > 0) {
+				DWORD written = 0;
+				if (!WriteFile(handle, bytes, count, &written, NULL)) {
+					return false;
+				}
+				bytes += written;
+				count -= written;
+			}
+			return true;
+		}
+	}
+
+/// Begin Pipelines::Operations
+	// Method: Pipelines::CreatePipe
+	// Output: Whether the pipe was created, its ends are only inherited by processes they are handed to
+	// Reason: Children are started with an explicit list of the handles they inherit
+	bool Pipelines::CreatePipe(file_handle& read, file_handle& write) {
+		SECURITY_ATTRIBUTES inherit = { sizeof(inherit), NULL, TRUE };
+		return ::CreatePipe(&read, &write, &inherit, RELAY_SIZE) != FALSE;
+	}
+
+	// Method: Pipelines::OpenEmpty
+	// Output: Read end of the null device, only inherited by processes it is handed to, unset if it could not be opened
+	// Reason: Children are started with an explicit list of the handles they inherit
+	Pipelines::file_handle Pipelines::OpenEmpty() {
+		SECURITY_ATTRIBUTES inherit = { sizeof(inherit), NULL, TRUE };
+		HANDLE handle = CreateFileW(L"NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, &inherit, OPEN_EXISTING, 0, NULL);
+		return handle != INVALID_HANDLE_VALUE ? handle : NULL;
+	}
+
+	// Method: Pipelines::Duplicate
+	// Output: Another handle to the same end, unset if it could not be duplicated
+	Pipelines::file_handle Pipelines::Duplicate(file_handle handle) {
+		HANDLE duplicate = NULL;
+		if (!DuplicateHandle(GetCurrentProcess(), handle, GetCurrentProcess(), &duplicate, 0, FALSE, DUPLICATE_SAME_ACCESS)) {
+			return NULL;
+		}
+		return duplicate;
+	}
+
+	// Method: Pipelines::CloseEnd
+	void Pipelines::CloseEnd(file_handle handle) {
+		if (handle != NULL) {
+			::CloseHandle(handle);
+		}
+	}
+
+	// Method: Pipelines::Forward
+	// Purpose: Body of a relay thread, copies the source to every target until it ends
+	//			A target whose consumer has exited is dropped, the producer is only stopped once all are
+	void Pipelines::Forward(Relay& relay) {
+		std::vector<file_handle>& targets = relay.targets;
+		std::vector<char> buffer(RELAY_SIZE);
+		while (!targets.empty()) {
+			DWORD got = 0;
+			if (!ReadFile(relay.source, buffer.data(), RELAY_SIZE, &got, NULL) || got == 0) {
+				// ERROR_BROKEN_PIPE once every producer has closed its end
+				break;
+			}
+			for (size_t index = targets.size(); index-- > 0;) {
+				if (!WriteAll(targets[index], buffer.data(), got)) {
+					::CloseHandle(targets[index]);
+					targets.erase(targets.begin() + static_cast<std::ptrdiff_t>(index));
+				}
+			}
+			relayed += got;
+		}
+
+		// Closing the source stops the producer writing once every consumer has gone
+		for (file_handle target : targets) {
+			::CloseHandle(target);
+		}
+		targets.clear();
+		::CloseHandle(relay.source);
+		relay.done = true;
+	}
+/// End Pipelines::Operations
+}
+#endif
@@ -0,0 +1,239 @@
+/*
+File: rm_Placement.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Platform independent parts of rm::Placement and rm::CpuLayout
+		Reading the CPU topology lives in rm_Placement_posix.cpp and rm_Placement_win32.cpp
+*/
+#include "rm_Placement.hpp"
+#include <algorithm>
+#include <sstream>
+#include <filesystem>
+
+namespace rm {
+	namespace {
+		// Method: WriteCpuList
+		// Purpose: Writes sorted CPUs as ranges, e.g. 0-3;6
+		void WriteCpuList(std::wostream& outstream, Placement::cpu_list const& cpus) {
+			for (size_t i = 0; i < cpus.size();) {
+				size_t j = i;
+				while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+					++j;
+				}
+				outstream << (i == 0 ? L"" : L";") << cpus[i];
+				if (j > i) {
+					outstream << L"-" << cpus[j];
+				}
+				i = j + 1;
+			}
+		}
+	}
+
+/// Begin Placement::Operations
+	// Method: Placement::ParseCpuList
+	// Input: CPU list such as "0-3;6", ',' may also separate entries
+	// Output: Whether the list was valid and not empty, the sorted CPUs
+	bool Placement::ParseCpuList(std::string_view text, cpu_list& output) {
+		output.clear();
+		while (!text.empty()) {
+			size_t end = text.find_first_of(";,");
+			std::string_view entry = text.substr(0, end);
+			text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+			size_t dash = entry.find('-');
+			size_t first, last;
+			if (!ParseUnsigned(entry.substr(0, dash), first)) {
+				return false;
+			}
+			last = first;
+			if (dash != std::string_view::npos && !ParseUnsigned(entry.substr(dash + 1), last)) {
+				return false;
+			}
+			if (last < first || last > 4095) {
+				return false;
+			}
+			for (size_t cpu = first; cpu <= last; ++cpu) {
+				output.push_back(static_cast<unsigned int>(cpu));
+			}
+		}
+		std::sort(output.begin(), output.end());
+		output.erase(std::unique(output.begin(), output.end()), output.end());
+		return !output.empty();
+	}
+
+	// Method: Placement::Empty
+	// Output: Whether nothing is set, so the process runs like the launcher
+	bool Placement::Empty() const {
+		return cpus.empty() && numaNode < 0 && !hasNice && memoryMax == 0 && cpuMax == 0 && !automatic;
+	}
+
+	// Method: Placement::Merge
+	// Input: Settings of the launchgroup or launcher
+	// Purpose: Copies every setting this placement does not set itself
+	void Placement::Merge(Placement const& defaults) {
+		if (cpus.empty()) {
+			cpus = defaults.cpus;
+		}
+		if (numaNode < 0) {
+			numaNode = defaults.numaNode;
+		}
+		if (!hasNice) {
+			hasNice = defaults.hasNice;
+			nice = defaults.nice;
+		}
+		if (memoryMax == 0) {
+			memoryMax = defaults.memoryMax;
+		}
+		if (cpuMax == 0) {
+			cpuMax = defaults.cpuMax;
+		}
+		if (!hasAutomatic) {
+			hasAutomatic = defaults.hasAutomatic;
+			automatic = defaults.automatic;
+		}
+		if (cgroup.empty()) {
+			cgroup = defaults.cgroup;
+		}
+	}
+
+	// Method: Placement::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid placement setting
+	bool Placement::ApplySetting(std::string_view key, std::string_view value) {
+		size_t number;
+		if (key == "cpus") {
+			return ParseCpuList(value, cpus);
+		}
+		if (key == "numa") {
+			if (!ParseUnsigned(value, number) || number > 1023) {
+				return false;
+			}
+			numaNode = static_cast<int>(number);
+			return true;
+		}
+		if (key == "nice") {
+			bool negative = !value.empty() && value[0] == '-';
+			if (!ParseUnsigned(negative ? value.substr(1) : value, number) || number > (negative ? 20u : 19u)) {
+				return false;
+			}
+			nice = negative ? -static_cast<int>(number) : static_cast<int>(number);
+			hasNice = true;
+			return true;
+		}
+		if (key == "memory_max") {
+			return ParseSize(value, memoryMax);
+		}
+		if (key == "cpu_max") {
+			if (!ParseUnsigned(value, number) || number == 0 || number > 100000) {
+				return false;
+			}
+			cpuMax = static_cast<unsigned int>(number);
+			return true;
+		}
+		if (key == "placement") {
+			if (value == "auto") {
+				automatic = true;
+			}
+			else if (value == "none") {
+				automatic = false;
+			}
+			else {
+				return false;
+			}
+			hasAutomatic = true;
+			return true;
+		}
+		return false;
+	}
+
+	// Method: Placement::Rearm
+	// Purpose: Undoes what starting a process filled in, so the placement can be applied to another run
+	//			Automatic CPUs are chosen again and the cgroup goes back to the delegated directory
+	void Placement::Rearm() {
+		if (automatic) {
+			cpus.clear();
+			numaNode = -1;
+		}
+		// A started process's cgroup is its own directory inside the delegated one
+		if (applied && !cgroup.empty()) {
+			cgroup = std::filesystem::path(cgroup).parent_path().native();
+		}
+		applied = false;
+	}
+
+	// Method: Placement::Describe
+	// Output: The settings in the form they are written in the batch file, empty if none
+	std::wstring Placement::Describe() const {
+		std::wostringstream output;
+		if (!cpus.empty()) {
+			output << L" cpus=";
+			WriteCpuList(output, cpus);
+		}
+		if (numaNode >= 0) {
+			output << L" numa=" << numaNode;
+		}
+		if (hasNice) {
+			output << L" nice=" << nice;
+		}
+		if (memoryMax != 0) {
+			output << L" memory_max=" << memoryMax;
+		}
+		if (cpuMax != 0) {
+			output << L" cpu_max=" << cpuMax;
+		}
+		if (!cgroup.empty()) {
+			output << L" cgroup=" << ToWide(cgroup);
+		}
+		if (hasAutomatic) {
+			output << L" placement=" << (automatic ? L"auto" : L"none");
+		}
+		std::wstring text = output.str();
+		return text.empty() ? text : text.substr(1);
+	}
+/// End Placement::Operations
+
+/// Begin CpuLayout::Constructors
+	CpuLayout::CpuLayout(size_type slots)
+		: slots(slots == 0 ? 1 : slots) {
+		// Take one CPU from each node in turn, so neighbouring slots land on different nodes
+		std::vector<Placement::cpu_list> nodes = Placement::Topology();
+		size_type populated = std::count_if(nodes.begin(), nodes.end(), [](Placement::cpu_list const& cpus) {
+			return !cpus.empty();
+		});
+		for (size_type index = 0, added = 1; added > 0; ++index) {
+			added = 0;
+			for (size_type i = 0; i < nodes.size(); ++i) {
+				if (index < nodes[i].size()) {
+					// Without several nodes there is no memory placement to choose
+					order.emplace_back(nodes[i][index], populated > 1 ? static_cast<int>(i) : -1);
+					++added;
+				}
+			}
+		}
+	}
+/// End CpuLayout::Constructors
+
+/// Begin CpuLayout::Operations
+	// Method: CpuLayout::Assign
+	// Input: Slot a process was given, its placement
+	// Purpose: Fills in the CPUs and NUMA node of an automatic placement that does not set them
+	//			Slots share nothing while there are at least as many CPUs as slots
+	void CpuLayout::Assign(size_type slot, Placement& placement) {
+		if (!placement.automatic || !placement.cpus.empty() || order.empty()) {
+			return;
+		}
+
+		// Every slots-th CPU from the slot onwards, or one shared CPU when slots outnumber CPUs
+		int node = -2;
+		for (size_type i = slot % std::min(slots, order.size()); i < order.size(); i += slots) {
+			placement.cpus.push_back(order[i].first);
+			node = node == -2 || node == order[i].second ? order[i].second : -1;
+		}
+		std::sort(placement.cpus.begin(), placement.cpus.end());
+		if (placement.numaNode < 0 && node >= 0) {
+			placement.numaNode = node;
+		}
+	}
+/// End CpuLayout::Operations
+}
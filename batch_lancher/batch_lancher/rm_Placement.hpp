@@ -0,0 +1,109 @@
+/*
+File: rm_Placement.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Where a process runs and what it may use
+		CPU set, NUMA node, nice value and memory and CPU quotas
+		Quotas use a cgroup v2 per process on Linux and a job object on Windows
+*/
+#ifndef RM_PLACEMENT_HEADER_GUARD
+#define RM_PLACEMENT_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rm {
+	struct Placement {
+		using size_type = size_t;
+		using cpu_list = std::vector<unsigned int>;
+
+		// CPUs the process may run on, empty for any
+		cpu_list cpus;
+		// NUMA node memory is preferred from, -1 for any
+		int numaNode = -1;
+		bool hasNice = false;
+		// -20 is the highest priority and 19 the lowest
+		int nice = 0;
+		// Bytes of memory the process may use, 0 for unlimited
+		unsigned long long memoryMax = 0;
+		// Percent of one CPU the process may use, 0 for unlimited
+		unsigned int cpuMax = 0;
+		// CPUs and NUMA node are chosen by the scheduler when not set
+		bool hasAutomatic = false;
+		bool automatic = false;
+		// Parent cgroup before the process starts, the process's own cgroup once it has
+		native_string cgroup;
+		// The placement was applied to a started process
+		bool applied = false;
+
+		// Method: Placement::Empty
+		// Output: Whether nothing is set, so the process runs like the launcher
+		bool Empty() const;
+
+		// Method: Placement::Merge
+		// Input: Settings of the launchgroup or launcher
+		// Purpose: Copies every setting this placement does not set itself
+		void Merge(Placement const& defaults);
+
+		// Method: Placement::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid placement setting
+		//			cpus=0-3;6 numa=1 nice=5 memory_max=512M cpu_max=50 placement=auto
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: Placement::ParseCpuList
+		// Input: CPU list such as "0-3;6", ',' may also separate entries
+		// Output: Whether the list was valid and not empty, the sorted CPUs
+		static bool ParseCpuList(std::string_view text, cpu_list& output);
+
+		// Method: Placement::Rearm
+		// Purpose: Undoes what starting a process filled in, so the placement can be applied to another run
+		//			Automatic CPUs are chosen again and the cgroup goes back to the delegated directory
+		void Rearm();
+
+		// Method: Placement::Describe
+		// Output: The settings in the form they are written in the batch file, empty if none
+		std::wstring Describe() const;
+
+		// Method: Placement::Topology
+		// Output: CPUs the launcher may use, indexed by NUMA node
+		static std::vector<cpu_list> Topology();
+
+		// Method: Placement::NodeCpus
+		// Input: NUMA node
+		// Output: CPUs of the node the launcher may use, empty if the node is unknown
+		static cpu_list NodeCpus(int node);
+
+#ifndef _WIN32
+		// Method: Placement::PrepareCgroup
+		// Input: Delegated cgroup v2 directory the per process cgroups are created in
+		// Output: Whether the memory and cpu controllers could be enabled for its children
+		static bool PrepareCgroup(native_string const& root);
+#endif
+	};
+
+	// Spreads the slots of the scheduler across CPUs and NUMA nodes
+	class CpuLayout {
+	public:		/// Types
+		using size_type = size_t;
+	private:	/// Variables
+		// Every CPU, alternating between NUMA nodes
+		std::vector<std::pair<unsigned int, int>> order;
+		size_type slots;
+	public:		/// Methods
+		/// Constructors
+		// Input: Processes the scheduler runs at once
+		CpuLayout(size_type slots);
+
+		/// Operations
+		// Method: CpuLayout::Assign
+		// Input: Slot a process was given, its placement
+		// Purpose: Fills in the CPUs and NUMA node of an automatic placement that does not set them
+		//			Slots share nothing while there are at least as many CPUs as slots
+		void Assign(size_type slot, Placement& placement);
+	};
+}
+
+#endif
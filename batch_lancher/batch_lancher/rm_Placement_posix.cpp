@@ -0,0 +1,115 @@
+/*
+File: rm_Placement_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::Placement
+		Linux reads NUMA nodes from sysfs and places quotas in cgroup v2
+*/
+#ifndef _WIN32
+#include "rm_Placement.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace rm {
+	namespace {
+		// Method: AllowedCpus
+		// Purpose: CPUs the launcher may run on
+		Placement::cpu_list AllowedCpus() {
+			Placement::cpu_list output;
+#ifdef __linux__
+			cpu_set_t mask;
+			if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+				for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+					if (CPU_ISSET(cpu, &mask)) {
+						output.push_back(cpu);
+					}
+				}
+				return output;
+			}
+#endif
+			unsigned int count = std::thread::hardware_concurrency();
+			for (unsigned int cpu = 0; cpu < (count == 0 ? 1 : count); ++cpu) {
+				output.push_back(cpu);
+			}
+			return output;
+		}
+
+		// Method: ReadNodeCpus
+		// Purpose: CPUs of a NUMA node according to sysfs, empty if the node does not exist
+		Placement::cpu_list ReadNodeCpus(int node) {
+			Placement::cpu_list output;
+			std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+			std::string line;
+			if (std::getline(file, line)) {
+				Placement::ParseCpuList(line, output);
+			}
+			return output;
+		}
+	}
+
+/// Begin Placement::Operations
+	// Method: Placement::Topology
+	// Output: CPUs the launcher may use, indexed by NUMA node
+	std::vector<Placement::cpu_list> Placement::Topology() {
+		Placement::cpu_list allowed = AllowedCpus();
+		std::vector<cpu_list> nodes;
+		std::error_code error;
+		for (std::filesystem::directory_iterator entry("/sys/devices/system/node", error), end; !error && entry != end; entry.increment(error)) {
+			std::string name = entry->path().filename().string();
+			size_t node;
+			if (name.compare(0, 4, "node") != 0 || !ParseUnsigned(std::string_view(name).substr(4), node)) {
+				continue;
+			}
+			if (nodes.size() <= node) {
+				nodes.resize(node + 1);
+			}
+			nodes[node] = NodeCpus(static_cast<int>(node));
+		}
+
+		// Without NUMA information every CPU is on one node
+		if (nodes.empty()) {
+			nodes.push_back(allowed);
+		}
+		return nodes;
+	}
+
+	// Method: Placement::NodeCpus
+	// Input: NUMA node
+	// Output: CPUs of the node the launcher may use, empty if the node is unknown
+	Placement::cpu_list Placement::NodeCpus(int node) {
+		cpu_list allowed = AllowedCpus();
+		cpu_list output;
+		for (unsigned int cpu : ReadNodeCpus(node)) {
+			if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+				output.push_back(cpu);
+			}
+		}
+		return output;
+	}
+
+	// Method: Placement::PrepareCgroup
+	// Input: Delegated cgroup v2 directory the per process cgroups are created in
+	// Output: Whether the memory and cpu controllers could be enabled for its children
+	bool Placement::PrepareCgroup(native_string const& root) {
+		// Opened without creating it, so a plain directory is not mistaken for a cgroup
+		std::ofstream control(root + "/cgroup.subtree_control", std::ios::in | std::ios::out);
+		control << "+memory +cpu" << std::flush;
+		if (!control) {
+			std::wcerr << L"Error: Could not enable the memory and cpu controllers in " << ToWide(root)
+				<< L", it must be a delegated cgroup v2 directory without processes of its own." << std::endl;
+			return false;
+		}
+		return true;
+	}
+/// End Placement::Operations
+}
+#endif
@@ -0,0 +1,69 @@
+/*
+File: rm_Placement_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::Placement
+		Only processor group 0 is used, the same CPUs SetProcessAffinityMask can reach
+*/
+#ifdef _WIN32
+#include "rm_Placement.hpp"
+#include <Windows.h>
+
+namespace rm {
+	namespace {
+		// Method: AllowedMask
+		// Purpose: CPUs of processor group 0 the launcher may run on
+		DWORD_PTR AllowedMask() {
+			DWORD_PTR processMask = 0, systemMask = 0;
+			if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+				return 1;
+			}
+			return processMask;
+		}
+
+		// Method: ToCpuList
+		// Purpose: Lists the CPUs set in a mask
+		Placement::cpu_list ToCpuList(DWORD_PTR mask) {
+			Placement::cpu_list output;
+			for (unsigned int cpu = 0; cpu < 8 * sizeof(DWORD_PTR); ++cpu) {
+				if (mask & (DWORD_PTR(1) << cpu)) {
+					output.push_back(cpu);
+				}
+			}
+			return output;
+		}
+	}
+
+/// Begin Placement::Operations
+	// Method: Placement::Topology
+	// Output: CPUs the launcher may use, indexed by NUMA node
+	std::vector<Placement::cpu_list> Placement::Topology() {
+		std::vector<cpu_list> nodes;
+		ULONG highest = 0;
+		if (GetNumaHighestNodeNumber(&highest)) {
+			for (ULONG node = 0; node <= highest; ++node) {
+				nodes.push_back(NodeCpus(static_cast<int>(node)));
+			}
+		}
+
+		// Without NUMA information every CPU is on one node
+		if (nodes.empty()) {
+			nodes.push_back(ToCpuList(AllowedMask()));
+		}
+		return nodes;
+	}
+
+	// Method: Placement::NodeCpus
+	// Input: NUMA node
+	// Output: CPUs of the node the launcher may use, empty if the node is unknown
+	Placement::cpu_list Placement::NodeCpus(int node) {
+		GROUP_AFFINITY affinity = {};
+		if (node < 0 || !GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity) || affinity.Group != 0) {
+			return cpu_list();
+		}
+		return ToCpuList(affinity.Mask & AllowedMask());
+	}
+/// End Placement::Operations
+}
+#endif
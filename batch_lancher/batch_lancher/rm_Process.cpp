@@ -1,87 +1,288 @@
 /*
-File: rm_LaunchGroup.hpp
+File: rm_Process.cpp
 Author: Ryan McNamee
 Date Created: Friday, 22, September, 2017
-Date Updated: Monday, 9, October, 2017
-Purpose: Wraps C Functions for Windows processes
+Date Updated: Saturday, 17, October, 2026
+Purpose: Platform independent parts of rm::Process
+		Operating system calls live in rm_Process_win32.cpp and rm_Process_posix.cpp
 */
 #include "rm_Process.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 namespace rm {
+	ForkServer* Process::forkServer = nullptr;
+
+	namespace {
+		// Method: SplitList
+		// Purpose: Splits a pooled ';' separated list, empty entries are skipped
+		std::vector<native_string_view> SplitList(native_string_view list) {
+			std::vector<native_string_view> output;
+			while (!list.empty()) {
+				size_t end = list.find(';');
+				if (end != 0) {
+					output.push_back(list.substr(0, end));
+				}
+				list = end == native_string_view::npos ? native_string_view() : list.substr(end + 1);
+			}
+			return output;
+		}
+
+		// Method: ToClockFields
+		// Purpose: Splits a duration into the hour/minute/second/millisecond fields printed for a process
+		Process::system_time ToClockFields(Process::duration_type time) {
+			long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+			Process::system_time output = {};
+			output.wMilliseconds = static_cast<unsigned short>(ms % 1000);
+			output.wSecond = static_cast<unsigned short>((ms / 1000) % 60);
+			output.wMinute = static_cast<unsigned short>((ms / 60000) % 60);
+			output.wHour = static_cast<unsigned short>((ms / 3600000) % 24);
+			return output;
+		}
+	}
+
 /// Begin Process::Constructors
-	Process::Process(size_type lgroup, std::wstring const& app, std::wstring const& params)
-		: launchgroup(lgroup), app(app), params(params), command(L"\"" + app + L"\" " + params) {
-	
+	Process::Process(size_type lgroup, StringPool& pool, native_string_view app, native_string_view params)
+		: launchgroup(lgroup) {
+		// Build the whole command once, app and params are read back as slices
+		commandLength = static_cast<unsigned int>(app.size() + params.size() + 3);
+		appLength = static_cast<unsigned int>(app.size());
+		command = pool.Allocate(commandLength);
+
+		native_char* output = command;
+		*output++ = '"';
+		output = std::copy(app.begin(), app.end(), output);
+		*output++ = '"';
+		*output++ = ' ';
+		std::copy(params.begin(), params.end(), output);
+#ifndef _WIN32
+		PrepareArguments(pool);
+#endif
 	}
 
-	Process::~Process() {
-		// Close Process handles
-		CloseHandle(process.hThread);
-		CloseHandle(process.hProcess);
+	Process::Process(size_type lgroup, native_char* pooledCommand, unsigned int length, unsigned int applicationLength)
+		: launchgroup(lgroup), command(pooledCommand), commandLength(length), appLength(applicationLength) {
+
 	}
 /// End Process::Constructors
 
 /// Begin Process::Operations
-	// Method: Process::BasicStart
-	// Purpose: Wraps C Function CreateProcess() to start the process
-	void Process::BasicStart() {
-		// Initialize information for process
-		sinfo = { 0 };
-		sinfo.cb = sizeof(sinfo);
-		process = { 0 };
-
-		try {
-			// Create an empty string to copy command into
-			wchar_t* commandline = new wchar_t[CP_MAX_COMMANDLINE];
-
-			// Copy Process::command into empty string
-			wcsncpy_s(commandline, CP_MAX_COMMANDLINE, command.c_str(), command.size() + 1);
-
-			// Attempt to start process
-			// Log whether the process started
-			started = CreateProcess(NULL, commandline, NULL, NULL, false, CREATE_NEW_CONSOLE, NULL, NULL, &sinfo, &process);
-			// Destroy no longer empty string
-			delete[] commandline;
-		}
-		catch (std::bad_alloc&) {
-			std::wcerr << L"Insufficient memory to launch the application." << std::endl;
+	// Method: Process::GetDependencies
+	// Output: Job ids or "group:<launchgroup>" entries that must finish before this process starts
+	std::vector<native_string_view> Process::GetDependencies() {
+		return SplitList(dependencies);
+	}
+
+	// Method: Process::GetInputs
+	// Output: Files the result of the process depends on
+	std::vector<native_string_view> Process::GetInputs() {
+		return SplitList(inputs);
+	}
+
+	// Method: Process::GetSources
+	// Output: Job ids whose stdout is piped into the stdin of this process
+	std::vector<native_string_view> Process::GetSources() {
+		return SplitList(sources);
+	}
+
+	// Method: Process::Restore
+	// Input: exit code and resources recorded by an earlier run of the same command,
+	//			whether they come from the journal of an interrupted run rather than the result cache
+	// Purpose: Completes the process without starting it, it reads back as a finished run
+	void Process::Restore(exit_code code, ResourceUsage const& usage, bool fromJournal) {
+		started = true;
+		cached = !fromJournal;
+		resumed = fromJournal;
+		settled = true;
+#ifndef _WIN32
+		// Nothing to reap
+		reaped = true;
+#endif
+		exitCode = code;
+		resources = usage;
+		startTime = endTime = clock_type::now();
+		procTime.kernalTime = ToClockFields(usage.kernelTime);
+		procTime.userTime = ToClockFields(usage.userTime);
+	}
+
+	// Method: Process::Replay
+	// Input: how one job of a sweep ended, its earlier attempts if it was retried
+	// Purpose: Completes a process expanded from the sweep as that job ended, so it reads back as a finished run
+	void Process::Replay(SweepResult const& result, std::vector<SweepResult> const* earlier) {
+		if (earlier != nullptr) {
+			attempts.reset(new std::vector<Attempt>);
+			for (SweepResult const& attempt : *earlier) {
+				attempts->push_back(Attempt{ (attempt.state & SweepResult::STARTED) != 0, static_cast<exit_code>(attempt.exitCode),
+					static_cast<StopReason>(attempt.stopReason), clock_type::time_point(duration_type(attempt.start)),
+					clock_type::time_point(duration_type(attempt.end)) });
+			}
+		}
+		if ((result.state & SweepResult::DONE) == 0) {
+			// The job never finished, it reads back as not started
 			return;
 		}
+
+		started = (result.state & SweepResult::STARTED) != 0;
+		// Jobs finished before a resume read back as restored, like other processes
+		cached = (result.state & SweepResult::CACHED) != 0;
+		resumed = (result.state & SweepResult::RESUMED) != 0;
+		settled = true;
+#ifndef _WIN32
+		reaped = true;
+#endif
+		exitCode = static_cast<exit_code>(result.exitCode);
+		stopReason = static_cast<StopReason>(result.stopReason);
+		startTime = clock_type::time_point(duration_type(result.start));
+		endTime = clock_type::time_point(duration_type(result.end));
+		spawnLatency = duration_type(result.spawnLatency);
+		launchOverhead = duration_type(result.launchOverhead);
+		resources = {};
+		resources.wallTime = endTime - startTime;
+		resources.userTime = duration_type(result.userTime);
+		resources.kernelTime = duration_type(result.kernelTime);
+		procTime.kernalTime = ToClockFields(resources.kernelTime);
+		procTime.userTime = ToClockFields(resources.userTime);
+	}
+
+	// Method: Process::Expand
+	// Input: job of the sweep, buffers that hold its text and arguments while the returned process lives
+	// Output: Process for the job, with the settings of this one and its parameters substituted
+	Process Process::Expand(size_type job, native_string& text, std::vector<native_char*>& arguments) {
+		native_string params;
+		sweep->Expand(job, GetParams(), params);
+		native_string_view app = GetApp();
+
+		// Laid out like a pooled command, followed on POSIX by the arguments argv points into
+		text.clear();
+		text += RM_TEXT('"');
+		text += app;
+		text += RM_TEXT("\" ");
+		text += params;
+		unsigned int length = static_cast<unsigned int>(text.size());
+#ifndef _WIN32
+		text += native_char(0);
+		size_type first = text.size();
+		text += app;
+		text.append(params.size() + 2, native_char(0));
+		size_t count = 1 + SplitArgumentsInto(params, &text[first + app.size() + 1]);
+		arguments.clear();
+		native_char* argument = &text[first];
+		for (size_t index = 0; index < count; ++index) {
+			arguments.push_back(argument);
+			argument += std::char_traits<native_char>::length(argument) + 1;
+		}
+		arguments.push_back(nullptr);
+#else
+		(void)arguments;
+#endif
+
+		Process output(launchgroup, &text[0], length, appLength);
+#ifndef _WIN32
+		output.argv = arguments.data();
+#endif
+		output.id = id;
+		output.inputs = inputs;
+		output.outputMode = outputMode;
+		output.environmentText = environmentText;
+		output.environment = environment;
+		output.directory = directory;
+		// Only set on a sweep to keep a consumer whose sources were dropped off the launcher's stdin
+		output.inputHandle = inputHandle;
+		output.timeout = timeout;
+		output.grace = grace;
+		if (retry != nullptr) {
+			output.retry.reset(new RetryPolicy(*retry));
+		}
+		output.expectedTime = expectedTime;
+		// Results of a job are not kept beyond the sweep's own
+		output.cacheable = false;
+		if (placement != nullptr) {
+			output.placement.reset(new Placement(*placement));
+		}
+		return output;
 	}
 
-	// Method: Process::Start
-	// Purpose: Starts the process and waits for it to complete
-	void Process::Start() {
-		BasicStart();
-		// Wait for process to finish
-		if (WAIT_FAILED == WaitForSingleObject(process.hProcess, INFINITE))
-			std::cerr << "Failure waiting for proccess to terminate." << std::endl;
+	// Method: Process::ForEachJob
+	// Input: function called with each job
+	// Purpose: Visits this process, or every job of its sweep as it ended
+	void Process::ForEachJob(std::function<void(Process&)> const& visit) {
+		if (sweep == nullptr) {
+			visit(*this);
+			return;
+		}
+		native_string text;
+		std::vector<native_char*> arguments;
+		for (size_type job = 0; job < sweep->GetCount(); ++job) {
+			Process run = Expand(job, text, arguments);
+			run.Replay(sweep->GetResult(job), sweep->GetEarlierAttempts(job));
+			visit(run);
+		}
 	}
 
-	// Method: Process::StartAsync
-	// Purpose: Starts the process without waiting for it to complete
-	void Process::StartAsync() {
-		BasicStart();
+	// Method: Process::Retry
+	// Purpose: Records the finished run as an earlier attempt and returns the process
+	//			to its unstarted state, so it can be started again
+	void Process::Retry() {
+		if (attempts == nullptr) {
+			attempts.reset(new std::vector<Attempt>);
+		}
+		attempts->push_back(Attempt{ started, started ? GetExitCode() : exit_code(0), stopReason, startTime, endTime });
+
+		started = false;
+		settled = false;
+		exitCode = 0;
+		procTime = {};
+		resources = {};
+		startTime = endTime = clock_type::time_point();
+		stopReason = StopReason::None;
+		copyOutcome = CopyOutcome::None;
+#ifdef _WIN32
+		if (process.hThread != NULL) {
+			CloseHandle(process.hThread);
+		}
+		if (process.hProcess != NULL) {
+			CloseHandle(process.hProcess);
+		}
+		if (job != NULL) {
+			CloseHandle(job);
+			job = NULL;
+		}
+		process = {};
+#else
+		pid = -1;
+		reaped = false;
+		usage = {};
+		creationTime = exitTime = std::chrono::system_clock::time_point();
+#endif
+		if (placement != nullptr) {
+			placement->Rearm();
+		}
 	}
 
-	// Method: Process::Stop
-	// Purpose: Immediately terminates the process with exit code of EXIT_FAILURE
-	void Process::Stop() {
-		exitCode = EXIT_FAILURE;
-		TerminateProcess(process.hProcess, exitCode);
+	// Method: Process::GetAttempts
+	// Output: Earlier runs of the process, oldest first
+	std::vector<Process::Attempt> const& Process::GetAttempts() {
+		static const std::vector<Attempt> none;
+		return attempts == nullptr ? none : *attempts;
 	}
 
-	// Method: Process::Done
-	// Output: If process has finished
-	// Purpose: Check if the process is alive
-	// WARNING: Will never return true if process exits with code 259
-	// DEPRECIATED: More reliable method created
-	bool Process::Done() {
-		GetExitCodeProcess(process.hProcess, &exitCode);
-		return exitCode != STILL_ACTIVE;
+	// Method: Process::Adopt
+	// Input: Finished copy of this process that finished first
+	// Purpose: Takes the results of the copy, this process must have been reaped
+	void Process::Adopt(Process& copy) {
+		exitCode = copy.GetExitCode();
+		resources = copy.GetResourceUsage();
+		procTime = copy.GetProcessTime();
+		// The job started with this process and ended with the copy
+		endTime = copy.endTime;
+		stopReason = copy.stopReason;
+		if (copy.placement != nullptr) {
+			placement.reset(new Placement(*copy.placement));
+		}
+		copyOutcome = CopyOutcome::CopyWon;
+		settled = true;
 	}
 /// End Process::Operations
 
@@ -101,11 +302,32 @@ namespace rm {
 		oss << kTime.wHour << ":" << kTime.wMinute << ":" << kTime.wSecond << "." << kTime.wMilliseconds;
 		std::wstring kernalTime = oss.str();
 		// Clear stringstream
-		oss.clear();
+		oss.str(std::wstring());
 		// Write userTime to a string
 		oss << uTime.wHour << ":" << uTime.wMinute << ":" << uTime.wSecond << "." << uTime.wMilliseconds;
 		std::wstring userTime = oss.str();
 
+		// Notes on how the process ended
+		std::wstring notes;
+		if (rhs.IsCached()) {
+			notes += L" (cached)";
+		}
+		else if (rhs.IsResumed()) {
+			notes += L" (resumed)";
+		}
+		if (rhs.GetStopReason() == StopReason::Timeout) {
+			notes += L" (timed out)";
+		}
+		else if (rhs.GetStopReason() == StopReason::Straggler) {
+			notes += L" (stopped as a straggler)";
+		}
+		if (rhs.GetCopyOutcome() == CopyOutcome::CopyWon) {
+			notes += L" (copy finished first)";
+		}
+		else if (rhs.GetCopyOutcome() == CopyOutcome::OriginalWon) {
+			notes += L" (finished before its copy)";
+		}
+
 		// Write process info to output stream
 		lhs << std::setw(3) << std::right
 			<< rhs.GetLaunchGroup() << L" |"
@@ -116,8 +338,42 @@ namespace rm {
 			<< std::setw(5) << std::right
 			<< rhs.GetExitCode() << L" | "
 			<< std::left
-			<< rhs.GetApp() << std::endl
-			<< L"Parameters: " << rhs.GetParams() << std::endl;
+			<< ToWide(rhs.GetApp()) << notes << std::endl
+			<< L"Parameters: " << ToWide(rhs.GetParams()) << std::endl;
+		// Placement as it was applied, settings that failed are left out
+		if (rhs.GetPlacement() != nullptr && !rhs.GetPlacement()->Describe().empty()) {
+			lhs << L"Placement: " << rhs.GetPlacement()->Describe() << std::endl;
+		}
+		// Environment as the process set it, launchgroup defaults are left out
+		if (!rhs.GetEnvironmentText().empty()) {
+			native_string_view text = rhs.GetEnvironmentText();
+			lhs << L"Environment: " << ToWide(text[0] == ' ' ? text.substr(1) : text) << std::endl;
+		}
+		if (!rhs.GetDirectory().empty()) {
+			lhs << L"Directory: " << ToWide(rhs.GetDirectory()) << std::endl;
+		}
+		// Every run of a retried process, the last is the one shown above
+		if (rhs.GetAttemptCount() > 1) {
+			using seconds = std::chrono::duration<double>;
+			lhs << L"Attempts: " << rhs.GetAttemptCount() << std::fixed << std::setprecision(3);
+			for (Process::Attempt const& attempt : rhs.GetAttempts()) {
+				if (attempt.started) {
+					lhs << L", exit " << attempt.exitCode << L" after " << seconds(attempt.end - attempt.start).count() << L"s";
+				}
+				else {
+					lhs << L", not started";
+				}
+			}
+			if (rhs.DidRun()) {
+				lhs << L", exit " << rhs.GetExitCode() << L" after " << seconds(rhs.GetEndTime() - rhs.GetStartTime()).count() << L"s";
+			}
+			else {
+				lhs << L", not started";
+			}
+			lhs << std::endl;
+			lhs.unsetf(std::ios_base::floatfield);
+			lhs.precision(6);
+		}
 
 		// Return output stream
 		return lhs;
@@ -1,53 +1,237 @@
 /*
-File: rm_LaunchGroup.hpp
+File: rm_Process.hpp
 Author: Ryan McNamee
 Date Created: Friday, 22, September, 2017
-Date Updated: Monday, 9, October, 2017
-Purpose: Wraps C Functions for Windows processes
+Date Updated: Saturday, 17, October, 2026
+Purpose: Wraps C Functions for Windows and POSIX processes
 */
 #ifndef RM_PROCESS_HPP_HEADER_GUARD
 #define RM_PROCESS_HPP_HEADER_GUARD
+#include "rm_StringPool.hpp"
+#include "rm_Placement.hpp"
+#include "rm_RetryPolicy.hpp"
+#include "rm_Environment.hpp"
+#include "rm_Sweep.hpp"
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <sys/types.h>
+#include <sys/resource.h>
+#endif
 
 namespace rm {
+	class ForkServer;
+
 	// Constant for maximum length of a command in the windows commandline
 	static const unsigned long CP_MAX_COMMANDLINE = 32768;
 
+#ifndef _WIN32
+	// Mirrors the fields of the Win32 SYSTEMTIME used when printing a process
+	struct SystemTime {
+		unsigned short wHour, wMinute, wSecond, wMilliseconds;
+	};
+#endif
+
 	// Wraps SYSTEMTIMEs for process
 	struct ProcessTime {
+#ifdef _WIN32
 		SYSTEMTIME creationTime, exitTime, kernalTime, userTime;
+#else
+		SystemTime creationTime, exitTime, kernalTime, userTime;
+#endif
+	};
+
+	// Resources used by a finished process, counters the platform lacks are 0
+	struct ResourceUsage {
+		std::chrono::nanoseconds wallTime, kernelTime, userTime;
+		// Peak resident set size in bytes
+		unsigned long long maxRss;
+		unsigned long long minorFaults, majorFaults;
+		unsigned long long voluntarySwitches, involuntarySwitches;
+		// Bytes read and written, block I/O on POSIX and all I/O on Windows
+		unsigned long long readBytes, writeBytes;
+	};
+
+	// Where the output of a process goes
+	enum class OutputMode : unsigned char {
+		// Use the launcher default
+		Default,
+		// Share the launcher's console
+		Console,
+		// Keep the last bytes of each stream in memory
+		Tail,
+		// Write each stream to its own log file
+		Log
+	};
+
+	// Why the launcher stopped a process before it exited by itself
+	enum class StopReason : unsigned char {
+		None,
+		// It ran past its timeout
+		Timeout,
+		// It ran far longer than the rest of its launchgroup
+		Straggler
+	};
+
+	// Which run of a straggler finished first once a copy of it was started
+	enum class CopyOutcome : unsigned char {
+		// No copy was started
+		None,
+		OriginalWon,
+		CopyWon
 	};
 
 	class Process {
 	public:		/// Types
-		using process_handle = HANDLE;
 		using size_type = size_t;
+#ifdef _WIN32
+		using process_handle = HANDLE;
 		using system_time = SYSTEMTIME;
 		using proc_info = PROCESS_INFORMATION;
 		using start_info = STARTUPINFO;
 		using exit_code = DWORD;
+		using file_handle = HANDLE;
+#else
+		using process_handle = pid_t;
+		using system_time = SystemTime;
+		using exit_code = int;
+		using file_handle = int;
+#endif
 		using process_time = ProcessTime;
+		using clock_type = std::chrono::steady_clock;
+		using duration_type = std::chrono::nanoseconds;
+
+		// An earlier run of a process that was retried
+		struct Attempt {
+			bool started;
+			exit_code exitCode;
+			StopReason stopReason;
+			clock_type::time_point start, end;
+		};
 	private:	/// Variables
+		// Fork server whose helpers spawn processes, null to spawn them directly
+		static ForkServer* forkServer;
+
 		bool started = false;
+		// Results were restored from the result cache instead of starting the process
+		bool cached = false;
+		// Results were restored from the journal of an interrupted run instead of starting the process
+		bool resumed = false;
+		// Results are held in the fields below rather than read from the operating system
+		bool settled = false;
+		// Results may be stored and restored by a result cache
+		bool cacheable = true;
 		/// Process creation data
 		size_type launchgroup;
-		std::wstring command;
-		std::wstring app, params;
+		// Pooled, null terminated "\"app\" params", app and params are slices of it
+		native_char* command = nullptr;
+		unsigned int commandLength = 0;
+		unsigned int appLength = 0;
+		// Optional name other processes may depend on
+		native_string_view id;
+		// Pooled ';' separated job ids or "group:<launchgroup>" entries that must finish first
+		native_string_view dependencies;
+		// Pooled ';' separated files the result of the process depends on
+		native_string_view inputs;
+		// Pooled ';' separated job ids whose stdout the process reads as its stdin
+		native_string_view sources;
+		OutputMode outputMode = OutputMode::Default;
+		// Handles the child gets as stdout and stderr, unset to share the console
+#ifdef _WIN32
+		file_handle outputHandle = NULL;
+		file_handle errorHandle = NULL;
+#else
+		file_handle outputHandle = -1;
+		file_handle errorHandle = -1;
+#endif
+		// Pipe ends of a pipeline the child gets as stdin and stdout, the stdout one replaces captured stdout
+#ifdef _WIN32
+		file_handle inputHandle = NULL;
+		file_handle pipeHandle = NULL;
+#else
+		file_handle inputHandle = -1;
+		file_handle pipeHandle = -1;
+#endif
+
+		// Pooled "[template][ NAME=value]..." its environment is built from, null for its launchgroup's
+		native_char const* environmentText = nullptr;
+		// Environment shared with other processes, null to inherit the launcher's
+		Environment const* environment = nullptr;
+		// Pooled working directory, null for the launcher's
+		native_char const* directory = nullptr;
+
+		// Where the process runs, null to run like the launcher
+		// Settings that could not be applied are cleared once it has started
+		std::unique_ptr<Placement> placement;
+
+		// Axes the parameters are expanded over, null for a single job
+		// A sweep is never started itself, the scheduler starts a process per job of it
+		std::unique_ptr<Sweep> sweep;
 
 		/// Process start data
-		proc_info process;
-		start_info sinfo;
+#ifdef _WIN32
+		proc_info process = {};
+		start_info sinfo = {};
+		// Job object holding the memory and CPU quotas, if any
+		HANDLE job = NULL;
+#else
+		// Pooled, null terminated argv built once, argv[0] is the application
+		native_char** argv = nullptr;
+		pid_t pid = -1;
+		bool reaped = false;
+		// Started as the leader of its own process group
+		bool ownGroup = false;
+		std::chrono::system_clock::time_point creationTime, exitTime;
+		struct rusage usage = {};
+#endif
+		// Time spent inside the operating system spawn call
+		duration_type spawnLatency = duration_type::zero();
+		// Time spent in BasicStart, including preparing the commandline
+		duration_type launchOverhead = duration_type::zero();
+
+		// Run time predicted from earlier runs, zero if unknown
+		duration_type expectedTime = duration_type::zero();
+		// Wall time the process may run before it is stopped, zero for its launchgroup's
+		duration_type timeout = duration_type::zero();
+		// Time the process has to exit once asked before it is killed, zero for its launchgroup's
+		duration_type grace = duration_type::zero();
+		StopReason stopReason = StopReason::None;
+		CopyOutcome copyOutcome = CopyOutcome::None;
+		// Retry settings of the process itself, null for its launchgroup's retry policy
+		std::unique_ptr<RetryPolicy> retry;
+		// Earlier runs, null until the process is retried
+		std::unique_ptr<std::vector<Attempt>> attempts;
 
 		/// Process finish data
-		exit_code exitCode;
-		process_time procTime;
+		// Monotonic wall clock time the process was started and seen to finish
+		clock_type::time_point startTime, endTime;
+		exit_code exitCode = 0;
+		process_time procTime = {};
+		ResourceUsage resources = {};
 	public:		/// Methods
 		/// Constructors
-		Process(size_type lgroup, std::wstring const& app, std::wstring const& params);
+		// Input: launchgroup, pool owning the process text, application, parameters
+		Process(size_type lgroup, StringPool& pool, native_string_view app, native_string_view params);
+
+		// Input: launchgroup, pooled command laid out as the constructor above builds it, its length
+		//			and the length of the application within it
+		// Purpose: Takes the command as it is, used when loading a compiled batch file
+		//			On POSIX the arguments must be set with SetArguments before the process starts
+		Process(size_type lgroup, native_char* pooledCommand, unsigned int length, unsigned int applicationLength);
 
 		~Process();
 
+		// Processes may only be moved before they are started
+		Process(Process&&) = default;
+		Process& operator=(Process&&) = default;
+
 		/// Operations
 		// Method: Process::Start
 		// Purpose: Starts the process and waits for it to complete
@@ -57,14 +241,24 @@ namespace rm {
 		// Purpose: Starts the process without waiting for it to complete
 		void StartAsync();
 
+		// Method: Process::Wait
+		// Purpose: Blocks until a started process has completed
+		void Wait();
+
 		// Method: Process::Stop
 		// Purpose: Immediately terminates the process with exit code of EXIT_FAILURE
 		void Stop();
 
+		// Method: Process::Terminate
+		// Input: Whether to kill the process rather than ask it to exit
+		// Purpose: Sends SIGTERM, or SIGKILL when forced, without waiting for the process to exit
+		//			Windows has no request to exit that every process honours, so it always terminates
+		void Terminate(bool force);
+
 		// Method: Process::Done
 		// Output: If process has finished
 		// Purpose: Check if the process is alive
-		// WARNING: Will never return true if process exits with code 259
+		// WARNING: Will never return true if process exits with code 259 on Windows
 		// DEPRECIATED: More reliable method created
 		bool Done();
 
@@ -74,78 +268,460 @@ namespace rm {
 			return started;
 		}
 
+		// Method: Process::IsCached
+		// Output: Whether the results were restored from the result cache rather than the process being started
+		inline bool IsCached() {
+			return cached;
+		}
+
+		// Method: Process::IsResumed
+		// Output: Whether the results were restored from the journal of an interrupted run
+		inline bool IsResumed() {
+			return resumed;
+		}
+
+		// Method: Process::Restore
+		// Input: exit code and resources recorded by an earlier run of the same command,
+		//			whether they come from the journal of an interrupted run rather than the result cache
+		// Purpose: Completes the process without starting it, it reads back as a finished run
+		void Restore(exit_code code, ResourceUsage const& usage, bool fromJournal);
+
+		// Method: Process::Replay
+		// Input: how one job of a sweep ended, its earlier attempts if it was retried
+		// Purpose: Completes a process expanded from the sweep as that job ended, so it reads back as a finished run
+		void Replay(SweepResult const& result, std::vector<SweepResult> const* earlier);
+
+		// Method: Process::Retry
+		// Purpose: Records the finished run as an earlier attempt and returns the process
+		//			to its unstarted state, so it can be started again
+		void Retry();
+
+		// Method: Process::GetAttempts
+		// Output: Earlier runs of the process, oldest first
+		std::vector<Attempt> const& GetAttempts();
+
+		// Method: Process::GetAttemptCount
+		// Output: Runs of the process including the current one
+		inline size_type GetAttemptCount() {
+			return attempts == nullptr ? 1 : attempts->size() + 1;
+		}
+
+		// Method: Process::GetRetry
+		// Output: Retry policy of the process, null to use its launchgroup's
+		inline RetryPolicy* GetRetry() {
+			return retry.get();
+		}
+
+		// Method: Process::SetRetry
+		// Input: Retry policy of the process, settings it leaves unset come from its launchgroup
+		inline void SetRetry(RetryPolicy const& policy) {
+			retry.reset(new RetryPolicy(policy));
+		}
+
+		// Method: Process::Adopt
+		// Input: Finished copy of this process that finished first
+		// Purpose: Takes the results of the copy, this process must have been reaped
+		void Adopt(Process& copy);
+
 		// Method: Process::Succeded
 		// Output: Whether the process exited with the exit code 0
 		inline bool Succeded() {
-			PrepareExitCode();
+			if (!settled) {
+				PrepareExitCode();
+			}
 			return exitCode == EXIT_SUCCESS;
 		}
 
 		// Method: Process::GetCommand
 		// Output: The command that was used to start the process
-		inline std::wstring const& GetCommand() {
-			return command;
+		inline native_string_view GetCommand() {
+			return native_string_view(command, commandLength);
+		}
+
+#ifndef _WIN32
+		// Method: Process::GetArguments
+		// Output: Pooled, null terminated argv, argv[0] is the application
+		inline native_char** GetArguments() {
+			return argv;
 		}
 
+		// Method: Process::SetArguments
+		// Input: Pooled, null terminated argv that lives as long as the process
+		inline void SetArguments(native_char** arguments) {
+			argv = arguments;
+		}
+#endif
+
 		// Method: Process::GetLaunchGroup
 		// Output: The launchgroup the process should be in
-		inline size_type GetLaunchGroup() {
+		inline size_type GetLaunchGroup() const {
 			return launchgroup;
 		}
 
+		// Method: Process::GetId
+		// Output: Name other processes may depend on, empty if not set
+		inline native_string_view GetId() {
+			return id;
+		}
+
+		// Method: Process::SetId
+		// Input: Pooled name other processes may depend on
+		inline void SetId(native_string_view name) {
+			id = name;
+		}
+
+		// Method: Process::GetDependencies
+		// Output: Job ids or "group:<launchgroup>" entries that must finish before this process starts
+		std::vector<native_string_view> GetDependencies();
+
+		// Method: Process::GetDependencyList
+		// Output: Pooled ';' separated dependencies, as set by SetDependencyList
+		inline native_string_view GetDependencyList() {
+			return dependencies;
+		}
+
+		// Method: Process::SetDependencyList
+		// Input: Pooled ';' separated job ids or "group:<launchgroup>" entries
+		inline void SetDependencyList(native_string_view list) {
+			dependencies = list;
+		}
+
+		// Method: Process::GetInputs
+		// Output: Files the result of the process depends on
+		std::vector<native_string_view> GetInputs();
+
+		// Method: Process::GetInputList
+		// Output: Pooled ';' separated input files, as set by SetInputList
+		inline native_string_view GetInputList() {
+			return inputs;
+		}
+
+		// Method: Process::SetInputList
+		// Input: Pooled ';' separated files the result of the process depends on
+		inline void SetInputList(native_string_view list) {
+			inputs = list;
+		}
+
+		// Method: Process::GetSources
+		// Output: Job ids whose stdout is piped into the stdin of this process
+		std::vector<native_string_view> GetSources();
+
+		// Method: Process::GetSourceList
+		// Output: Pooled ';' separated job ids, as set by SetSourceList
+		inline native_string_view GetSourceList() {
+			return sources;
+		}
+
+		// Method: Process::SetSourceList
+		// Input: Pooled ';' separated job ids whose stdout the process reads as its stdin
+		inline void SetSourceList(native_string_view list) {
+			sources = list;
+		}
+
+		// Method: Process::IsCacheable
+		// Output: Whether a result cache may skip the process
+		inline bool IsCacheable() {
+			return cacheable;
+		}
+
+		// Method: Process::SetCacheable
+		// Input: Whether a result cache may skip the process
+		inline void SetCacheable(bool allowed) {
+			cacheable = allowed;
+		}
+
+		// Method: Process::GetOutputMode
+		// Output: Where the output of the process goes
+		inline OutputMode GetOutputMode() {
+			return outputMode;
+		}
+
+		// Method: Process::SetOutputMode
+		// Input: Where the output of the process goes
+		inline void SetOutputMode(OutputMode mode) {
+			outputMode = mode;
+		}
+
+		// Method: Process::SetOutputHandles
+		// Input: Handles the child gets as stdout and stderr, they must not be closed until the process starts
+		inline void SetOutputHandles(file_handle output, file_handle error) {
+			outputHandle = output;
+			errorHandle = error;
+		}
+
+		// Method: Process::SetForkServer
+		// Input: Fork server whose helpers spawn every process started from now on, null to spawn them directly
+		static inline void SetForkServer(ForkServer* server) {
+			forkServer = server;
+		}
+
+		// Method: Process::SetPipeHandles
+		// Input: Pipe ends the child gets as stdin and stdout, unset for none
+		//			They must not be closed until the process starts
+		inline void SetPipeHandles(file_handle input, file_handle output) {
+			inputHandle = input;
+			pipeHandle = output;
+		}
+
+		// Method: Process::GetPlacement
+		// Output: Where the process runs, null if it runs like the launcher
+		inline Placement* GetPlacement() {
+			return placement.get();
+		}
+
+		// Method: Process::SetPlacement
+		// Input: Where the process runs, applied when it starts
+		inline void SetPlacement(Placement const& where) {
+			placement.reset(new Placement(where));
+		}
+
+		// Method: Process::GetSweep
+		// Output: Axes the parameters are expanded over, null for a single job
+		inline Sweep* GetSweep() {
+			return sweep.get();
+		}
+
+		// Method: Process::SetSweep
+		// Input: Axes the parameters are expanded over
+		inline void SetSweep(Sweep const& axes) {
+			sweep.reset(new Sweep(axes));
+		}
+
+		// Method: Process::Expand
+		// Input: job of the sweep, buffers that hold its text and arguments while the returned process lives
+		// Output: Process for the job, with the settings of this one and its parameters substituted
+		Process Expand(size_type job, native_string& text, std::vector<native_char*>& arguments);
+
+		// Method: Process::ForEachJob
+		// Input: function called with each job
+		// Purpose: Visits this process, or every job of its sweep as it ended
+		void ForEachJob(std::function<void(Process&)> const& visit);
+
+		// Method: Process::GetEnvironmentText
+		// Output: Template and overrides the environment is built from, empty for the launchgroup's
+		inline native_string_view GetEnvironmentText() {
+			return environmentText == nullptr ? native_string_view() : native_string_view(environmentText);
+		}
+
+		// Method: Process::SetEnvironmentText
+		// Input: Pooled, null terminated "[template][ NAME=value]..."
+		inline void SetEnvironmentText(native_char const* text) {
+			environmentText = text;
+		}
+
+		// Method: Process::GetEnvironment
+		// Output: Environment the process starts with, null for the launcher's
+		inline Environment const* GetEnvironment() {
+			return environment;
+		}
+
+		// Method: Process::SetEnvironment
+		// Input: Environment built from the text above, which must outlive the process
+		inline void SetEnvironment(Environment const* shared) {
+			environment = shared;
+		}
+
+		// Method: Process::GetDirectory
+		// Output: Working directory, empty for the launcher's
+		inline native_string_view GetDirectory() {
+			return directory == nullptr ? native_string_view() : native_string_view(directory);
+		}
+
+		// Method: Process::SetDirectory
+		// Input: Null terminated working directory, which must outlive the process
+		inline void SetDirectory(native_char const* path) {
+			directory = path;
+		}
+
 		// Method: Process::GetApp
 		// Output: Application that Process may attempt to start
-		inline std::wstring const& GetApp() {
-			return app;
+		inline native_string_view GetApp() {
+			return native_string_view(command + 1, appLength);
 		}
-		
+
 		// Method: Process::GetParams
 		// Output: Parameters of application that Process may attempt to start
-		inline std::wstring const& GetParams() {
-			return params;
+		inline native_string_view GetParams() {
+			return native_string_view(command + appLength + 3, commandLength - appLength - 3);
 		}
 
 		// Method: Process::GetExitCode
 		// Output: ExitCode of completed process
 		inline exit_code GetExitCode() {
-			PrepareExitCode();
+			if (!settled) {
+				PrepareExitCode();
+			}
 			return exitCode;
 		}
 
 		// Method: Process::GetHandle
 		// Output: Handle to running process
 		inline process_handle GetHandle() {
+#ifdef _WIN32
 			return process.hProcess;
+#else
+			return pid;
+#endif
 		}
+
 		// Method: Process::GetProcessTime
 		// Output: All available timing information for the Process
 		inline process_time GetProcessTime() {
-			PrepareProcessTimes();
+			if (!settled) {
+				PrepareProcessTimes();
+			}
 			return procTime;
 		}
 
+		// Method: Process::GetSpawnLatency
+		// Output: Time the operating system took to create the process
+		inline duration_type GetSpawnLatency() {
+			return spawnLatency;
+		}
+
+		// Method: Process::GetLaunchOverhead
+		// Output: Total time spent by BasicStart launching the process
+		inline duration_type GetLaunchOverhead() {
+			return launchOverhead;
+		}
+
+		// Method: Process::GetStartTime
+		// Output: Monotonic time the process was started
+		inline clock_type::time_point GetStartTime() {
+			return startTime;
+		}
+
+		// Method: Process::GetEndTime
+		// Output: Monotonic time the process was seen to finish
+		inline clock_type::time_point GetEndTime() {
+			return endTime;
+		}
+
+		// Method: Process::GetExpectedTime
+		// Output: Run time predicted from earlier runs, zero if unknown
+		inline duration_type GetExpectedTime() {
+			return expectedTime;
+		}
+
+		// Method: Process::SetExpectedTime
+		// Input: Run time predicted from earlier runs
+		inline void SetExpectedTime(duration_type expected) {
+			expectedTime = expected;
+		}
+
+		// Method: Process::GetTimeout
+		// Output: Wall time the process may run before it is stopped, zero for its launchgroup's
+		inline duration_type GetTimeout() {
+			return timeout;
+		}
+
+		// Method: Process::SetTimeout
+		// Input: Wall time the process may run before it is stopped
+		inline void SetTimeout(duration_type limit) {
+			timeout = limit;
+		}
+
+		// Method: Process::GetGrace
+		// Output: Time the process has to exit once asked before it is killed, zero for its launchgroup's
+		inline duration_type GetGrace() {
+			return grace;
+		}
+
+		// Method: Process::SetGrace
+		// Input: Time the process has to exit once asked before it is killed
+		inline void SetGrace(duration_type period) {
+			grace = period;
+		}
+
+		// Method: Process::GetStopReason
+		// Output: Why the launcher stopped the process, StopReason::None if it exited by itself
+		inline StopReason GetStopReason() {
+			return stopReason;
+		}
+
+		// Method: Process::SetStopReason
+		// Input: Why the launcher is stopping the process
+		inline void SetStopReason(StopReason reason) {
+			stopReason = reason;
+		}
+
+		// Method: Process::SetOwnGroup
+		// Input: Whether the process may be stopped by the launcher
+		// Purpose: On POSIX the process then leads its own process group, so Terminate also reaches its children
+		//			Such processes no longer get the terminal's Ctrl+C, which only the launcher receives
+		inline void SetOwnGroup(bool own) {
+#ifndef _WIN32
+			ownGroup = own;
+#else
+			(void)own;
+#endif
+		}
+
+		// Method: Process::GetCopyOutcome
+		// Output: Which run finished first if a copy of the process was started
+		inline CopyOutcome GetCopyOutcome() {
+			return copyOutcome;
+		}
+
+		// Method: Process::SetCopyOutcome
+		// Input: Which run finished first once a copy of the process was started
+		inline void SetCopyOutcome(CopyOutcome outcome) {
+			copyOutcome = outcome;
+		}
+
+		// Method: Process::GetResourceUsage
+		// Output: Wall time, CPU time, memory, fault, context switch and I/O counters of a finished process
+		inline ResourceUsage GetResourceUsage() {
+			if (!settled) {
+				PrepareResourceUsage();
+			}
+			return resources;
+		}
+
 	protected:
+#ifndef _WIN32
+		// Method: Process::PrepareArguments
+		// Input: pool owning the process text
+		// Purpose: Splits the parameters into Process::argv so launching allocates nothing
+		void PrepareArguments(StringPool& pool);
+
+		// Method: Process::Spawn
+		// Input: set to when the spawn call began, cgroup the process starts in, cleared if it could not be placed there
+		// Output: 0 once the process exists, otherwise the error that kept it from starting
+		// Purpose: Wraps C Function posix_spawnp() to create the process, or clones it into its cgroup
+		int Spawn(clock_type::time_point& spawnBegin, std::string& cgroup);
+
+		// Method: Process::CreateCgroup
+		// Output: cgroup the process starts in, empty if it has no quotas or they could not be set up
+		// Purpose: Creates the process's own cgroup under the delegated directory and sets its quotas
+		std::string CreateCgroup();
+
+		// Method: Process::RecordExit
+		// Input: status returned by wait4
+		// Purpose: Stores the exit code and exit time of a reaped process
+		void RecordExit(int status);
+#endif
+
 		// Method: Process::BasicStart
-		// Purpose: Wraps C Function CreateProcess() to start the process
+		// Purpose: Wraps CreateProcess() or posix_spawn() to start the process
 		void BasicStart();
 
+		// Method: Process::ApplyPlacement
+		// Purpose: Applies the nice value and quotas of a process that has just started
+		//			Anything that could not be applied is reported and cleared from the placement
+		void ApplyPlacement();
+
 		// Method: PrepareExitCode
 		// Purpose: Loads the ExitCode for the process into Process::exitCode
-		inline void PrepareExitCode() {
-			GetExitCodeProcess(process.hProcess, &exitCode);
-		}
+		void PrepareExitCode();
 
 		// Method: Process::PrepareProcessTimes
 		// Purpose: Loads creationTime, exitTime, kernalTime, userTime for process into Process::procTime
-		inline void PrepareProcessTimes() {
-			FILETIME cTime, eTime, kTime, uTime;
-			GetProcessTimes(process.hProcess, &cTime, &eTime, &kTime, &uTime);
+		void PrepareProcessTimes();
 
-			FileTimeToSystemTime(&cTime, &procTime.creationTime);
-			FileTimeToSystemTime(&eTime, &procTime.exitTime);
-			FileTimeToSystemTime(&kTime, &procTime.kernalTime);
-			FileTimeToSystemTime(&uTime, &procTime.userTime);
-		}
+		// Method: Process::PrepareResourceUsage
+		// Purpose: Loads the resources used by the process into Process::resources
+		void PrepareResourceUsage();
 	};
 
 	/// Operators
@@ -156,4 +732,4 @@ namespace rm {
 	std::wostream& operator <<(std::wostream& lhs, Process& rhs);
 }
 
-#endif
\ No newline at end of file
+#endif
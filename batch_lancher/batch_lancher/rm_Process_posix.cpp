@@ -0,0 +1,543 @@
+/*
+File: rm_Process_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX process backend for rm::Process
+		Processes are created with posix_spawnp, which glibc implements with
+		clone(CLONE_VM | CLONE_VFORK) so no page tables are copied per launch,
+		or by a helper of the fork server when one is running
+		Processes with quotas are cloned straight into their cgroup where the kernel allows it
+*/
+#ifndef _WIN32
+#include "rm_Process.hpp"
+#include "rm_ForkServer.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sched.h>
+#include <linux/sched.h>
+#include <sys/syscall.h>
+#endif
+
+extern char** environ;
+
+namespace rm {
+	namespace {
+		// Method: ToSystemTime
+		// Purpose: Splits a duration into the hour/minute/second/millisecond fields printed for a process
+		SystemTime ToSystemTime(std::chrono::microseconds time) {
+			long long ms = time.count() / 1000;
+			SystemTime output;
+			output.wMilliseconds = static_cast<unsigned short>(ms % 1000);
+			output.wSecond = static_cast<unsigned short>((ms / 1000) % 60);
+			output.wMinute = static_cast<unsigned short>((ms / 60000) % 60);
+			output.wHour = static_cast<unsigned short>((ms / 3600000) % 24);
+			return output;
+		}
+
+		// Method: ToMicroseconds
+		// Purpose: Converts a rusage timeval into a duration
+		std::chrono::microseconds ToMicroseconds(timeval const& time) {
+			return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+		}
+
+		// Method: WriteControl
+		// Output: Whether the value was written, errno is set if not
+		// Purpose: Writes a value to a cgroup control file, which must already exist
+		bool WriteControl(std::string const& path, std::string const& value) {
+			int file = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+			if (file == -1) {
+				return false;
+			}
+			bool written = write(file, value.data(), value.size()) == static_cast<ssize_t>(value.size());
+			int error = errno;
+			close(file);
+			errno = error;
+			return written;
+		}
+
+		// Method: CloneIntoCgroup
+		// Input: open cgroup directory, what the child starts, pid of the child
+		// Output: 0 once the process exists, otherwise the error that kept it from starting,
+		//			-1 if the kernel cannot clone into a cgroup and the caller spawns the process itself
+		// Purpose: Creates the child inside its cgroup with clone3, so its quotas hold from its first instruction
+		//			The child is a plain fork of the launcher, it sets itself up as posix_spawnp would
+		//			and reports a failed exec through a pipe closed on exec
+		int CloneIntoCgroup(int cgroup, ForkServer::Request const& request, pid_t& pid) {
+#if defined(__linux__) && defined(SYS_clone3) && defined(CLONE_INTO_CGROUP)
+			int status[2];
+			if (pipe2(status, O_CLOEXEC) != 0) {
+				return errno;
+			}
+			clone_args args = {};
+			args.flags = CLONE_INTO_CGROUP;
+			args.exit_signal = SIGCHLD;
+			args.cgroup = static_cast<uint64_t>(cgroup);
+			long child = syscall(SYS_clone3, &args, sizeof(args));
+			if (child == 0) {
+				sigset_t mask;
+				sigemptyset(&mask);
+				sigprocmask(SIG_SETMASK, &mask, nullptr);
+				bool ready = !request.ownGroup || setpgid(0, 0) == 0;
+				int handles[3] = { request.input, request.output, request.error };
+				for (int target = STDIN_FILENO; ready && target <= STDERR_FILENO; ++target) {
+					ready = handles[target] == -1 || dup2(handles[target], target) != -1;
+				}
+				ready = ready && (request.directory == nullptr || chdir(request.directory) == 0);
+				if (ready) {
+					execvpe(request.argv[0], request.argv, request.environment != nullptr ? request.environment : environ);
+				}
+				int error = errno;
+				while (write(status[1], &error, sizeof(error)) == -1 && errno == EINTR) {
+				}
+				_exit(127);
+			}
+			int error = errno;
+			close(status[1]);
+			if (child == -1) {
+				close(status[0]);
+				// Kernels before 5.7 have no clone3 or no CLONE_INTO_CGROUP
+				return error == ENOSYS || error == E2BIG || error == EINVAL ? -1 : error;
+			}
+
+			// Nothing is read once the child has executed, a failed child is reaped here as it never started
+			ssize_t result;
+			do {
+				result = read(status[0], &error, sizeof(error));
+			} while (result == -1 && errno == EINTR);
+			close(status[0]);
+			if (result == static_cast<ssize_t>(sizeof(error))) {
+				while (waitpid(static_cast<pid_t>(child), nullptr, 0) == -1 && errno == EINTR) {
+				}
+				return error;
+			}
+			pid = static_cast<pid_t>(child);
+			return 0;
+#else
+			(void)cgroup;
+			(void)request;
+			(void)pid;
+			return -1;
+#endif
+		}
+
+		// Memory policy modes of set_mempolicy
+		const int MEMORY_POLICY_DEFAULT = 0;
+		const int MEMORY_POLICY_PREFERRED = 1;
+
+		// Method: SetMemoryPolicy
+		// Purpose: Prefers memory from one NUMA node for the calling thread and its children, -1 for the default policy
+		//			Wraps the system call directly so libnuma is not needed
+		bool SetMemoryPolicy(int node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+			if (node < 0) {
+				return syscall(SYS_set_mempolicy, MEMORY_POLICY_DEFAULT, nullptr, 0) == 0;
+			}
+			unsigned long nodes[1024 / (8 * sizeof(unsigned long))] = {};
+			nodes[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+			return syscall(SYS_set_mempolicy, MEMORY_POLICY_PREFERRED, nodes, 1024 + 1) == 0;
+#else
+			(void)node;
+			(void)MEMORY_POLICY_DEFAULT;
+			(void)MEMORY_POLICY_PREFERRED;
+			return false;
+#endif
+		}
+	}
+
+/// Begin Process::Constructors
+	Process::~Process() {
+		// Reap the child so it does not linger as a zombie
+		if (started && !reaped) {
+			Wait();
+		}
+	}
+/// End Process::Constructors
+
+/// Begin Process::Operations
+	// Method: Process::PrepareArguments
+	// Input: pool owning the process text
+	// Purpose: Splits the parameters into Process::argv so launching allocates nothing
+	void Process::PrepareArguments(StringPool& pool) {
+		native_string_view app = GetApp();
+		native_string_view params = GetParams();
+
+		// The application is always argv[0], followed by the split parameters
+		native_char* args = pool.Allocate(app.size() + 1 + params.size() + 1);
+		std::copy(app.begin(), app.end(), args);
+		args[app.size()] = 0;
+		size_t count = 1 + SplitArgumentsInto(params, args + app.size() + 1);
+
+		argv = pool.AllocatePointers(count + 1);
+		for (size_t i = 0; i < count; ++i) {
+			argv[i] = args;
+			args += std::char_traits<native_char>::length(args) + 1;
+		}
+		argv[count] = nullptr;
+	}
+
+	// Method: Process::BasicStart
+	// Purpose: Starts the process through a helper of the fork server, or with posix_spawnp()
+	void Process::BasicStart() {
+		clock_type::time_point launchBegin = clock_type::now();
+		clock_type::time_point spawnBegin;
+		int error = 0;
+
+		// The cgroup and its quotas exist before the child does
+		std::string cgroup = placement != nullptr ? CreateCgroup() : std::string();
+
+		// Pinned processes are spawned directly, they take the CPUs and memory policy of the spawning thread,
+		// as are processes with quotas, which start inside their cgroup
+		bool served = false;
+		if (forkServer != nullptr && cgroup.empty() && (placement == nullptr || (placement->cpus.empty() && placement->numaNode < 0))) {
+			ForkServer::Request request = { argv, environment != nullptr ? environment->GetBlock() : nullptr, directory,
+				inputHandle, pipeHandle != -1 ? pipeHandle : outputHandle, errorHandle, ownGroup };
+			spawnBegin = clock_type::now();
+			served = forkServer->Spawn(request, pid, error);
+			spawnLatency = clock_type::now() - spawnBegin;
+		}
+		if (!served) {
+			error = Spawn(spawnBegin, cgroup);
+		}
+
+		// Log whether the process started
+		started = error == 0;
+		reaped = false;
+		if (started) {
+			startTime = spawnBegin;
+			creationTime = std::chrono::system_clock::now();
+			if (placement != nullptr) {
+				if (!cgroup.empty()) {
+					placement->cgroup = cgroup;
+				}
+				ApplyPlacement();
+			}
+		}
+		else {
+			pid = -1;
+			if (!cgroup.empty()) {
+				rmdir(cgroup.c_str());
+			}
+		}
+
+		launchOverhead = clock_type::now() - launchBegin;
+	}
+
+	// Method: Process::Spawn
+	// Input: set to when the spawn call began, cgroup the process starts in, cleared if it could not be placed there
+	// Output: 0 once the process exists, otherwise the error that kept it from starting
+	// Purpose: Wraps C Function posix_spawnp() to create the process, or clones it into its cgroup
+	int Process::Spawn(clock_type::time_point& spawnBegin, std::string& cgroup) {
+		// Children start with no signals blocked, even if the launcher blocks SIGCHLD
+		posix_spawnattr_t attr;
+		posix_spawnattr_init(&attr);
+		sigset_t mask;
+		sigemptyset(&mask);
+		posix_spawnattr_setsigmask(&attr, &mask);
+		// A process that may be stopped leads its own process group, so its children are stopped with it
+		posix_spawnattr_setpgroup(&attr, 0);
+		posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | (ownGroup ? POSIX_SPAWN_SETPGROUP : 0));
+
+		// Captured output replaces stdout and stderr, pipes of a pipeline replace stdin and stdout,
+		// and the child changes to its working directory
+		posix_spawn_file_actions_t actions;
+		posix_spawn_file_actions_t* redirect = nullptr;
+		if (outputHandle != -1 || inputHandle != -1 || pipeHandle != -1 || directory != nullptr) {
+			posix_spawn_file_actions_init(&actions);
+			redirect = &actions;
+		}
+		if (inputHandle != -1) {
+			posix_spawn_file_actions_adddup2(&actions, inputHandle, STDIN_FILENO);
+		}
+		if (pipeHandle != -1 || outputHandle != -1) {
+			posix_spawn_file_actions_adddup2(&actions, pipeHandle != -1 ? pipeHandle : outputHandle, STDOUT_FILENO);
+		}
+		if (errorHandle != -1) {
+			posix_spawn_file_actions_adddup2(&actions, errorHandle, STDERR_FILENO);
+		}
+		if (directory != nullptr) {
+#if (defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 29)) || defined(__APPLE__)
+			posix_spawn_file_actions_addchdir_np(&actions, directory);
+#else
+			std::wcerr << L"Error: Working directories are not supported on this system, " << ToWide(GetApp()) << L" runs in the launcher's." << std::endl;
+			directory = nullptr;
+#endif
+		}
+
+		// The child inherits the CPUs and memory policy of the spawning thread,
+		// so they are switched around the spawn rather than changed after the child has run
+#ifdef __linux__
+		cpu_set_t previousCpus;
+		bool pinned = false;
+		bool preferred = false;
+		if (placement != nullptr) {
+			if (placement->cpus.empty() && placement->numaNode >= 0) {
+				placement->cpus = Placement::NodeCpus(placement->numaNode);
+			}
+			if (!placement->cpus.empty()) {
+				cpu_set_t cpus;
+				CPU_ZERO(&cpus);
+				for (unsigned int cpu : placement->cpus) {
+					if (cpu < CPU_SETSIZE) {
+						CPU_SET(cpu, &cpus);
+					}
+				}
+				pinned = sched_getaffinity(0, sizeof(previousCpus), &previousCpus) == 0
+					&& sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+				if (!pinned) {
+					std::wcerr << L"Error: The CPUs set for " << ToWide(GetApp()) << L" are not available, they are not used." << std::endl;
+					placement->cpus.clear();
+				}
+			}
+			if (placement->numaNode >= 0) {
+				preferred = SetMemoryPolicy(placement->numaNode);
+				if (!preferred) {
+					std::wcerr << L"Error: Memory could not be placed on NUMA node " << placement->numaNode << L" for " << ToWide(GetApp()) << L"." << std::endl;
+					placement->numaNode = -1;
+				}
+			}
+		}
+#else
+		if (placement != nullptr && (!placement->cpus.empty() || placement->numaNode >= 0)) {
+			std::wcerr << L"Error: CPU and NUMA placement are not supported on this system, they are not used." << std::endl;
+			placement->cpus.clear();
+			placement->numaNode = -1;
+		}
+#endif
+
+		int directoryHandle = cgroup.empty() ? -1 : open(cgroup.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		spawnBegin = clock_type::now();
+		int error = -1;
+		if (directoryHandle != -1) {
+			ForkServer::Request request = { argv, environment != nullptr ? environment->GetBlock() : nullptr, directory,
+				inputHandle, pipeHandle != -1 ? pipeHandle : outputHandle, errorHandle, ownGroup };
+			error = CloneIntoCgroup(directoryHandle, request, pid);
+			close(directoryHandle);
+		}
+		bool joined = error != -1;
+		if (error == -1) {
+			error = posix_spawnp(&pid, argv[0], redirect, &attr, argv, environment != nullptr ? environment->GetBlock() : environ);
+		}
+		spawnLatency = clock_type::now() - spawnBegin;
+
+		// Without clone3 the child is moved in once it exists, one that has already exited is left alone
+		if (error == 0 && !cgroup.empty() && !joined && !WriteControl(cgroup + "/cgroup.procs", std::to_string(pid)) && errno != ESRCH) {
+			std::wcerr << L"Error: Could not place " << ToWide(GetApp()) << L" in cgroup " << ToWide(cgroup) << L", its quotas are not applied." << std::endl;
+			rmdir(cgroup.c_str());
+			cgroup.clear();
+			placement->memoryMax = 0;
+			placement->cpuMax = 0;
+			placement->cgroup.clear();
+		}
+#ifdef __linux__
+		if (pinned) {
+			sched_setaffinity(0, sizeof(previousCpus), &previousCpus);
+		}
+		if (preferred) {
+			SetMemoryPolicy(-1);
+		}
+#endif
+		posix_spawnattr_destroy(&attr);
+		if (redirect != nullptr) {
+			posix_spawn_file_actions_destroy(redirect);
+		}
+		return error;
+	}
+
+	// Method: Process::CreateCgroup
+	// Output: cgroup the process starts in, empty if it has no quotas or they could not be set up
+	// Purpose: Creates the process's own cgroup under the delegated directory and sets its quotas
+	//			Anything that could not be applied is reported and cleared from the placement
+	std::string Process::CreateCgroup() {
+		if (placement->memoryMax == 0 && placement->cpuMax == 0) {
+			placement->cgroup.clear();
+			return std::string();
+		}
+		if (placement->cgroup.empty()) {
+			std::wcerr << L"Error: memory_max and cpu_max need a cgroup directory, set with @set cgroup=<dir>." << std::endl;
+			placement->memoryMax = 0;
+			placement->cpuMax = 0;
+			return std::string();
+		}
+
+		// The pid is not known yet, cgroups are numbered in the order they are made
+		static std::atomic<unsigned long long> created(0);
+		std::string cgroup = placement->cgroup + "/rm-" + std::to_string(getpid()) + "-" + std::to_string(++created);
+		bool ready = mkdir(cgroup.c_str(), 0755) == 0;
+		if (ready && placement->memoryMax != 0) {
+			ready = WriteControl(cgroup + "/memory.max", std::to_string(placement->memoryMax));
+		}
+		if (ready && placement->cpuMax != 0) {
+			// Percent of one CPU as a quota per 100ms period
+			ready = WriteControl(cgroup + "/cpu.max", std::to_string(placement->cpuMax * 1000ULL) + " 100000");
+		}
+		if (!ready) {
+			std::wcerr << L"Error: Could not place " << ToWide(GetApp()) << L" in cgroup " << ToWide(cgroup) << L", its quotas are not applied." << std::endl;
+			rmdir(cgroup.c_str());
+			placement->memoryMax = 0;
+			placement->cpuMax = 0;
+			placement->cgroup.clear();
+			return std::string();
+		}
+		return cgroup;
+	}
+
+	// Method: Process::ApplyPlacement
+	// Purpose: Applies the nice value of a process that has just started, its quotas were set before it ran
+	//			Anything that could not be applied is reported and cleared from the placement
+	void Process::ApplyPlacement() {
+		placement->applied = true;
+		if (placement->hasNice && setpriority(PRIO_PROCESS, static_cast<id_t>(pid), placement->nice) != 0) {
+			std::wcerr << L"Error: Nice value " << placement->nice << L" could not be set for " << ToWide(GetApp()) << L"." << std::endl;
+			placement->hasNice = false;
+		}
+	}
+
+	// Method: Process::Start
+	// Purpose: Starts the process and waits for it to complete
+	void Process::Start() {
+		BasicStart();
+		Wait();
+	}
+
+	// Method: Process::StartAsync
+	// Purpose: Starts the process without waiting for it to complete
+	void Process::StartAsync() {
+		BasicStart();
+	}
+
+	// Method: Process::Wait
+	// Purpose: Blocks until a started process has completed
+	void Process::Wait() {
+		if (!started || reaped) {
+			return;
+		}
+
+		int status = 0;
+		pid_t result;
+		do {
+			result = wait4(pid, &status, 0, &usage);
+		} while (result == -1 && errno == EINTR);
+
+		if (result == -1) {
+			std::wcerr << L"Failure waiting for proccess to terminate." << std::endl;
+			return;
+		}
+
+		RecordExit(status);
+	}
+
+	// Method: Process::Stop
+	// Purpose: Immediately terminates the process with exit code of EXIT_FAILURE
+	void Process::Stop() {
+		if (!started || reaped) {
+			return;
+		}
+		Terminate(true);
+		Wait();
+		exitCode = EXIT_FAILURE;
+	}
+
+	// Method: Process::Terminate
+	// Input: Whether to kill the process rather than ask it to exit
+	// Purpose: Sends SIGTERM, or SIGKILL when forced, without waiting for the process to exit
+	void Process::Terminate(bool force) {
+		// A reaped pid may already belong to another process
+		if (!started || reaped) {
+			return;
+		}
+		kill(ownGroup ? -pid : pid, force ? SIGKILL : SIGTERM);
+	}
+
+	// Method: Process::Done
+	// Output: If process has finished
+	// Purpose: Check if the process is alive
+	// DEPRECIATED: More reliable method created
+	bool Process::Done() {
+		if (!started || reaped) {
+			return true;
+		}
+
+		int status = 0;
+		if (wait4(pid, &status, WNOHANG, &usage) != pid) {
+			return false;
+		}
+
+		RecordExit(status);
+		return true;
+	}
+
+	// Method: Process::RecordExit
+	// Input: status returned by wait4
+	// Purpose: Stores the exit code and exit time of a reaped process
+	void Process::RecordExit(int status) {
+		endTime = clock_type::now();
+		exitTime = std::chrono::system_clock::now();
+		reaped = true;
+		// The cgroup can only be removed once nothing is left in it, the path stays recorded
+		if (placement != nullptr && !placement->cgroup.empty()) {
+			rmdir(placement->cgroup.c_str());
+		}
+		if (WIFEXITED(status)) {
+			exitCode = WEXITSTATUS(status);
+		}
+		else if (WIFSIGNALED(status)) {
+			// Follow the shell convention for processes killed by a signal
+			exitCode = 128 + WTERMSIG(status);
+		}
+	}
+
+	// Method: PrepareExitCode
+	// Purpose: Loads the ExitCode for the process into Process::exitCode
+	// Reason: The exit code is recorded when the process is reaped
+	void Process::PrepareExitCode() {
+
+	}
+
+	// Method: Process::PrepareProcessTimes
+	// Purpose: Loads creationTime, exitTime, kernalTime, userTime for process into Process::procTime
+	void Process::PrepareProcessTimes() {
+		using std::chrono::duration_cast;
+		using std::chrono::microseconds;
+
+		procTime.creationTime = ToSystemTime(duration_cast<microseconds>(creationTime.time_since_epoch()));
+		procTime.exitTime = ToSystemTime(duration_cast<microseconds>(exitTime.time_since_epoch()));
+		procTime.kernalTime = ToSystemTime(ToMicroseconds(usage.ru_stime));
+		procTime.userTime = ToSystemTime(ToMicroseconds(usage.ru_utime));
+	}
+	// Method: Process::PrepareResourceUsage
+	// Purpose: Loads the resources used by the process into Process::resources
+	// Reason: The rusage of the process is recorded by wait4 when it is reaped
+	void Process::PrepareResourceUsage() {
+		resources.wallTime = reaped ? endTime - startTime : duration_type::zero();
+		resources.kernelTime = ToMicroseconds(usage.ru_stime);
+		resources.userTime = ToMicroseconds(usage.ru_utime);
+#ifdef __APPLE__
+		resources.maxRss = usage.ru_maxrss;
+#else
+		// Linux reports kilobytes
+		resources.maxRss = static_cast<unsigned long long>(usage.ru_maxrss) * 1024;
+#endif
+		resources.minorFaults = usage.ru_minflt;
+		resources.majorFaults = usage.ru_majflt;
+		resources.voluntarySwitches = usage.ru_nvcsw;
+		resources.involuntarySwitches = usage.ru_nivcsw;
+		// Block operations are counted in 512 byte units
+		resources.readBytes = static_cast<unsigned long long>(usage.ru_inblock) * 512;
+		resources.writeBytes = static_cast<unsigned long long>(usage.ru_oublock) * 512;
+	}
+/// End Process::Operations
+}
+#endif
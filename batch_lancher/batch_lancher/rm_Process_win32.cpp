@@ -0,0 +1,288 @@
+/*
+File: rm_Process_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows process backend for rm::Process
+		Wraps CreateProcess, WaitForSingleObject and friends
+*/
+#ifdef _WIN32
+#include "rm_Process.hpp"
+#include <Psapi.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+namespace rm {
+/// Begin Process::Constructors
+	Process::~Process() {
+		// Close Process handles
+		if (process.hThread != NULL) {
+			CloseHandle(process.hThread);
+		}
+		if (process.hProcess != NULL) {
+			CloseHandle(process.hProcess);
+		}
+		if (job != NULL) {
+			CloseHandle(job);
+		}
+	}
+/// End Process::Constructors
+
+/// Begin Process::Operations
+	// Method: Process::BasicStart
+	// Purpose: Wraps C Function CreateProcess() to start the process
+	void Process::BasicStart() {
+		clock_type::time_point launchBegin = clock_type::now();
+
+		// Initialize information for process
+		sinfo = { 0 };
+		sinfo.cb = sizeof(sinfo);
+		process = { 0 };
+
+		// CreateProcess may write to the commandline, so it is given the pooled command itself
+		if (commandLength >= CP_MAX_COMMANDLINE) {
+			std::wcerr << L"Commandline is longer than " << CP_MAX_COMMANDLINE - 1 << L" characters." << std::endl;
+			return;
+		}
+
+		// A placed process starts suspended so it never runs outside its placement
+		DWORD suspend = placement != nullptr ? CREATE_SUSPENDED : 0;
+		// Environment blocks are shared between processes and always wide
+		DWORD unicode = environment != nullptr ? CREATE_UNICODE_ENVIRONMENT : 0;
+		LPVOID block = environment != nullptr ? environment->GetBlock() : NULL;
+
+		// Attempt to start process
+		// Log whether the process started
+		clock_type::time_point spawnBegin = clock_type::now();
+		if (outputHandle == NULL && inputHandle == NULL && pipeHandle == NULL) {
+			started = CreateProcess(NULL, command, NULL, NULL, false, CREATE_NEW_CONSOLE | suspend | unicode, block, directory, &sinfo, &process);
+		}
+		else {
+			// Captured output replaces stdout and stderr and pipes of a pipeline replace stdin and stdout,
+			// only those handles are inherited and the rest are the launcher's own
+			STARTUPINFOEX extended = {};
+			extended.StartupInfo.cb = sizeof(extended);
+			extended.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+			extended.StartupInfo.hStdInput = inputHandle != NULL ? inputHandle : GetStdHandle(STD_INPUT_HANDLE);
+			extended.StartupInfo.hStdOutput = pipeHandle != NULL ? pipeHandle : outputHandle != NULL ? outputHandle : GetStdHandle(STD_OUTPUT_HANDLE);
+			extended.StartupInfo.hStdError = errorHandle != NULL ? errorHandle : GetStdHandle(STD_ERROR_HANDLE);
+
+			HANDLE inherit[3];
+			DWORD count = 0;
+			for (HANDLE handle : { inputHandle, pipeHandle != NULL ? pipeHandle : outputHandle, errorHandle }) {
+				if (handle != NULL && std::find(inherit, inherit + count, handle) == inherit + count) {
+					inherit[count++] = handle;
+				}
+			}
+			SIZE_T size = 0;
+			InitializeProcThreadAttributeList(NULL, 1, 0, &size);
+			std::vector<char> attributes(size);
+			extended.lpAttributeList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributes.data());
+			if (InitializeProcThreadAttributeList(extended.lpAttributeList, 1, 0, &size)) {
+				UpdateProcThreadAttribute(extended.lpAttributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+					inherit, count * sizeof(HANDLE), NULL, NULL);
+				started = CreateProcess(NULL, command, NULL, NULL, true, CREATE_NO_WINDOW | EXTENDED_STARTUPINFO_PRESENT | suspend | unicode,
+					block, directory, &extended.StartupInfo, &process);
+				DeleteProcThreadAttributeList(extended.lpAttributeList);
+			}
+		}
+		spawnLatency = clock_type::now() - spawnBegin;
+		if (started) {
+			startTime = spawnBegin;
+			if (placement != nullptr) {
+				ApplyPlacement();
+				ResumeThread(process.hThread);
+			}
+		}
+
+		launchOverhead = clock_type::now() - launchBegin;
+	}
+
+	// Method: Process::ApplyPlacement
+	// Purpose: Applies the placement of a process that has started suspended
+	//			Anything that could not be applied is reported and cleared from the placement
+	void Process::ApplyPlacement() {
+		placement->applied = true;
+		if (placement->cpus.empty() && placement->numaNode >= 0) {
+			placement->cpus = Placement::NodeCpus(placement->numaNode);
+		}
+		// Windows has no memory policy to inherit, memory follows the CPUs the process runs on
+		if (!placement->cpus.empty()) {
+			DWORD_PTR mask = 0;
+			for (unsigned int cpu : placement->cpus) {
+				if (cpu < 8 * sizeof(DWORD_PTR)) {
+					mask |= DWORD_PTR(1) << cpu;
+				}
+			}
+			if (mask == 0 || !SetProcessAffinityMask(process.hProcess, mask)) {
+				std::wcerr << L"Error: The CPUs set for " << ToWide(GetApp()) << L" are not available, they are not used." << std::endl;
+				placement->cpus.clear();
+				placement->numaNode = -1;
+			}
+		}
+
+		if (placement->hasNice) {
+			// Nice values map onto the priority classes
+			DWORD priority = placement->nice < -10 ? HIGH_PRIORITY_CLASS
+				: placement->nice < 0 ? ABOVE_NORMAL_PRIORITY_CLASS
+				: placement->nice > 10 ? IDLE_PRIORITY_CLASS
+				: placement->nice > 0 ? BELOW_NORMAL_PRIORITY_CLASS
+				: NORMAL_PRIORITY_CLASS;
+			if (!SetPriorityClass(process.hProcess, priority)) {
+				std::wcerr << L"Error: Priority could not be set for " << ToWide(GetApp()) << L"." << std::endl;
+				placement->hasNice = false;
+			}
+		}
+
+		// Quotas are enforced by a job object per process, there is no cgroup
+		placement->cgroup.clear();
+		if (placement->memoryMax == 0 && placement->cpuMax == 0) {
+			return;
+		}
+		job = CreateJobObject(NULL, NULL);
+		bool joined = job != NULL;
+		if (joined && placement->memoryMax != 0) {
+			JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+			limits.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_PROCESS_MEMORY;
+			limits.ProcessMemoryLimit = static_cast<SIZE_T>(placement->memoryMax);
+			joined = SetInformationJobObject(job, JobObjectExtendedLimitInformation, &limits, sizeof(limits)) != 0;
+		}
+		if (joined && placement->cpuMax != 0) {
+			// The rate is in hundredths of a percent of every CPU, cpu_max is percent of one
+			SYSTEM_INFO system;
+			GetSystemInfo(&system);
+			unsigned long long rate = placement->cpuMax * 100ULL / (system.dwNumberOfProcessors == 0 ? 1 : system.dwNumberOfProcessors);
+			JOBOBJECT_CPU_RATE_CONTROL_INFORMATION control = {};
+			control.ControlFlags = JOB_OBJECT_CPU_RATE_CONTROL_ENABLE | JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP;
+			control.CpuRate = static_cast<DWORD>(std::min<unsigned long long>(std::max<unsigned long long>(rate, 1), 10000));
+			joined = SetInformationJobObject(job, JobObjectCpuRateControlInformation, &control, sizeof(control)) != 0;
+		}
+		if (joined) {
+			joined = AssignProcessToJobObject(job, process.hProcess) != 0;
+		}
+		if (!joined) {
+			std::wcerr << L"Error: Could not place " << ToWide(GetApp()) << L" in a job object, its quotas are not applied." << std::endl;
+			placement->memoryMax = 0;
+			placement->cpuMax = 0;
+		}
+	}
+
+	// Method: Process::Start
+	// Purpose: Starts the process and waits for it to complete
+	void Process::Start() {
+		BasicStart();
+		Wait();
+	}
+
+	// Method: Process::StartAsync
+	// Purpose: Starts the process without waiting for it to complete
+	void Process::StartAsync() {
+		BasicStart();
+	}
+
+	// Method: Process::Wait
+	// Purpose: Blocks until a started process has completed
+	void Process::Wait() {
+		if (!started || cached) {
+			return;
+		}
+		// Wait for process to finish
+		if (WAIT_FAILED == WaitForSingleObject(process.hProcess, INFINITE))
+			std::wcerr << L"Failure waiting for proccess to terminate." << std::endl;
+		else if (endTime == clock_type::time_point())
+			endTime = clock_type::now();
+	}
+
+	// Method: Process::Stop
+	// Purpose: Immediately terminates the process with exit code of EXIT_FAILURE
+	void Process::Stop() {
+		if (cached) {
+			return;
+		}
+		exitCode = EXIT_FAILURE;
+		Terminate(true);
+	}
+
+	// Method: Process::Terminate
+	// Input: Whether to kill the process rather than ask it to exit
+	// Purpose: Terminates the process without waiting for it to exit
+	//			Windows has no request to exit that every process honours, so it always terminates
+	void Process::Terminate(bool force) {
+		if (!started || cached) {
+			return;
+		}
+		TerminateProcess(process.hProcess, EXIT_FAILURE);
+	}
+
+	// Method: Process::Done
+	// Output: If process has finished
+	// Purpose: Check if the process is alive
+	// WARNING: Will never return true if process exits with code 259
+	// DEPRECIATED: More reliable method created
+	bool Process::Done() {
+		if (cached) {
+			return true;
+		}
+		GetExitCodeProcess(process.hProcess, &exitCode);
+		if (exitCode == STILL_ACTIVE) {
+			return false;
+		}
+		if (endTime == clock_type::time_point()) {
+			endTime = clock_type::now();
+		}
+		return true;
+	}
+
+	// Method: PrepareExitCode
+	// Purpose: Loads the ExitCode for the process into Process::exitCode
+	void Process::PrepareExitCode() {
+		GetExitCodeProcess(process.hProcess, &exitCode);
+	}
+
+	// Method: Process::PrepareProcessTimes
+	// Purpose: Loads creationTime, exitTime, kernalTime, userTime for process into Process::procTime
+	void Process::PrepareProcessTimes() {
+		FILETIME cTime, eTime, kTime, uTime;
+		GetProcessTimes(process.hProcess, &cTime, &eTime, &kTime, &uTime);
+
+		FileTimeToSystemTime(&cTime, &procTime.creationTime);
+		FileTimeToSystemTime(&eTime, &procTime.exitTime);
+		FileTimeToSystemTime(&kTime, &procTime.kernalTime);
+		FileTimeToSystemTime(&uTime, &procTime.userTime);
+	}
+
+	// Method: Process::PrepareResourceUsage
+	// Purpose: Loads the resources used by the process into Process::resources
+	void Process::PrepareResourceUsage() {
+		resources = {};
+		if (!started) {
+			return;
+		}
+		if (endTime != clock_type::time_point()) {
+			resources.wallTime = endTime - startTime;
+		}
+
+		// FILETIME durations are counted in 100 nanosecond units
+		FILETIME cTime, eTime, kTime, uTime;
+		if (GetProcessTimes(process.hProcess, &cTime, &eTime, &kTime, &uTime)) {
+			resources.kernelTime = duration_type((static_cast<long long>(kTime.dwHighDateTime) << 32 | kTime.dwLowDateTime) * 100);
+			resources.userTime = duration_type((static_cast<long long>(uTime.dwHighDateTime) << 32 | uTime.dwLowDateTime) * 100);
+		}
+
+		// Windows does not separate minor and major faults, or count context switches per process
+		PROCESS_MEMORY_COUNTERS memory;
+		if (GetProcessMemoryInfo(process.hProcess, &memory, sizeof(memory))) {
+			resources.maxRss = memory.PeakWorkingSetSize;
+			resources.minorFaults = memory.PageFaultCount;
+		}
+
+		IO_COUNTERS io;
+		if (GetProcessIoCounters(process.hProcess, &io)) {
+			resources.readBytes = io.ReadTransferCount;
+			resources.writeBytes = io.WriteTransferCount;
+		}
+	}
+/// End Process::Operations
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+File: rm_Progress.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Reporter thread of rm::Progress, the status line and metrics file
+*/
+#include "rm_Progress.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <cmath>
+
+namespace rm {
+	namespace {
+		// Seconds a change in rate takes to mostly show in the smoothed rates
+		const double SMOOTHING = 10;
+
+		// Method: FormatSeconds
+		// Purpose: Writes seconds as h:mm:ss
+		void FormatSeconds(std::ostream& output, double seconds) {
+			unsigned long long whole = static_cast<unsigned long long>(seconds + 0.5);
+			output << whole / 3600 << ':' << std::setfill('0') << std::setw(2) << whole / 60 % 60
+				<< ':' << std::setw(2) << whole % 60 << std::setfill(' ');
+		}
+
+		// Method: WriteMetric
+		// Purpose: Writes the help, type and value of a metric without labels
+		void WriteMetric(std::ostream& output, char const* name, char const* type, char const* help, double value) {
+			output << "# HELP " << name << ' ' << help << '\n'
+				<< "# TYPE " << name << ' ' << type << '\n'
+				<< name << ' ';
+			if (std::isnan(value)) {
+				output << "NaN";
+			}
+			else {
+				output << value;
+			}
+			output << '\n';
+		}
+	}
+
+/// Begin Progress::Constructors
+	Progress::Progress()
+		: status(StatusMode::Auto), interval(DEFAULT_INTERVAL), total(0), running(0), done(0), failed(0), cached(0), retries(0),
+		showStatus(false), lastDone(0), lastCpu(0), rate(0), busy(0), lastWidth(0), metricsFailed(false), stopping(false) {
+
+	}
+
+	Progress::~Progress() {
+		Stop();
+	}
+/// End Progress::Constructors
+
+/// Begin Progress::Operations
+	// Method: Progress::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid progress setting
+	bool Progress::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "status") {
+			if (value == "auto") {
+				status = StatusMode::Auto;
+			}
+			else if (value == "on") {
+				status = StatusMode::On;
+			}
+			else if (value == "off") {
+				status = StatusMode::Off;
+			}
+			else {
+				return false;
+			}
+			return true;
+		}
+		if (key == "status_interval") {
+			// Faster than the timer wheel's tick would only burn CPU
+			return ParseDuration(value, interval) && interval >= std::chrono::milliseconds(10);
+		}
+		if (key == "metrics") {
+			if (value.empty()) {
+				return false;
+			}
+			metricsPath = ToNative(value);
+			return true;
+		}
+		return false;
+	}
+
+	// Method: Progress::Start
+	// Input: number of jobs in the batch
+	// Purpose: Starts the reporter thread if a status line or metrics file is wanted
+	void Progress::Start(size_type jobs) {
+		showStatus = status == StatusMode::On || (status == StatusMode::Auto && IsTerminal());
+		if (!showStatus && metricsPath.empty()) {
+			return;
+		}
+
+		total.store(jobs, std::memory_order_relaxed);
+		begin = lastTime = clock_type::now();
+		lastCpu = ChildCpuTime();
+
+		// The first metrics are written before any job starts, so a bad path is reported straight away
+		Refresh(Measure(), false);
+		if (metricsFailed) {
+			std::wcerr << L"Error: Metrics file " << ToWide(metricsPath) << L" could not be written, metrics are off." << std::endl;
+			metricsFailed = false;
+			metricsPath.clear();
+			if (!showStatus) {
+				return;
+			}
+		}
+
+		stopping = false;
+		thread = std::thread(&Progress::Report, this);
+	}
+
+	// Method: Progress::Stop
+	// Purpose: Reports the final counts and stops the reporter thread
+	void Progress::Stop() {
+		if (!thread.joinable()) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_one();
+		thread.join();
+
+		Refresh(Measure(), true);
+		if (metricsFailed) {
+			std::wcerr << L"Error: Metrics file " << ToWide(metricsPath) << L" could not be written." << std::endl;
+		}
+	}
+
+	// Method: Progress::Report
+	// Purpose: Body of the reporter thread, refreshes every interval until stopped
+	void Progress::Report() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+			lock.unlock();
+			Refresh(Measure(), false);
+			lock.lock();
+		}
+	}
+
+	// Method: Progress::Measure
+	// Output: Counters and rates as of now
+	Progress::Snapshot Progress::Measure() {
+		using seconds = std::chrono::duration<double>;
+
+		Snapshot snapshot;
+		snapshot.total = total.load(std::memory_order_relaxed);
+		snapshot.running = running.load(std::memory_order_relaxed);
+		snapshot.done = done.load(std::memory_order_relaxed);
+		snapshot.failed = failed.load(std::memory_order_relaxed);
+		snapshot.cached = cached.load(std::memory_order_relaxed);
+		snapshot.retries = retries.load(std::memory_order_relaxed);
+		snapshot.cpuSeconds = ChildCpuTime();
+
+		clock_type::time_point now = clock_type::now();
+		snapshot.elapsed = seconds(now - begin).count();
+		double window = seconds(now - lastTime).count();
+		if (window > 0) {
+			// Exponential moving averages, the first window is taken as is
+			double windowRate = static_cast<double>(snapshot.done - lastDone) / window;
+			double windowBusy = std::max(0.0, snapshot.cpuSeconds - lastCpu) / window;
+			double weight = lastDone == 0 && rate == 0 ? 1 : 1 - std::exp(-window / SMOOTHING);
+			rate += (windowRate - rate) * weight;
+			busy += (windowBusy - busy) * weight;
+			lastTime = now;
+			lastDone = snapshot.done;
+			lastCpu = snapshot.cpuSeconds;
+		}
+		snapshot.jobsPerSecond = rate;
+		snapshot.cpuBusy = busy;
+
+		// Cached jobs finish instantly and say nothing about how long the rest will take
+		size_type remaining = snapshot.total > snapshot.done ? snapshot.total - snapshot.done : 0;
+		size_type ran = snapshot.done - snapshot.cached;
+		snapshot.eta = remaining == 0 ? 0 : ran == 0 ? -1 : snapshot.elapsed / static_cast<double>(ran) * static_cast<double>(remaining);
+		return snapshot;
+	}
+
+	// Method: Progress::Refresh
+	// Input: snapshot to show, whether it is the last one
+	// Purpose: Redraws the status line and rewrites the metrics file
+	void Progress::Refresh(Snapshot const& snapshot, bool last) {
+		if (showStatus) {
+			size_type active = snapshot.done + snapshot.running;
+			std::ostringstream line;
+			line << '[';
+			FormatSeconds(line, snapshot.elapsed);
+			line << "] " << snapshot.done << '/' << snapshot.total << " done";
+			if (snapshot.failed > 0) {
+				line << " (" << snapshot.failed << " failed)";
+			}
+			line << ", " << snapshot.running << " running, " << (snapshot.total > active ? snapshot.total - active : 0) << " queued"
+				<< std::fixed << std::setprecision(2) << " | " << snapshot.jobsPerSecond << " jobs/s"
+				<< std::setprecision(1) << " | CPU " << snapshot.cpuBusy << " | ETA ";
+			if (snapshot.eta < 0) {
+				line << "--";
+			}
+			else {
+				FormatSeconds(line, snapshot.eta);
+			}
+
+			// Blank out whatever is left of a longer previous line
+			std::string text = line.str();
+			size_type width = text.size();
+			if (width < lastWidth) {
+				text.append(lastWidth - width, ' ');
+			}
+			lastWidth = width;
+			WriteStatus('\r' + text + (last ? "\n" : ""));
+		}
+		if (!metricsPath.empty()) {
+			WriteMetrics(snapshot);
+		}
+	}
+
+	// Method: Progress::WriteMetrics
+	// Purpose: Replaces the metrics file, renamed into place so scrapers never see half of it
+	void Progress::WriteMetrics(Snapshot const& snapshot) {
+		size_type active = snapshot.done + snapshot.running;
+		std::ostringstream output;
+		output << "# HELP batch_launcher_jobs Jobs of the batch by state.\n"
+			<< "# TYPE batch_launcher_jobs gauge\n"
+			<< "batch_launcher_jobs{state=\"queued\"} " << (snapshot.total > active ? snapshot.total - active : 0) << '\n'
+			<< "batch_launcher_jobs{state=\"running\"} " << snapshot.running << '\n'
+			<< "batch_launcher_jobs{state=\"done\"} " << snapshot.done << '\n';
+		WriteMetric(output, "batch_launcher_jobs_failed_total", "counter", "Jobs that failed on their last attempt.", static_cast<double>(snapshot.failed));
+		WriteMetric(output, "batch_launcher_jobs_cached_total", "counter", "Jobs completed from the result cache.", static_cast<double>(snapshot.cached));
+		WriteMetric(output, "batch_launcher_retries_total", "counter", "Attempts after the first.", static_cast<double>(snapshot.retries));
+		WriteMetric(output, "batch_launcher_jobs_per_second", "gauge", "Jobs completed per second, smoothed.", snapshot.jobsPerSecond);
+		WriteMetric(output, "batch_launcher_child_cpu_seconds_total", "counter", "CPU time used by the launched processes.", snapshot.cpuSeconds);
+		WriteMetric(output, "batch_launcher_child_cpus_busy", "gauge", "CPUs kept busy by the launched processes, smoothed.", snapshot.cpuBusy);
+		WriteMetric(output, "batch_launcher_elapsed_seconds", "gauge", "Time since the batch started.", snapshot.elapsed);
+		WriteMetric(output, "batch_launcher_eta_seconds", "gauge", "Estimated time until every job is done.", snapshot.eta < 0 ? std::nan("") : snapshot.eta);
+		WriteMetric(output, "batch_launcher_finished", "gauge", "1 once the batch has finished.", snapshot.total == snapshot.done ? 1 : 0);
+
+		native_string temporary = metricsPath + RM_TEXT(".tmp");
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file << output.str();
+		file.close();
+		std::error_code error;
+		if (!file || (std::filesystem::rename(temporary, metricsPath, error), error)) {
+			metricsFailed = true;
+		}
+	}
+/// End Progress::Operations
+}
@@ -0,0 +1,167 @@
+/*
+File: rm_Progress.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Live progress of a running batch
+		The scheduler only bumps relaxed atomic counters, a reporter thread turns them into
+		a terminal status line and a Prometheus text file that node agents can scrape
+*/
+#ifndef RM_PROGRESS_HEADER_GUARD
+#define RM_PROGRESS_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <string_view>
+
+namespace rm {
+	// When the status line is shown
+	enum class StatusMode : unsigned char {
+		// Only when stderr is a terminal
+		Auto,
+		On,
+		Off
+	};
+
+	class Progress {
+	public:		/// Types
+		using size_type = size_t;
+		using clock_type = std::chrono::steady_clock;
+		using duration_type = std::chrono::nanoseconds;
+
+		// Time between refreshes unless set otherwise
+		static constexpr std::chrono::seconds DEFAULT_INTERVAL = std::chrono::seconds(1);
+	private:
+		// Values derived by the reporter thread on each refresh
+		struct Snapshot {
+			size_type total, running, done, failed, cached, retries;
+			double elapsed;
+			double jobsPerSecond;
+			// Seconds of CPU used by the launcher's children, and how many CPUs they kept busy
+			double cpuSeconds;
+			double cpuBusy;
+			// Seconds until every job is done, negative while unknown
+			double eta;
+		};
+	private:	/// Variables
+		StatusMode status;
+		duration_type interval;
+		// Prometheus text file, empty for none
+		native_string metricsPath;
+
+		// Written by the scheduler, read by the reporter thread
+		std::atomic<size_type> total;
+		std::atomic<size_type> running;
+		std::atomic<size_type> done;
+		std::atomic<size_type> failed;
+		std::atomic<size_type> cached;
+		std::atomic<size_type> retries;
+
+		// Owned by the reporter thread
+		bool showStatus;
+		clock_type::time_point begin, lastTime;
+		size_type lastDone;
+		double lastCpu;
+		double rate;
+		double busy;
+		// Length of the last status line, so a shorter one can blank it out
+		size_type lastWidth;
+		// Set when the metrics file could not be replaced, reported by the launcher's thread
+		bool metricsFailed;
+
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable wake;
+		bool stopping;
+	public:		/// Methods
+		/// Constructors
+		Progress();
+
+		~Progress();
+
+		Progress(Progress const&) = delete;
+		Progress& operator=(Progress const&) = delete;
+
+		/// Operations
+		// Method: Progress::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid progress setting
+		//			status=auto|on|off status_interval=500ms metrics=/var/lib/node_exporter/batch.prom
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: Progress::Start
+		// Input: number of jobs in the batch
+		// Purpose: Starts the reporter thread if a status line or metrics file is wanted
+		void Start(size_type jobs);
+
+		// Method: Progress::Stop
+		// Purpose: Reports the final counts and stops the reporter thread
+		void Stop();
+
+		// Method: Progress::Launched
+		// Purpose: A job started running, retries and copies of a running job do not count
+		inline void Launched() {
+			running.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Method: Progress::Exited
+		// Purpose: A running job has no runs left, it may still be retried
+		inline void Exited() {
+			running.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		// Method: Progress::Retried
+		inline void Retried() {
+			retries.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Method: Progress::Completed
+		// Input: whether the job failed, whether it was completed from the result cache
+		inline void Completed(bool failure, bool fromCache) {
+			done.fetch_add(1, std::memory_order_relaxed);
+			if (failure) {
+				failed.fetch_add(1, std::memory_order_relaxed);
+			}
+			if (fromCache) {
+				cached.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	private:
+		// Method: Progress::Report
+		// Purpose: Body of the reporter thread, refreshes every interval until stopped
+		void Report();
+
+		// Method: Progress::Measure
+		// Output: Counters and rates as of now
+		Snapshot Measure();
+
+		// Method: Progress::Refresh
+		// Input: snapshot to show, whether it is the last one
+		// Purpose: Redraws the status line and rewrites the metrics file
+		void Refresh(Snapshot const& snapshot, bool last);
+
+		// Method: Progress::WriteMetrics
+		// Purpose: Replaces the metrics file, renamed into place so scrapers never see half of it
+		void WriteMetrics(Snapshot const& snapshot);
+
+		/// Platform specific, see rm_Progress_posix.cpp and rm_Progress_win32.cpp
+		// Method: Progress::IsTerminal
+		// Output: Whether stderr is a terminal
+		static bool IsTerminal();
+
+		// Method: Progress::WriteStatus
+		// Input: text to write to stderr as is
+		// Reason: Bypasses std::wcerr, which belongs to the scheduler thread
+		static void WriteStatus(std::string const& text);
+
+		// Method: Progress::ChildCpuTime
+		// Output: Seconds of CPU used by every child of the launcher, running or exited
+		static double ChildCpuTime();
+	};
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+File: rm_Progress_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::Progress
+		Exited children are counted by getrusage, Linux adds running children from /proc
+*/
+#ifndef _WIN32
+#include "rm_Progress.hpp"
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <unistd.h>
+#include <sys/resource.h>
+
+namespace rm {
+	namespace {
+		// Method: ToSeconds
+		double ToSeconds(timeval const& time) {
+			return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+		}
+
+#ifdef __linux__
+		// Method: RunningCpuTime
+		// Purpose: Seconds of CPU used so far by the children that have not been reaped,
+		//			including any of their own children they have waited for
+		double RunningCpuTime() {
+			static const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+			double seconds = 0;
+			std::error_code error;
+			for (std::filesystem::directory_iterator task("/proc/self/task", error), end; !error && task != end; task.increment(error)) {
+				std::ifstream children(task->path() / "children");
+				pid_t pid;
+				while (children >> pid) {
+					std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+					std::string line;
+					if (!std::getline(stat, line)) {
+						continue;
+					}
+
+					// The command may contain spaces, fields resume after its closing parenthesis
+					size_t close = line.rfind(')');
+					if (close == std::string::npos) {
+						continue;
+					}
+					std::istringstream fields(line.substr(close + 2));
+					std::string skipped;
+					// State is field 3, utime, stime, cutime and cstime are 14 to 17
+					for (int field = 3; field < 14; ++field) {
+						fields >> skipped;
+					}
+					unsigned long long utime = 0, stime = 0;
+					long long cutime = 0, cstime = 0;
+					if (fields >> utime >> stime >> cutime >> cstime) {
+						seconds += static_cast<double>(utime + stime + cutime + cstime) / ticks;
+					}
+				}
+			}
+			return seconds;
+		}
+#endif
+	}
+
+/// Begin Progress::Operations
+	// Method: Progress::IsTerminal
+	// Output: Whether stderr is a terminal
+	bool Progress::IsTerminal() {
+		return isatty(STDERR_FILENO) == 1;
+	}
+
+	// Method: Progress::WriteStatus
+	// Input: text to write to stderr as is
+	void Progress::WriteStatus(std::string const& text) {
+		size_t written = 0;
+		while (written < text.size()) {
+			ssize_t count = write(STDERR_FILENO, text.data() + written, text.size() - written);
+			if (count <= 0) {
+				return;
+			}
+			written += static_cast<size_t>(count);
+		}
+	}
+
+	// Method: Progress::ChildCpuTime
+	// Output: Seconds of CPU used by every child of the launcher, running or exited
+	double Progress::ChildCpuTime() {
+		rusage usage;
+		double seconds = getrusage(RUSAGE_CHILDREN, &usage) == 0 ? ToSeconds(usage.ru_utime) + ToSeconds(usage.ru_stime) : 0;
+#ifdef __linux__
+		seconds += RunningCpuTime();
+#endif
+		return seconds;
+	}
+/// End Progress::Operations
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+File: rm_Progress_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::Progress
+		The launcher joins a job object of its own, which its children inherit,
+		so the job's accounting covers running and exited children alike
+*/
+#ifdef _WIN32
+#include "rm_Progress.hpp"
+#include <Windows.h>
+#include <io.h>
+
+namespace rm {
+	namespace {
+		// Method: ToSeconds
+		double ToSeconds(LARGE_INTEGER const& time) {
+			// 100 nanosecond units
+			return static_cast<double>(time.QuadPart) / 1e7;
+		}
+
+		// Method: ToSeconds
+		double ToSeconds(FILETIME const& time) {
+			LARGE_INTEGER value;
+			value.LowPart = time.dwLowDateTime;
+			value.HighPart = static_cast<LONG>(time.dwHighDateTime);
+			return ToSeconds(value);
+		}
+
+		// Method: AccountingJob
+		// Purpose: Job holding the launcher and every child started after the first call, NULL if
+		//			the launcher could not join one, such as on Windows 7 inside another job
+		HANDLE AccountingJob() {
+			static HANDLE job = [] {
+				HANDLE created = CreateJobObject(NULL, NULL);
+				if (created != NULL && !AssignProcessToJobObject(created, GetCurrentProcess())) {
+					CloseHandle(created);
+					created = NULL;
+				}
+				return created;
+			}();
+			return job;
+		}
+	}
+
+/// Begin Progress::Operations
+	// Method: Progress::IsTerminal
+	// Output: Whether stderr is a terminal
+	bool Progress::IsTerminal() {
+		return _isatty(_fileno(stderr)) != 0;
+	}
+
+	// Method: Progress::WriteStatus
+	// Input: text to write to stderr as is
+	void Progress::WriteStatus(std::string const& text) {
+		DWORD written;
+		WriteFile(GetStdHandle(STD_ERROR_HANDLE), text.data(), static_cast<DWORD>(text.size()), &written, NULL);
+	}
+
+	// Method: Progress::ChildCpuTime
+	// Output: Seconds of CPU used by every child of the launcher, running or exited
+	double Progress::ChildCpuTime() {
+		JOBOBJECT_BASIC_ACCOUNTING_INFORMATION accounting;
+		HANDLE job = AccountingJob();
+		if (job == NULL || !QueryInformationJobObject(job, JobObjectBasicAccountingInformation, &accounting, sizeof(accounting), NULL)) {
+			return 0;
+		}
+
+		// The job holds the launcher too
+		FILETIME creation, exit, kernel, user;
+		double own = GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user) ? ToSeconds(kernel) + ToSeconds(user) : 0;
+		double seconds = ToSeconds(accounting.TotalUserTime) + ToSeconds(accounting.TotalKernelTime) - own;
+		return seconds > 0 ? seconds : 0;
+	}
+/// End Progress::Operations
+}
+#endif
@@ -0,0 +1,81 @@
+/*
+File: rm_Reaper.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Single event loop that learns about each child's exit as it happens
+		Linux uses pidfd and epoll, falling back to signalfd for SIGCHLD
+		Windows uses registered waits posting to an I/O completion port
+*/
+#ifndef RM_REAPER_HEADER_GUARD
+#define RM_REAPER_HEADER_GUARD
+#include "rm_Process.hpp"
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+
+namespace rm {
+	class Reaper {
+	public:		/// Types
+		using size_type = size_t;
+		using pointer_type = Process*;
+		using duration_type = std::chrono::milliseconds;
+	private:
+		// Bookkeeping for one watched process
+		struct Watch {
+			pointer_type proc;
+#ifdef _WIN32
+			HANDLE port;
+			HANDLE wait;
+#else
+			int pidfd;
+#endif
+		};
+	private:	/// Variables
+#ifdef _WIN32
+		HANDLE port;
+		std::unordered_map<pointer_type, Watch> watched;
+#else
+		int epoll;
+		// signalfd used when the kernel does not support pidfd_open, -1 otherwise
+		int signal;
+		std::unordered_map<pid_t, Watch> watched;
+#endif
+	public:		/// Methods
+		/// Constructors
+		Reaper();
+
+		~Reaper();
+
+		Reaper(Reaper const&) = delete;
+		Reaper& operator=(Reaper const&) = delete;
+
+		/// Operations
+		// Method: Reaper::Add
+		// Input: A process that has been started
+		// Output: Whether the process is now being watched
+		// Purpose: Report the process from Wait once it exits
+		bool Add(pointer_type proc);
+
+		// Method: Reaper::Wait
+		// Input: List to append exited processes to, longest time to block, negative for no limit
+		// Output: Number of processes appended
+		// Purpose: Blocks until at least one watched process exits or the timeout elapses
+		//			Exited processes are reaped immediately, recording their exit code and usage
+		size_type Wait(std::vector<pointer_type>& finished, duration_type timeout = duration_type(-1));
+
+		// Method: Reaper::Size
+		// Output: Number of processes being watched
+		inline size_type Size() {
+			return watched.size();
+		}
+
+		// Method: Reaper::Empty
+		// Output: Whether no processes are being watched
+		inline bool Empty() {
+			return watched.empty();
+		}
+	};
+}
+
+#endif
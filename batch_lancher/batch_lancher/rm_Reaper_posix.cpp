@@ -0,0 +1,206 @@
+/*
+File: rm_Reaper_posix.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: POSIX backend for rm::Reaper
+		Linux watches a pidfd per child with epoll, when pidfd_open is not
+		supported SIGCHLD is read from a signalfd in the same epoll set
+		Other systems poll with waitid
+*/
+#ifndef _WIN32
+#include "rm_Reaper.hpp"
+#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <thread>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace rm {
+	namespace {
+		// epoll user data used for the signalfd, pids are always positive
+		const uint64_t SIGNAL_EVENT = 0;
+
+		// Method: OpenPidfd
+		// Purpose: Wraps the pidfd_open system call, which older C libraries do not expose
+		// Output: pidfd or -1
+		int OpenPidfd(pid_t pid) {
+#if defined(__linux__) && defined(SYS_pidfd_open)
+			return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+			errno = ENOSYS;
+			return -1;
+#endif
+		}
+
+		// Method: ReapExited
+		// Purpose: Reaps every exited child that is being watched without blocking
+		// Input: watched processes, list to append exited processes to
+		// Reason: Children are checked one at a time so exits of processes that are
+		//			not watched here are left for their owner to reap
+		template <typename map_type>
+		void ReapExited(map_type& watched, std::vector<Process*>& finished) {
+			typename map_type::iterator watch = watched.begin();
+			while (watch != watched.end()) {
+				siginfo_t info = {};
+				if (waitid(P_PID, watch->first, &info, WEXITED | WNOHANG | WNOWAIT) == -1 || info.si_pid == 0) {
+					++watch;
+					continue;
+				}
+
+				// Closing the pidfd also removes it from the epoll set
+				if (watch->second.pidfd != -1) {
+					close(watch->second.pidfd);
+				}
+				watch->second.proc->Wait();
+				finished.push_back(watch->second.proc);
+				watch = watched.erase(watch);
+			}
+		}
+	}
+
+/// Begin Reaper::Constructors
+	Reaper::Reaper()
+		: epoll(-1), signal(-1) {
+#ifdef __linux__
+		epoll = epoll_create1(EPOLL_CLOEXEC);
+		if (epoll == -1) {
+			std::wcerr << L"Error: Could not create epoll instance." << std::endl;
+		}
+#endif
+	}
+
+	Reaper::~Reaper() {
+		for (std::unordered_map<pid_t, Watch>::value_type& watch : watched) {
+			if (watch.second.pidfd != -1) {
+				close(watch.second.pidfd);
+			}
+		}
+		if (signal != -1) {
+			close(signal);
+		}
+		if (epoll != -1) {
+			close(epoll);
+		}
+	}
+/// End Reaper::Constructors
+
+/// Begin Reaper::Operations
+	// Method: Reaper::Add
+	// Input: A process that has been started
+	// Output: Whether the process is now being watched
+	// Purpose: Report the process from Wait once it exits
+	bool Reaper::Add(pointer_type proc) {
+		if (!proc->DidRun()) {
+			return false;
+		}
+
+		Watch watch;
+		watch.proc = proc;
+		watch.pidfd = -1;
+		pid_t pid = proc->GetHandle();
+
+#ifdef __linux__
+		if (epoll != -1 && signal == -1) {
+			watch.pidfd = OpenPidfd(pid);
+			if (watch.pidfd != -1) {
+				epoll_event event = {};
+				event.events = EPOLLIN;
+				event.data.u64 = static_cast<uint64_t>(pid);
+				if (epoll_ctl(epoll, EPOLL_CTL_ADD, watch.pidfd, &event) == -1) {
+					close(watch.pidfd);
+					watch.pidfd = -1;
+				}
+			}
+		}
+
+		// Fall back to SIGCHLD once pidfd is not available
+		if (watch.pidfd == -1 && signal == -1 && epoll != -1) {
+			sigset_t mask;
+			sigemptyset(&mask);
+			sigaddset(&mask, SIGCHLD);
+			pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+			signal = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+			epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.u64 = SIGNAL_EVENT;
+			if (signal != -1 && epoll_ctl(epoll, EPOLL_CTL_ADD, signal, &event) == -1) {
+				close(signal);
+				signal = -1;
+			}
+		}
+#endif
+
+		watched[pid] = watch;
+		return true;
+	}
+
+	// Method: Reaper::Wait
+	// Input: List to append exited processes to, longest time to block, negative for no limit
+	// Output: Number of processes appended
+	// Purpose: Blocks until at least one watched process exits or the timeout elapses
+	//			Exited processes are reaped immediately, recording their exit code and usage
+	Reaper::size_type Reaper::Wait(std::vector<pointer_type>& finished, duration_type timeout) {
+		size_type before = finished.size();
+		if (watched.empty()) {
+			return 0;
+		}
+
+#ifdef __linux__
+		if (epoll != -1) {
+			// A signal may have arrived before SIGCHLD was blocked
+			if (signal != -1) {
+				ReapExited(watched, finished);
+				if (finished.size() > before) {
+					return finished.size() - before;
+				}
+			}
+
+			epoll_event events[64];
+			int count = epoll_wait(epoll, events, 64, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+			for (int i = 0; i < count; ++i) {
+				if (events[i].data.u64 == SIGNAL_EVENT) {
+					// Drain the signalfd, one SIGCHLD may stand for many exits
+					signalfd_siginfo info;
+					while (read(signal, &info, sizeof(info)) == sizeof(info)) {
+					}
+					ReapExited(watched, finished);
+					continue;
+				}
+
+				std::unordered_map<pid_t, Watch>::iterator found = watched.find(static_cast<pid_t>(events[i].data.u64));
+				if (found == watched.end()) {
+					continue;
+				}
+				epoll_ctl(epoll, EPOLL_CTL_DEL, found->second.pidfd, nullptr);
+				close(found->second.pidfd);
+				found->second.proc->Wait();
+				finished.push_back(found->second.proc);
+				watched.erase(found);
+			}
+			return finished.size() - before;
+		}
+#endif
+
+		// Portable fallback, poll until a process exits or the timeout elapses
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+		while (true) {
+			ReapExited(watched, finished);
+			if (finished.size() > before
+				|| (timeout.count() >= 0 && std::chrono::steady_clock::now() >= deadline)) {
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return finished.size() - before;
+	}
+/// End Reaper::Operations
+}
+#endif
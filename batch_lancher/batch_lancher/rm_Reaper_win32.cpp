@@ -0,0 +1,96 @@
+/*
+File: rm_Reaper_win32.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Windows backend for rm::Reaper
+		Each process handle is registered with the thread pool wait, which posts
+		to an I/O completion port when the process exits
+		There is no MAXIMUM_WAIT_OBJECTS limit on the number of processes watched
+*/
+#ifdef _WIN32
+#include "rm_Reaper.hpp"
+#include <iostream>
+#include <cstddef>
+
+namespace rm {
+	namespace {
+		// Method: OnExit
+		// Purpose: Thread pool callback, queues the exited process on the completion port
+		VOID CALLBACK OnExit(PVOID context, BOOLEAN) {
+			HANDLE port = *static_cast<HANDLE*>(context);
+			// The key is the address of the watch, which holds the process
+			PostQueuedCompletionStatus(port, 0, reinterpret_cast<ULONG_PTR>(context), NULL);
+		}
+	}
+
+/// Begin Reaper::Constructors
+	Reaper::Reaper() {
+		port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+		if (port == NULL) {
+			std::wcerr << L"Error: Could not create I/O completion port." << std::endl;
+		}
+	}
+
+	Reaper::~Reaper() {
+		for (std::unordered_map<pointer_type, Watch>::value_type& watch : watched) {
+			UnregisterWaitEx(watch.second.wait, INVALID_HANDLE_VALUE);
+		}
+		if (port != NULL) {
+			CloseHandle(port);
+		}
+	}
+/// End Reaper::Constructors
+
+/// Begin Reaper::Operations
+	// Method: Reaper::Add
+	// Input: A process that has been started
+	// Output: Whether the process is now being watched
+	// Purpose: Report the process from Wait once it exits
+	bool Reaper::Add(pointer_type proc) {
+		if (!proc->DidRun() || port == NULL) {
+			return false;
+		}
+
+		// Elements of an unordered_map keep their address, so the watch is the callback context
+		Watch& watch = watched[proc];
+		watch.proc = proc;
+		watch.port = port;
+		if (!RegisterWaitForSingleObject(&watch.wait, proc->GetHandle(), OnExit, &watch.port, INFINITE, WT_EXECUTEONLYONCE)) {
+			watched.erase(proc);
+			return false;
+		}
+		return true;
+	}
+
+	// Method: Reaper::Wait
+	// Input: List to append exited processes to, longest time to block, negative for no limit
+	// Output: Number of processes appended
+	// Purpose: Blocks until at least one watched process exits or the timeout elapses
+	//			Exited processes are reaped immediately, recording their exit code and usage
+	Reaper::size_type Reaper::Wait(std::vector<pointer_type>& finished, duration_type timeout) {
+		size_type before = finished.size();
+		if (watched.empty()) {
+			return 0;
+		}
+
+		OVERLAPPED_ENTRY entries[64];
+		ULONG count = 0;
+		DWORD wait = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+		if (!GetQueuedCompletionStatusEx(port, entries, 64, &count, wait, FALSE)) {
+			return 0;
+		}
+
+		for (ULONG i = 0; i < count; ++i) {
+			Watch* watch = reinterpret_cast<Watch*>(reinterpret_cast<char*>(entries[i].lpCompletionKey) - offsetof(Watch, port));
+			pointer_type proc = watch->proc;
+			UnregisterWaitEx(watch->wait, INVALID_HANDLE_VALUE);
+			proc->Wait();
+			finished.push_back(proc);
+			watched.erase(proc);
+		}
+		return finished.size() - before;
+	}
+/// End Reaper::Operations
+}
+#endif
@@ -0,0 +1,227 @@
+/*
+File: rm_Report.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Writes the results of a run as text, JSON Lines or CSV
+		Machine readable formats hold one row per process with full precision counters
+*/
+#include "rm_Report.hpp"
+#include "rm_lib.hpp"
+#include <string>
+
+namespace rm {
+	namespace {
+		using clock_type = Process::clock_type;
+
+		// Column names shared by the JSON Lines and CSV formats
+		wchar_t const* const COLUMNS[] = {
+			L"launchgroup", L"id", L"app", L"params", L"placement", L"stop_reason", L"copy", L"earlier_attempts", L"started", L"cached", L"exit_code", L"attempts",
+			L"start_ns", L"end_ns", L"expected_ns", L"wall_ns", L"user_ns", L"kernel_ns", L"spawn_latency_ns",
+			L"max_rss_bytes", L"minor_faults", L"major_faults",
+			L"voluntary_switches", L"involuntary_switches", L"read_bytes", L"write_bytes"
+		};
+		const size_t COLUMN_COUNT = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+		// Values of the stop_reason and copy columns, indexed by StopReason and CopyOutcome
+		wchar_t const* const STOP_REASONS[] = { L"", L"timeout", L"straggler" };
+		wchar_t const* const COPY_OUTCOMES[] = { L"", L"original_won", L"copy_won" };
+
+		// Method: WriteJsonString
+		// Purpose: Writes a quoted JSON string, anything outside printable ASCII is escaped
+		//			so the output is valid whatever encoding the stream uses
+		void WriteJsonString(std::wostream& outstream, std::wstring const& text) {
+			static wchar_t const HEX[] = L"0123456789abcdef";
+			outstream << L'"';
+			for (wchar_t ch : text) {
+				unsigned long cp = static_cast<unsigned long>(ch);
+				if (ch == L'"' || ch == L'\\') {
+					outstream << L'\\' << ch;
+				}
+				else if (cp >= 0x20 && cp < 0x7F) {
+					outstream << ch;
+				}
+				else {
+					// Characters outside the basic plane become surrogate pairs
+					unsigned long units[2] = { cp, 0 };
+					size_t count = 1;
+					if (cp > 0xFFFF) {
+						cp -= 0x10000;
+						units[0] = 0xD800 | (cp >> 10);
+						units[1] = 0xDC00 | (cp & 0x3FF);
+						count = 2;
+					}
+					for (size_t i = 0; i < count; ++i) {
+						outstream << L"\\u" << HEX[(units[i] >> 12) & 0xF] << HEX[(units[i] >> 8) & 0xF]
+							<< HEX[(units[i] >> 4) & 0xF] << HEX[units[i] & 0xF];
+					}
+				}
+			}
+			outstream << L'"';
+		}
+
+		// Method: WriteCsvString
+		// Purpose: Writes a CSV field, quoting it when it holds a separator, quote or line break
+		void WriteCsvString(std::wostream& outstream, std::wstring const& text) {
+			if (text.find_first_of(L",\"\r\n") == std::wstring::npos) {
+				outstream << text;
+				return;
+			}
+			outstream << L'"';
+			for (wchar_t ch : text) {
+				if (ch == L'"') {
+					outstream << L'"';
+				}
+				outstream << ch;
+			}
+			outstream << L'"';
+		}
+
+		// Method: Since
+		// Purpose: Nanoseconds from epoch to time, 0 for times that were never recorded
+		long long Since(clock_type::time_point epoch, clock_type::time_point time) {
+			if (time == clock_type::time_point()) {
+				return 0;
+			}
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+		}
+
+		// Method: DescribeAttempts
+		// Purpose: Lists the earlier runs of a retried process as exit_code:wall_ns, or "not_started"
+		std::wstring DescribeAttempts(Process& proc) {
+			std::wstring output;
+			for (Process::Attempt const& attempt : proc.GetAttempts()) {
+				if (!output.empty()) {
+					output += L';';
+				}
+				if (attempt.started) {
+					output += std::to_wstring(attempt.exitCode) + L':'
+						+ std::to_wstring(std::chrono::duration_cast<std::chrono::nanoseconds>(attempt.end - attempt.start).count());
+				}
+				else {
+					output += L"not_started";
+				}
+			}
+			return output;
+		}
+
+		// Method: WriteRow
+		// Purpose: Writes one process as a JSON object or a CSV row
+		void WriteRow(std::wostream& outstream, Process& proc, clock_type::time_point epoch, bool json) {
+			ResourceUsage usage = proc.GetResourceUsage();
+			std::wstring text[] = { ToWide(proc.GetId()), ToWide(proc.GetApp()), ToWide(proc.GetParams()),
+				proc.GetPlacement() == nullptr ? std::wstring() : proc.GetPlacement()->Describe(),
+				STOP_REASONS[static_cast<size_t>(proc.GetStopReason())],
+				COPY_OUTCOMES[static_cast<size_t>(proc.GetCopyOutcome())],
+				DescribeAttempts(proc) };
+			long long numbers[] = {
+				static_cast<long long>(proc.DidRun() ? proc.GetExitCode() : 0),
+				static_cast<long long>(proc.GetAttemptCount()),
+				Since(epoch, proc.GetStartTime()),
+				Since(epoch, proc.GetEndTime()),
+				proc.GetExpectedTime().count(),
+				usage.wallTime.count(),
+				usage.userTime.count(),
+				usage.kernelTime.count(),
+				proc.GetSpawnLatency().count(),
+				static_cast<long long>(usage.maxRss),
+				static_cast<long long>(usage.minorFaults),
+				static_cast<long long>(usage.majorFaults),
+				static_cast<long long>(usage.voluntarySwitches),
+				static_cast<long long>(usage.involuntarySwitches),
+				static_cast<long long>(usage.readBytes),
+				static_cast<long long>(usage.writeBytes)
+			};
+
+			size_t column = 0;
+			// Writes the separator and, for JSON, the key of the next column
+			auto separate = [&]() {
+				if (json) {
+					outstream << (column == 0 ? L"{\"" : L",\"") << COLUMNS[column] << L"\":";
+				}
+				else if (column != 0) {
+					outstream << L',';
+				}
+				++column;
+			};
+
+			separate();
+			outstream << proc.GetLaunchGroup();
+			for (std::wstring const& field : text) {
+				separate();
+				if (json) {
+					WriteJsonString(outstream, field);
+				}
+				else {
+					WriteCsvString(outstream, field);
+				}
+			}
+			separate();
+			outstream << (proc.DidRun() ? L"true" : L"false");
+			separate();
+			outstream << (proc.IsCached() ? L"true" : L"false");
+			for (long long number : numbers) {
+				separate();
+				outstream << number;
+			}
+			if (json) {
+				outstream << L'}';
+			}
+			outstream << L'\n';
+		}
+	}
+
+	// Method: ParseReportFormat
+	// Input: name of the format, output format
+	// Output: Whether the name was one of text, jsonl or csv
+	bool ParseReportFormat(std::string_view name, ReportFormat& format) {
+		if (name == "text") {
+			format = ReportFormat::Text;
+		}
+		else if (name == "jsonl") {
+			format = ReportFormat::JsonLines;
+		}
+		else if (name == "csv") {
+			format = ReportFormat::Csv;
+		}
+		else {
+			return false;
+		}
+		return true;
+	}
+
+	// Method: WriteReport
+	// Input: output stream, launcher that has run its processes, format to write
+	// Purpose: Writes the results of every process
+	//			Times are in nanoseconds, start_ns and end_ns are relative to the first process started
+	void WriteReport(std::wostream& outstream, Launcher& launcher, ReportFormat format) {
+		if (format == ReportFormat::Text) {
+			outstream << launcher;
+			return;
+		}
+
+		clock_type::time_point epoch = clock_type::time_point::max();
+		for (Process& proc : launcher.GetProcesses()) {
+			proc.ForEachJob([&epoch](Process& job) {
+				if (job.DidRun() && job.GetStartTime() < epoch) {
+					epoch = job.GetStartTime();
+				}
+			});
+		}
+
+		bool json = format == ReportFormat::JsonLines;
+		if (!json) {
+			for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+				outstream << (column == 0 ? L"" : L",") << COLUMNS[column];
+			}
+			outstream << L'\n';
+		}
+		// A sweep writes a row per job
+		for (Process& proc : launcher.GetProcesses()) {
+			proc.ForEachJob([&](Process& job) {
+				WriteRow(outstream, job, epoch, json);
+			});
+		}
+		outstream.flush();
+	}
+}
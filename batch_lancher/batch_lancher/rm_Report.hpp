@@ -0,0 +1,35 @@
+/*
+File: rm_Report.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Writes the results of a run as text, JSON Lines or CSV
+		Machine readable formats hold one row per process with full precision counters
+*/
+#ifndef RM_REPORT_HEADER_GUARD
+#define RM_REPORT_HEADER_GUARD
+#include "rm_Launcher.hpp"
+#include <ostream>
+#include <string_view>
+
+namespace rm {
+	// Formats a run can be reported in
+	enum class ReportFormat {
+		Text,
+		JsonLines,
+		Csv
+	};
+
+	// Method: ParseReportFormat
+	// Input: name of the format, output format
+	// Output: Whether the name was one of text, jsonl or csv
+	bool ParseReportFormat(std::string_view name, ReportFormat& format);
+
+	// Method: WriteReport
+	// Input: output stream, launcher that has run its processes, format to write
+	// Purpose: Writes the results of every process
+	//			Times are in nanoseconds, start_ns and end_ns are relative to the first process started
+	void WriteReport(std::wostream& outstream, Launcher& launcher, ReportFormat format);
+}
+
+#endif
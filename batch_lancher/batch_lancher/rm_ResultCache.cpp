@@ -0,0 +1,276 @@
+/*
+File: rm_ResultCache.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Skips processes whose command, inputs and environment are unchanged
+		Results are stored on disk under the SHA-256 of everything that can change them
+		Entries are directories holding the exit code, resources and captured output
+*/
+#include "rm_ResultCache.hpp"
+#include "rm_Sha256.hpp"
+#include "rm_lib.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <memory>
+
+#ifndef _WIN32
+extern char** environ;
+#endif
+
+namespace rm {
+	namespace {
+		// Changes whenever the key or entry layout changes, so old entries are never read
+		char const* const KEY_VERSION = "batch_launcher result 1";
+		native_char const* const RESULT_FILE = RM_TEXT("result");
+
+		// Method: ToBytes
+		// Purpose: UTF-8 form of native text, so keys match across platforms
+		std::string ToBytes(native_string_view text) {
+#ifdef _WIN32
+			return ToUtf8(std::wstring(text));
+#else
+			return std::string(text);
+#endif
+		}
+	}
+
+/// Begin ResultCache::Constructors
+	ResultCache::ResultCache()
+		: directoryReady(false) {
+
+	}
+
+	ResultCache::~ResultCache() {
+
+	}
+/// End ResultCache::Constructors
+
+/// Begin ResultCache::Operations
+	// Method: ResultCache::Lookup
+	// Input: process about to start, output capture it is registered with if any
+	// Output: Whether a stored result was restored into the process, it must not be started
+	// Purpose: Inputs are hashed now, after every prerequisite has finished writing them
+	bool ResultCache::Lookup(Process& proc, OutputCapture* capture) {
+		if (!Enabled() || !proc.IsCacheable()) {
+			return false;
+		}
+		++stats.lookups;
+
+		std::string key = Key(proc, capture);
+		std::filesystem::path entry = std::filesystem::path(directory) / key;
+		std::ifstream file(entry / RESULT_FILE);
+
+		// Every field must be present, anything else is treated as a miss
+		std::map<std::string, long long> fields;
+		std::string name;
+		long long value;
+		while (file >> name >> value) {
+			fields[name] = value;
+		}
+		static char const* const REQUIRED[] = {
+			"exit_code", "wall_ns", "user_ns", "kernel_ns", "max_rss_bytes", "minor_faults", "major_faults",
+			"voluntary_switches", "involuntary_switches", "read_bytes", "write_bytes"
+		};
+		for (char const* required : REQUIRED) {
+			if (fields.find(required) == fields.end()) {
+				pending[&proc] = key;
+				return false;
+			}
+		}
+
+		ResourceUsage usage = {};
+		usage.wallTime = Process::duration_type(fields["wall_ns"]);
+		usage.userTime = Process::duration_type(fields["user_ns"]);
+		usage.kernelTime = Process::duration_type(fields["kernel_ns"]);
+		usage.maxRss = static_cast<unsigned long long>(fields["max_rss_bytes"]);
+		usage.minorFaults = static_cast<unsigned long long>(fields["minor_faults"]);
+		usage.majorFaults = static_cast<unsigned long long>(fields["major_faults"]);
+		usage.voluntarySwitches = static_cast<unsigned long long>(fields["voluntary_switches"]);
+		usage.involuntarySwitches = static_cast<unsigned long long>(fields["involuntary_switches"]);
+		usage.readBytes = static_cast<unsigned long long>(fields["read_bytes"]);
+		usage.writeBytes = static_cast<unsigned long long>(fields["write_bytes"]);
+		proc.Restore(static_cast<Process::exit_code>(fields["exit_code"]), usage, false);
+		if (capture != nullptr) {
+			capture->Restore(&proc, entry.native());
+		}
+		++stats.hits;
+		return true;
+	}
+
+	// Method: ResultCache::Store
+	// Input: finished process, output capture it is registered with if any
+	// Purpose: Stores the result of a successful process that missed in Lookup
+	//			Called once captured output has been drained
+	void ResultCache::Store(Process& proc, OutputCapture* capture) {
+		std::unordered_map<pointer_type, std::string>::iterator found = pending.find(&proc);
+		if (found == pending.end()) {
+			return;
+		}
+		std::string key = found->second;
+		pending.erase(found);
+
+		// Failures are often transient, so they are always run again
+		if (!proc.DidRun() || proc.IsCached() || proc.IsResumed() || !proc.Succeded()) {
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::path root(directory);
+		if (!directoryReady) {
+			std::filesystem::create_directories(root, error);
+			if (error) {
+				std::wcerr << L"Error: Result cache " << ToWide(directory) << L" could not be created, results are not stored." << std::endl;
+				directory.clear();
+				return;
+			}
+			directoryReady = true;
+		}
+		std::filesystem::path entry = root / key;
+		if (std::filesystem::exists(entry, error)) {
+			// Stored by an identical process earlier in the run
+			return;
+		}
+
+		// Entries are written aside and renamed into place, so readers never see half an entry
+		std::filesystem::path partial = root / (key + ".partial"
+			+ std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+		std::filesystem::create_directory(partial, error);
+		bool written = !error;
+		if (written) {
+			ResourceUsage usage = proc.GetResourceUsage();
+			std::ofstream file(partial / RESULT_FILE, std::ios::trunc);
+			file << "exit_code " << static_cast<long long>(proc.GetExitCode()) << '\n'
+				<< "wall_ns " << usage.wallTime.count() << '\n'
+				<< "user_ns " << usage.userTime.count() << '\n'
+				<< "kernel_ns " << usage.kernelTime.count() << '\n'
+				<< "max_rss_bytes " << usage.maxRss << '\n'
+				<< "minor_faults " << usage.minorFaults << '\n'
+				<< "major_faults " << usage.majorFaults << '\n'
+				<< "voluntary_switches " << usage.voluntarySwitches << '\n'
+				<< "involuntary_switches " << usage.involuntarySwitches << '\n'
+				<< "read_bytes " << usage.readBytes << '\n'
+				<< "write_bytes " << usage.writeBytes << '\n';
+			file.close();
+			written = !file.fail() && (capture == nullptr || capture->Save(&proc, partial.native()));
+		}
+		if (written) {
+			std::filesystem::rename(partial, entry, error);
+			written = !error;
+		}
+		if (!written) {
+			// Another launcher may have stored the same result first
+			std::filesystem::remove_all(partial, error);
+			return;
+		}
+		++stats.stored;
+	}
+
+	// Method: ResultCache::Key
+	// Input: process to key, output capture it is registered with if any
+	// Output: Hexadecimal SHA-256 of the command, output mode, environment and input files
+	std::string ResultCache::Key(Process& proc, OutputCapture* capture) {
+		if (environment.empty()) {
+			environment = HashEnvironment();
+		}
+
+		Sha256 hash;
+		hash.Update(std::string(KEY_VERSION));
+		hash.Update(ToBytes(proc.GetCommand()));
+		// Only captured output is stored, so a result replays only into the same kind of capture
+		OutputMode mode = capture == nullptr ? OutputMode::Console : capture->GetMode(&proc);
+		hash.Update(std::to_string(static_cast<int>(mode)));
+		hash.Update(environment);
+		// Processes given an environment or working directory of their own are keyed by them too
+		if (proc.GetEnvironment() != nullptr) {
+			hash.Update(ToBytes(proc.GetEnvironment()->GetText()));
+		}
+		if (!proc.GetDirectory().empty()) {
+			hash.Update(ToBytes(proc.GetDirectory()));
+		}
+		for (native_string_view input : proc.GetInputs()) {
+			native_string path(input);
+			hash.Update(ToBytes(path));
+			hash.Update(HashFile(path));
+		}
+		return Sha256::ToHex(hash.Final());
+	}
+
+	// Method: ResultCache::HashEnvironment
+	// Output: Hexadecimal SHA-256 of the sorted environment and the working directory
+	std::string ResultCache::HashEnvironment() {
+		std::vector<std::string> variables;
+#ifdef _WIN32
+		wchar_t* block = GetEnvironmentStringsW();
+		if (block != NULL) {
+			for (wchar_t const* variable = block; *variable != L'\0'; variable += wcslen(variable) + 1) {
+				variables.push_back(ToUtf8(variable));
+			}
+			FreeEnvironmentStringsW(block);
+		}
+#else
+		for (char** variable = environ; *variable != nullptr; ++variable) {
+			variables.push_back(*variable);
+		}
+#endif
+		std::sort(variables.begin(), variables.end());
+
+		Sha256 hash;
+		std::error_code error;
+		hash.Update(ToBytes(std::filesystem::current_path(error).native()));
+		for (std::string const& variable : variables) {
+			hash.Update(variable);
+		}
+		return Sha256::ToHex(hash.Final());
+	}
+
+	// Method: ResultCache::HashFile
+	// Input: input file path
+	// Output: Hexadecimal SHA-256 of the file contents, "missing" when it can not be read
+	std::string ResultCache::HashFile(native_string const& path) {
+		std::error_code error;
+		std::filesystem::path file(path);
+		std::uintmax_t size = std::filesystem::file_size(file, error);
+		std::filesystem::file_time_type modified = error ? std::filesystem::file_time_type() : std::filesystem::last_write_time(file, error);
+		if (error) {
+			return "missing";
+		}
+
+		// Inputs shared by many processes are read once, unless a process rewrote them
+		FileDigest& cached = files[path];
+		if (!cached.digest.empty() && cached.size == size && cached.modified == modified) {
+			return cached.digest;
+		}
+
+		std::ifstream input(file, std::ios::binary);
+		if (!input) {
+			return "missing";
+		}
+		Sha256 hash;
+		std::unique_ptr<char[]> buffer(new char[64 * 1024]);
+		while (input) {
+			input.read(buffer.get(), 64 * 1024);
+			hash.Update(buffer.get(), static_cast<size_t>(input.gcount()));
+		}
+		cached.size = size;
+		cached.modified = modified;
+		cached.digest = Sha256::ToHex(hash.Final());
+		return cached.digest;
+	}
+/// End ResultCache::Operations
+
+/// Begin ResultCache::Operators
+	// Method: operator<<
+	// Input: output stream, Stats to print
+	// Purpose: Prints the hits and stores of a run
+	std::wostream& operator<<(std::wostream& lhs, ResultCache::Stats const& rhs) {
+		lhs << L"Result cache: " << rhs.hits << L" of " << rhs.lookups << L" processes restored, "
+			<< rhs.stored << L" results stored" << std::endl;
+		return lhs;
+	}
+/// End ResultCache::Operators
+}
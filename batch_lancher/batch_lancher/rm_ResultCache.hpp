@@ -0,0 +1,109 @@
+/*
+File: rm_ResultCache.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Skips processes whose command, inputs and environment are unchanged
+		Results are stored on disk under the SHA-256 of everything that can change them
+		Entries are directories holding the exit code, resources and captured output
+*/
+#ifndef RM_RESULTCACHE_HEADER_GUARD
+#define RM_RESULTCACHE_HEADER_GUARD
+#include "rm_Process.hpp"
+#include "rm_OutputCapture.hpp"
+#include <string>
+#include <unordered_map>
+#include <filesystem>
+#include <ostream>
+#include <cstdint>
+
+namespace rm {
+	class ResultCache {
+	public:		/// Types
+		using size_type = size_t;
+		using pointer_type = Process*;
+
+		// Summary of cache use during a run
+		struct Stats {
+			size_type lookups = 0;
+			size_type hits = 0;
+			size_type stored = 0;
+		};
+	private:
+		// Digest of an input file, reused while its size and modification time are unchanged
+		struct FileDigest {
+			std::uintmax_t size = 0;
+			std::filesystem::file_time_type modified;
+			std::string digest;
+		};
+	private:	/// Variables
+		// Store directory, empty when caching is off
+		native_string directory;
+		bool directoryReady;
+		// Digest of the environment and working directory, computed on first lookup
+		std::string environment;
+		std::unordered_map<native_string, FileDigest> files;
+		// Process that missed to the key its result is stored under
+		std::unordered_map<pointer_type, std::string> pending;
+		Stats stats;
+	public:		/// Methods
+		/// Constructors
+		ResultCache();
+
+		~ResultCache();
+
+		/// Operations
+		// Method: ResultCache::SetDirectory
+		// Input: Directory results are stored in, created when the first result is stored
+		inline void SetDirectory(native_string_view path) {
+			directory = native_string(path);
+			directoryReady = false;
+		}
+
+		// Method: ResultCache::Enabled
+		// Output: Whether a store directory has been set
+		inline bool Enabled() {
+			return !directory.empty();
+		}
+
+		// Method: ResultCache::GetStats
+		// Output: Summary of cache use so far
+		inline Stats const& GetStats() {
+			return stats;
+		}
+
+		// Method: ResultCache::Lookup
+		// Input: process about to start, output capture it is registered with if any
+		// Output: Whether a stored result was restored into the process, it must not be started
+		// Purpose: Inputs are hashed now, after every prerequisite has finished writing them
+		bool Lookup(Process& proc, OutputCapture* capture);
+
+		// Method: ResultCache::Store
+		// Input: finished process, output capture it is registered with if any
+		// Purpose: Stores the result of a successful process that missed in Lookup
+		//			Called once captured output has been drained
+		void Store(Process& proc, OutputCapture* capture);
+	private:
+		// Method: ResultCache::Key
+		// Input: process to key, output capture it is registered with if any
+		// Output: Hexadecimal SHA-256 of the command, output mode, environment and input files
+		std::string Key(Process& proc, OutputCapture* capture);
+
+		// Method: ResultCache::HashEnvironment
+		// Output: Hexadecimal SHA-256 of the sorted environment and the working directory
+		std::string HashEnvironment();
+
+		// Method: ResultCache::HashFile
+		// Input: input file path
+		// Output: Hexadecimal SHA-256 of the file contents, "missing" when it can not be read
+		std::string HashFile(native_string const& path);
+	};
+
+	/// Operators
+	// Method: operator<<
+	// Input: output stream, Stats to print
+	// Purpose: Prints the hits and stores of a run
+	std::wostream& operator<<(std::wostream& lhs, ResultCache::Stats const& rhs);
+}
+
+#endif
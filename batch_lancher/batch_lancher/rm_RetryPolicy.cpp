@@ -0,0 +1,131 @@
+/*
+File: rm_RetryPolicy.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Parses and merges the retry policy of a launchgroup
+*/
+#include "rm_RetryPolicy.hpp"
+#include <algorithm>
+
+namespace rm {
+/// Begin RetryPolicy::Operations
+	// Method: RetryPolicy::Merge
+	// Input: Settings of the launcher
+	// Purpose: Copies every setting this launchgroup does not set itself
+	void RetryPolicy::Merge(RetryPolicy const& defaults) {
+		if (attempts == 0) {
+			attempts = defaults.attempts;
+		}
+		if (backoff == duration_type::zero()) {
+			backoff = defaults.backoff;
+		}
+		if (backoffMax == duration_type::zero()) {
+			backoffMax = defaults.backoffMax;
+		}
+		if (!hasRetryOn) {
+			hasRetryOn = defaults.hasRetryOn;
+			onStart = defaults.onStart;
+			exitCodes = defaults.exitCodes;
+		}
+	}
+
+	// Method: RetryPolicy::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid retry setting
+	bool RetryPolicy::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "attempts") {
+			return ParseUnsigned(value, attempts) && attempts > 0;
+		}
+		if (key == "backoff") {
+			return ParseDuration(value, backoff) && backoff > duration_type::zero();
+		}
+		if (key == "backoff_max") {
+			return ParseDuration(value, backoffMax) && backoffMax > duration_type::zero();
+		}
+		if (key == "retry_on") {
+			// Entries are separated by ';' as ',' separates columns
+			hasRetryOn = true;
+			onStart = false;
+			exitCodes.clear();
+			if (value == "any") {
+				hasRetryOn = false;
+				return true;
+			}
+			while (!value.empty()) {
+				size_t end = value.find(';');
+				std::string_view entry = value.substr(0, end);
+				value = end == std::string_view::npos ? std::string_view() : value.substr(end + 1);
+
+				size_t code;
+				if (entry == "start") {
+					onStart = true;
+				}
+				else if (ParseUnsigned(entry, code)) {
+					exitCodes.push_back(static_cast<long long>(code));
+				}
+				else {
+					return false;
+				}
+			}
+			return onStart || !exitCodes.empty();
+		}
+		return false;
+	}
+
+	// Method: RetryPolicy::Describe
+	// Output: The settings that are set, in batch file form
+	std::string RetryPolicy::Describe() const {
+		// Durations are written in milliseconds with every nanosecond kept
+		auto duration = [](duration_type time) {
+			long long nanoseconds = time.count();
+			std::string fraction = std::to_string(1000000 + nanoseconds % 1000000).substr(1);
+			return std::to_string(nanoseconds / 1000000) + "." + fraction + "ms";
+		};
+		std::string output;
+		if (attempts != 0) {
+			output += " attempts=" + std::to_string(attempts);
+		}
+		if (backoff != duration_type::zero()) {
+			output += " backoff=" + duration(backoff);
+		}
+		if (backoffMax != duration_type::zero()) {
+			output += " backoff_max=" + duration(backoffMax);
+		}
+		if (hasRetryOn) {
+			std::string entries = onStart ? ";start" : "";
+			for (long long code : exitCodes) {
+				entries += ";" + std::to_string(code);
+			}
+			output += " retry_on=" + entries.substr(1);
+		}
+		return output.empty() ? output : output.substr(1);
+	}
+
+	// Method: RetryPolicy::Matches
+	// Input: Whether the process started, its exit code
+	// Output: Whether the failure is one that is retried
+	bool RetryPolicy::Matches(bool started, long long exitCode) const {
+		if (!hasRetryOn) {
+			return true;
+		}
+		if (!started) {
+			return onStart;
+		}
+		return std::find(exitCodes.begin(), exitCodes.end(), exitCode) != exitCodes.end();
+	}
+
+	// Method: RetryPolicy::Backoff
+	// Input: Attempts made so far
+	// Output: Wait before the next attempt
+	RetryPolicy::duration_type RetryPolicy::Backoff(size_type made) const {
+		duration_type wait = backoff > duration_type::zero() ? backoff : duration_type(DEFAULT_BACKOFF);
+		duration_type longest = backoffMax > duration_type::zero() ? backoffMax : duration_type(DEFAULT_BACKOFF_MAX);
+		// Doubled for every attempt after the first, stopping before it could overflow
+		for (size_type i = 1; i < made && wait < longest; ++i) {
+			wait *= 2;
+		}
+		return std::min(wait, longest);
+	}
+/// End RetryPolicy::Operations
+}
@@ -0,0 +1,66 @@
+/*
+File: rm_RetryPolicy.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: When and how soon a failed process of a launchgroup is run again
+		Retries wait out an exponential backoff while other processes keep running
+*/
+#ifndef RM_RETRYPOLICY_HEADER_GUARD
+#define RM_RETRYPOLICY_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rm {
+	struct RetryPolicy {
+		using size_type = size_t;
+		using duration_type = std::chrono::nanoseconds;
+
+		// Backoff used when neither the launchgroup nor launcher set it
+		static constexpr std::chrono::seconds DEFAULT_BACKOFF = std::chrono::seconds(1);
+		static constexpr std::chrono::seconds DEFAULT_BACKOFF_MAX = std::chrono::seconds(60);
+
+		// Most times a process is run, 0 if not set, which runs it once
+		size_type attempts = 0;
+		// Wait before the first retry, doubled for each one after, zero if not set
+		duration_type backoff = duration_type::zero();
+		// Longest wait between attempts, zero if not set
+		duration_type backoffMax = duration_type::zero();
+		// Whether retry_on was set, every failure is retried otherwise
+		bool hasRetryOn = false;
+		// Retry processes that could not be started
+		bool onStart = false;
+		// Exit codes that are retried
+		std::vector<long long> exitCodes;
+
+		// Method: RetryPolicy::Merge
+		// Input: Settings of the launcher
+		// Purpose: Copies every setting this launchgroup does not set itself
+		void Merge(RetryPolicy const& defaults);
+
+		// Method: RetryPolicy::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid retry setting
+		//			attempts=3 backoff=500ms backoff_max=30s retry_on=start;1;137
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: RetryPolicy::Describe
+		// Output: The settings that are set, in batch file form
+		std::string Describe() const;
+
+		// Method: RetryPolicy::Matches
+		// Input: Whether the process started, its exit code
+		// Output: Whether the failure is one that is retried
+		bool Matches(bool started, long long exitCode) const;
+
+		// Method: RetryPolicy::Backoff
+		// Input: Attempts made so far
+		// Output: Wait before the next attempt
+		duration_type Backoff(size_type made) const;
+	};
+}
+
+#endif
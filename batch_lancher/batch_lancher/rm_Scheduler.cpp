@@ -0,0 +1,1017 @@
+/*
+File: rm_Scheduler.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Runs the processes of every launchgroup as a dependency graph
+		A process starts as soon as its own prerequisites have finished
+		Ready processes of a launchgroup start longest predicted run time first
+		Automatic placements pin each running process to the CPUs of its slot
+		Timeouts, stragglers and retry backoff are handled by a timer wheel in the same event loop
+		Starts of a launchgroup are held back while the system is under more pressure than it tolerates
+		Jobs of a sweep are expanded one at a time as slots free up, into nodes reused once they finish
+		Jobs connected by pipes start together as one pipeline once every stage of it is ready
+		The run can be written to a timeline trace, with a track per slot
+*/
+#include "rm_Scheduler.hpp"
+#include "rm_lib.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+
+namespace rm {
+/// Begin Scheduler::Constructors
+	Scheduler::Scheduler(group_map& groups, size_type limit, OutputCapture* capture, ResultCache* cache, CpuLayout* layout, Progress* progress, Journal* journal, PressureMonitor* pressure, Trace* trace)
+		: groups(groups), limit(limit), capture(capture), cache(cache), layout(layout), progress(progress), journal(journal),
+		pressure(pressure), trace(trace), timers(clock_type::now()) {
+		if (this->limit == 0) {
+			this->limit = 1;
+		}
+		if (trace != nullptr && !trace->Enabled()) {
+			this->trace = nullptr;
+		}
+		if (layout != nullptr || this->trace != nullptr) {
+			for (size_type slot = 0; slot < this->limit; ++slot) {
+				freeSlots.insert(freeSlots.end(), slot);
+			}
+		}
+	}
+
+	Scheduler::~Scheduler() {
+
+	}
+/// End Scheduler::Constructors
+
+/// Begin Scheduler::Operations
+	// Method: Scheduler::Run
+	// Purpose: Starts every process once its prerequisites finish and waits for all of them
+	void Scheduler::Run() {
+		clock_type::time_point begin = clock_type::now();
+		Build();
+
+		std::vector<Process*> finished;
+		std::vector<TimerWheel::Timer> expired;
+		duration_type waiting = duration_type::zero();
+		while (true) {
+			StartReady();
+			if (reaper.Empty() && backingOff == 0) {
+				break;
+			}
+
+			// React to each process as soon as it exits, waking for the next deadline
+			// and to sample the pressure again while starts are held back
+			finished.clear();
+			clock_type::time_point waitBegin = clock_type::now();
+			std::chrono::milliseconds timeout = timers.UntilNext(waitBegin);
+			if (!throttled.empty()) {
+				std::chrono::milliseconds sample = std::chrono::ceil<std::chrono::milliseconds>(pressure->GetInterval());
+				timeout = timeout < std::chrono::milliseconds::zero() ? sample : std::min(timeout, sample);
+			}
+			if (reaper.Empty()) {
+				// Only retries are left, sleep until the first of them is due
+				std::this_thread::sleep_for(timeout);
+			}
+			else {
+				reaper.Wait(finished, timeout);
+			}
+			clock_type::time_point now = clock_type::now();
+			waiting += now - waitBegin;
+			for (Process* proc : finished) {
+				Finished(proc, now);
+			}
+
+			expired.clear();
+			timers.Expire(now, expired);
+			for (TimerWheel::Timer const& timer : expired) {
+				Fire(timer, now);
+			}
+		}
+
+		// Relays end with the last of their producers
+		pipes.Finish();
+		stats.pipelines = pipelines.size();
+		stats.pipes = pipes.GetPipeCount();
+		stats.relayed = pipes.GetRelayedBytes();
+
+		// Starts still held back when the batch ended count until then
+		for (std::map<size_type, clock_type::time_point>::value_type const& held : throttled) {
+			groups[held.first].NoteThrottled(clock_type::now() - held.second);
+		}
+		throttled.clear();
+
+		// Stragglers whose copy finished first take its results and output
+		for (Node& node : nodes) {
+			if (node.copy != nullptr && node.proc->GetCopyOutcome() == CopyOutcome::CopyWon) {
+				node.proc->Adopt(*node.copy);
+				if (capture != nullptr) {
+					capture->Swap(node.proc, node.copy);
+				}
+			}
+		}
+
+		// Summarise the run
+		stats.overhead = clock_type::now() - begin - waiting - launching;
+		clock_type::time_point end = begin;
+		for (Node& node : nodes) {
+			if (node.proc == nullptr || node.sweep != NONE) {
+				continue;
+			}
+			if (node.proc->GetSweep() != nullptr) {
+				// Jobs of a sweep are counted from their results, their nodes were reused
+				Sweep* sweep = node.proc->GetSweep();
+				for (size_type job = 0; job < sweep->GetCount(); ++job) {
+					SweepResult result = sweep->GetResult(job);
+					++stats.jobs;
+					if ((result.state & SweepResult::DONE) == 0) {
+						++stats.unscheduled;
+						continue;
+					}
+					if ((result.state & SweepResult::RESUMED) != 0) {
+						++stats.resumed;
+					}
+					else if ((result.state & SweepResult::CACHED) != 0) {
+						++stats.cached;
+					}
+					else if ((result.state & SweepResult::STARTED) != 0) {
+						++stats.started;
+					}
+					if (result.stopReason == static_cast<std::uint8_t>(StopReason::Timeout)) {
+						++stats.timedOut;
+					}
+					stats.retries += result.attempts - 1;
+					if (result.attempts > 1 && (result.state & SweepResult::STARTED) != 0 && result.exitCode == EXIT_SUCCESS) {
+						++stats.recovered;
+					}
+					stats.busyTime += duration_type(result.end - result.start);
+				}
+				if (node.done) {
+					stats.criticalPath = std::max(stats.criticalPath, node.pathEnd);
+					end = std::max(end, node.finish);
+				}
+				continue;
+			}
+			++stats.jobs;
+			if (!node.done) {
+				++stats.unscheduled;
+				continue;
+			}
+			if (node.resumed) {
+				++stats.resumed;
+			}
+			else if (node.proc->IsCached()) {
+				++stats.cached;
+			}
+			else if (node.proc->DidRun()) {
+				++stats.started;
+			}
+			if (node.proc->GetStopReason() == StopReason::Timeout) {
+				++stats.timedOut;
+			}
+			else if (node.proc->GetStopReason() == StopReason::Straggler) {
+				++stats.stragglers;
+			}
+			stats.retries += node.proc->GetAttemptCount() - 1;
+			if (node.proc->GetAttemptCount() > 1 && node.proc->DidRun() && node.proc->Succeded()) {
+				++stats.recovered;
+			}
+			if (node.copy != nullptr) {
+				++stats.copies;
+				if (node.proc->GetCopyOutcome() == CopyOutcome::CopyWon) {
+					++stats.copiesWon;
+				}
+			}
+			stats.busyTime += node.finish - node.start;
+			stats.criticalPath = std::max(stats.criticalPath, node.pathEnd);
+			end = std::max(end, node.finish);
+		}
+		stats.slots = limit;
+		stats.makespan = end - begin;
+		stats.idleTime = stats.makespan * static_cast<long long>(limit) - stats.busyTime;
+		if (stats.idleTime < duration_type::zero()) {
+			stats.idleTime = duration_type::zero();
+		}
+
+		if (stats.unscheduled > 0) {
+			std::wcerr << L"Error: " << stats.unscheduled
+				<< L" processes were not run because their dependencies form a cycle." << std::endl;
+		}
+	}
+
+	// Method: Scheduler::Build
+	// Purpose: Creates a node per process and launchgroup and links them
+	//			Processes without dependencies depend on the previous launchgroup
+	void Scheduler::Build() {
+		std::map<native_string_view, size_type> ids;
+
+		// Create nodes, each launchgroup waits for all of its processes
+		for (group_map::value_type& group : groups) {
+			if (group.second.Empty()) {
+				continue;
+			}
+			size_type groupNode = nodes.size();
+			nodes.emplace_back();
+			nodes[groupNode].group = group.first;
+			groupNodes[group.first] = groupNode;
+
+			// Processes without a prediction are expected to take as long as the rest of the group
+			duration_type known = duration_type::zero();
+			size_type predicted = 0;
+			for (Process& proc : group.second) {
+				if (proc.GetExpectedTime() > duration_type::zero()) {
+					known += proc.GetExpectedTime();
+					++predicted;
+				}
+			}
+			duration_type fallback = predicted == 0 ? duration_type::zero() : known / static_cast<duration_type::rep>(predicted);
+
+			for (Process& proc : group.second) {
+				size_type node = nodes.size();
+				nodes.emplace_back();
+				nodes[node].proc = &proc;
+				nodes[node].remaining = proc.GetSweep() == nullptr ? 0 : proc.GetSweep()->GetCount();
+				nodes[node].group = group.first;
+				nodes[node].expected = proc.GetExpectedTime() > duration_type::zero() ? proc.GetExpectedTime() : fallback;
+				Link(node, groupNode);
+
+				if (!proc.GetId().empty() && !ids.insert(std::make_pair(proc.GetId(), node)).second) {
+					std::wcerr << L"Error: Duplicate job id " << ToWide(proc.GetId()) << L", only the first is used." << std::endl;
+				}
+			}
+		}
+
+		Connect(ids);
+
+		// Link processes to their prerequisites
+		size_type previousGroup = nodes.size();
+		size_type currentGroup = nodes.size();
+		for (size_type node = 0; node < nodes.size(); ++node) {
+			Process* proc = nodes[node].proc;
+			if (proc == nullptr) {
+				previousGroup = currentGroup;
+				currentGroup = node;
+				continue;
+			}
+
+			// Degenerate case, wait for the whole of the previous launchgroup
+			if (proc->GetDependencies().empty()) {
+				if (previousGroup < nodes.size()) {
+					Link(previousGroup, node);
+				}
+				continue;
+			}
+
+			for (native_string_view dependency : proc->GetDependencies()) {
+				size_type from = nodes.size();
+				size_t key;
+				if (dependency.compare(0, 6, RM_TEXT("group:")) == 0 && ParseUnsigned(dependency.substr(6), key)) {
+					std::map<size_type, size_type>::iterator found = groupNodes.find(key);
+					if (found != groupNodes.end()) {
+						from = found->second;
+					}
+				}
+				else {
+					std::map<native_string_view, size_type>::iterator found = ids.find(dependency);
+					if (found != ids.end()) {
+						from = found->second;
+					}
+				}
+
+				if (from == nodes.size()) {
+					std::wcerr << L"Error: Unknown dependency " << ToWide(dependency) << L" for " << ToWide(proc->GetApp()) << L", ignored." << std::endl;
+				}
+				else if (nodes[node].pipeline != NONE && nodes[from].pipeline == nodes[node].pipeline) {
+					std::wcerr << L"Error: " << ToWide(proc->GetApp()) << L" waits for " << ToWide(dependency)
+						<< L", but stages of a pipeline run together, ignored." << std::endl;
+				}
+				else if (from != node && from != currentGroup) {
+					Link(from, node);
+				}
+			}
+		}
+
+		// Anything without prerequisites may start immediately
+		for (size_type node = 0; node < nodes.size(); ++node) {
+			if (nodes[node].proc != nullptr && nodes[node].pending == 0) {
+				Ready(node);
+			}
+		}
+	}
+
+	// Method: Scheduler::Connect
+	// Purpose: Resolves the pipe sources of every process into pipelines
+	//			Sources must be single jobs of the same launchgroup, which runs its stages side by side
+	void Scheduler::Connect(std::map<native_string_view, size_type> const& ids) {
+		// Processes joined by pipes form one pipeline, rooted at its first stage
+		std::vector<size_type> roots(nodes.size());
+		for (size_type node = 0; node < roots.size(); ++node) {
+			roots[node] = node;
+		}
+		auto find = [&roots](size_type node) {
+			while (roots[node] != node) {
+				node = roots[node] = roots[roots[node]];
+			}
+			return node;
+		};
+
+		std::vector<std::pair<size_type, size_type>> connections;
+		for (size_type node = 0; node < nodes.size(); ++node) {
+			Process* proc = nodes[node].proc;
+			if (proc == nullptr || proc->GetSourceList().empty()) {
+				continue;
+			}
+			bool connected = false;
+			for (native_string_view source : proc->GetSources()) {
+				std::map<native_string_view, size_type>::const_iterator found = ids.find(source);
+				if (found == ids.end()) {
+					std::wcerr << L"Error: Unknown pipe source " << ToWide(source) << L" for " << ToWide(proc->GetApp()) << L", ignored." << std::endl;
+					continue;
+				}
+				size_type from = found->second;
+				if (from == node) {
+					std::wcerr << L"Error: " << ToWide(proc->GetApp()) << L" cannot read its own output, ignored." << std::endl;
+				}
+				else if (nodes[from].group != nodes[node].group) {
+					// Launchgroups run one after another, so the producer would fill its pipe and never finish
+					std::wcerr << L"Error: " << ToWide(proc->GetApp()) << L" reads the output of " << ToWide(source)
+						<< L" from another launchgroup, stages of a pipeline must share one, ignored." << std::endl;
+				}
+				else if (proc->GetSweep() != nullptr || nodes[from].proc->GetSweep() != nullptr) {
+					std::wcerr << L"Error: Jobs of a sweep cannot be piped, " << ToWide(proc->GetApp()) << L" does not read " << ToWide(source) << L"." << std::endl;
+				}
+				else {
+					connections.emplace_back(from, node);
+					size_type lhs = find(from), rhs = find(node);
+					roots[std::max(lhs, rhs)] = std::min(lhs, rhs);
+					connected = true;
+				}
+			}
+			// A consumer left without sources would read the launcher's stdin, or wait on the terminal
+			if (!connected && !pipes.Disconnect(proc)) {
+				std::wcerr << L"Error: " << ToWide(proc->GetApp()) << L" has no pipe source left and could not be given an empty input." << std::endl;
+			}
+		}
+
+		for (std::pair<size_type, size_type> const& connection : connections) {
+			size_type root = find(connection.first);
+			if (nodes[root].pipeline == NONE) {
+				nodes[root].pipeline = pipelines.size();
+				pipelines.emplace_back();
+			}
+			pipelines[nodes[root].pipeline].connections.emplace_back(nodes[connection.first].proc, nodes[connection.second].proc);
+		}
+		for (size_type node = 0; node < nodes.size(); ++node) {
+			size_type root = find(node);
+			if (nodes[root].pipeline == NONE) {
+				continue;
+			}
+			nodes[node].pipeline = nodes[root].pipeline;
+			pipelines[nodes[node].pipeline].stages.push_back(node);
+			// What a stage writes depends on the other stages, not only on its own inputs
+			nodes[node].proc->SetCacheable(false);
+		}
+	}
+
+	// Method: Scheduler::Link
+	// Purpose: Makes node 'to' wait for node 'from'
+	void Scheduler::Link(size_type from, size_type to) {
+		nodes[from].dependents.push_back(to);
+		++nodes[to].pending;
+	}
+
+	// Method: Scheduler::StartReady
+	// Purpose: Starts ready processes until the limits are reached
+	void Scheduler::StartReady() {
+		// Copies go first, their stragglers are already holding up a launchgroup
+		while (!pendingCopies.empty() && reaper.Size() < limit) {
+			size_type node = pendingCopies.front();
+			pendingCopies.pop_front();
+			StartCopy(node);
+		}
+
+		bool progress = true;
+		while (progress && reaper.Size() < limit) {
+			progress = false;
+			for (std::map<size_type, std::priority_queue<ReadyEntry>>::value_type& queue : ready) {
+				LaunchGroup& group = groups[queue.first];
+				size_type& groupCount = groupRunning[queue.first];
+
+				while (!queue.second.empty() && reaper.Size() < limit
+					&& (group.GetConcurrency() == 0 || groupCount < group.GetConcurrency())) {
+					// Nothing running means nothing of the batch's own to wait for, so it always makes progress
+					if (pressure != nullptr && !Admit(queue.first, group, reaper.Empty())) {
+						break;
+					}
+					size_type node = queue.second.top().node;
+					if (nodes[node].pipeline != NONE) {
+						// A pipeline waits for a slot for every stage, unless nothing is running that could free one
+						size_type stages = pipelines[nodes[node].pipeline].stages.size();
+						if (!reaper.Empty() && (reaper.Size() + stages > limit
+							|| (group.GetConcurrency() != 0 && groupCount + stages > group.GetConcurrency()))) {
+							break;
+						}
+						queue.second.pop();
+						progress = true;
+						StartPipeline(nodes[node].pipeline);
+						continue;
+					}
+					queue.second.pop();
+					progress = true;
+
+					// A sweep hands out its next job and stays queued while it has more
+					if (nodes[node].proc->GetSweep() != nullptr) {
+						if (nodes[node].job == 0) {
+							nodes[node].start = clock_type::now();
+						}
+						if (nodes[node].remaining == 0) {
+							// Every job went to other launchers
+							Complete(node, clock_type::now());
+							continue;
+						}
+						node = Expand(node);
+					}
+
+					// A retried process keeps the start of its first attempt
+					Process* proc = nodes[node].proc;
+					clock_type::time_point begin = clock_type::now();
+					bool first = proc->GetAttemptCount() == 1;
+					if (first) {
+						nodes[node].start = begin;
+					}
+					if (first && journal != nullptr && journal->Resume(*proc)) {
+						// Finished before the batch was interrupted
+						nodes[node].resumed = true;
+						launching += clock_type::now() - begin;
+						Complete(node, clock_type::now());
+						continue;
+					}
+					if (first && cache != nullptr && cache->Lookup(*proc, capture)) {
+						// Unchanged since an earlier run, dependents may start straight away
+						launching += clock_type::now() - begin;
+						Complete(node, clock_type::now());
+						continue;
+					}
+					// A process without its own timeout has its launchgroup's
+					duration_type timeout = proc->GetTimeout() > duration_type::zero() ? proc->GetTimeout() : group.GetLimits().timeout;
+					StragglerPolicy policy = group.GetLimits().straggler;
+					proc->SetOwnGroup(timeout > duration_type::zero() || policy == StragglerPolicy::Kill || policy == StragglerPolicy::Relaunch);
+
+					bool watched = Launch(node, proc);
+					launching += clock_type::now() - begin;
+					if (!watched) {
+						// Nothing to wait for, dependents may still run
+						proc->Wait();
+						if (!Retry(node, clock_type::now())) {
+							Complete(node, clock_type::now());
+						}
+						continue;
+					}
+
+					if (timeout > duration_type::zero()) {
+						timers.Schedule(TimerWheel::Timer{ proc->GetStartTime() + timeout, node, TIMER_TIMEOUT, Generation(node) });
+					}
+					CheckStraggler(node);
+				}
+			}
+		}
+	}
+
+	// Method: Scheduler::StartPipeline
+	// Purpose: Creates the pipes of a pipeline and starts every stage of it
+	//			Stages are not cached, resumed or retried alone, their input would be gone
+	void Scheduler::StartPipeline(size_type index) {
+		Pipeline& pipeline = pipelines[index];
+		clock_type::time_point begin = clock_type::now();
+		bool wired = pipes.Open(pipeline.connections);
+		if (!wired) {
+			std::wcerr << L"Error: Could not create the pipes of the pipeline starting with " << ToWide(nodes[pipeline.stages.front()].proc->GetApp())
+				<< L", its stages are not run." << std::endl;
+		}
+
+		std::vector<size_type> failed;
+		for (size_type node : pipeline.stages) {
+			Process* proc = nodes[node].proc;
+			nodes[node].start = clock_type::now();
+			if (!wired) {
+				failed.push_back(node);
+				continue;
+			}
+			LaunchGroup& group = groups[nodes[node].group];
+			duration_type timeout = proc->GetTimeout() > duration_type::zero() ? proc->GetTimeout() : group.GetLimits().timeout;
+			proc->SetOwnGroup(timeout > duration_type::zero());
+			if (!Launch(node, proc)) {
+				proc->Wait();
+				failed.push_back(node);
+				continue;
+			}
+			if (timeout > duration_type::zero()) {
+				timers.Schedule(TimerWheel::Timer{ proc->GetStartTime() + timeout, node, TIMER_TIMEOUT, Generation(node) });
+			}
+		}
+		// The other stages see their pipes close as the failed ones never hold them
+		pipes.Close();
+		launching += clock_type::now() - begin;
+
+		for (size_type node : failed) {
+			Complete(node, clock_type::now());
+		}
+	}
+
+	// Method: Scheduler::Admit
+	// Input: launchgroup and its key, whether to start regardless of pressure
+	// Output: Whether the launchgroup may start a process now
+	bool Scheduler::Admit(size_type key, LaunchGroup& group, bool force) {
+		if (!group.GetAdmission().Enabled()) {
+			return true;
+		}
+		clock_type::time_point now = clock_type::now();
+		Throttle reason = force ? Throttle::None : group.GetAdmission().Check(pressure->Get(now));
+		std::map<size_type, clock_type::time_point>::iterator held = throttled.find(key);
+		if (reason != Throttle::None) {
+			// Each hold is counted once, however often it is checked again
+			if (held == throttled.end()) {
+				throttled.emplace(key, now);
+				group.NoteThrottled(reason);
+			}
+			return false;
+		}
+		if (held != throttled.end()) {
+			group.NoteThrottled(now - held->second);
+			throttled.erase(held);
+		}
+		return true;
+	}
+
+	// Method: Scheduler::Complete
+	// Purpose: Marks a node finished and readies any dependents with no other prerequisites
+	void Scheduler::Complete(size_type node, clock_type::time_point when) {
+		Node& current = nodes[node];
+		current.done = true;
+		current.finish = when;
+		current.pathEnd = current.pathStart;
+		if (trace != nullptr && current.proc == nullptr) {
+			// Launchgroups completed without starting anything have no span
+			std::map<size_type, clock_type::time_point>::iterator started = groupStarts.find(current.group);
+			if (started != groupStarts.end()) {
+				trace->Group(current.group, started->second, when);
+			}
+			std::map<size_type, clock_type::time_point>::iterator drained = groupDrains.find(current.group);
+			if (drained != groupDrains.end()) {
+				trace->Barrier(current.group, drained->second, when);
+				groupDrains.erase(drained);
+			}
+		}
+		if (current.proc != nullptr) {
+			current.pathEnd += current.finish - current.start;
+			// A copy that finished first has the results the straggler will adopt
+			Process* result = current.copy != nullptr && current.proc->GetCopyOutcome() == CopyOutcome::CopyWon ? current.copy : current.proc;
+			// A sweep is reported through its jobs
+			bool sweep = current.proc->GetSweep() != nullptr;
+			if (progress != nullptr && !sweep) {
+				progress->Completed(!result->IsCached() && !(result->DidRun() && result->Succeded()), result->IsCached());
+			}
+			if (journal != nullptr && !current.resumed && !sweep) {
+				journal->Finished(*current.proc, *result);
+			}
+		}
+		if (current.sweep != NONE) {
+			Release(node, when);
+			return;
+		}
+
+		for (size_type dependent : current.dependents) {
+			Node& next = nodes[dependent];
+			next.pathStart = std::max(next.pathStart, current.pathEnd);
+			if (--next.pending > 0) {
+				continue;
+			}
+
+			if (next.proc == nullptr) {
+				// Every process in the launchgroup has finished
+				Complete(dependent, when);
+			}
+			else {
+				Ready(dependent);
+			}
+		}
+	}
+
+	// Method: Scheduler::Ready
+	// Purpose: Queues a process node to start once a slot is free
+	void Scheduler::Ready(size_type node) {
+		// A pipeline is queued as its first stage once all of its stages are ready
+		if (nodes[node].pipeline != NONE) {
+			Pipeline& pipeline = pipelines[nodes[node].pipeline];
+			if (++pipeline.ready < pipeline.stages.size()) {
+				return;
+			}
+			node = pipeline.stages.front();
+		}
+		ready[nodes[node].group].push(ReadyEntry{ nodes[node].expected, node });
+	}
+
+	// Method: Scheduler::Expand
+	// Input: node of a sweep with jobs left to expand
+	// Output: Node of its next job, which the caller starts
+	// Purpose: Keeps the sweep queued while it has further jobs
+	Scheduler::size_type Scheduler::Expand(size_type node) {
+		size_type job = nodes[node].job++;
+		size_type expanded;
+		if (freeNodes.empty()) {
+			expanded = nodes.size();
+			nodes.emplace_back();
+		}
+		else {
+			expanded = freeNodes.back();
+			freeNodes.pop_back();
+			size_type serial = nodes[expanded].serial + 1;
+			nodes[expanded] = Node();
+			nodes[expanded].serial = serial;
+		}
+
+		// The process and its text are reused along with the node
+		Process* sweep = nodes[node].proc;
+		Expansion& expansion = expansions[expanded];
+		expansion.proc.reset();
+		expansion.proc.reset(new Process(sweep->Expand(job, expansion.text, expansion.arguments)));
+
+		Node& current = nodes[expanded];
+		current.proc = expansion.proc.get();
+		current.group = nodes[node].group;
+		current.sweep = node;
+		current.job = job;
+		current.expected = nodes[node].expected;
+		current.pathStart = nodes[node].pathStart;
+		if (journal != nullptr) {
+			journal->Expand(*current.proc, *sweep, sweep->GetSweep()->GetIndex(job));
+		}
+		if (nodes[node].job < sweep->GetSweep()->GetCount()) {
+			Ready(node);
+		}
+		return expanded;
+	}
+
+	// Method: Scheduler::Release
+	// Purpose: Records the result of a finished job of a sweep and frees its node
+	//			The sweep completes once all of its jobs have
+	void Scheduler::Release(size_type node, clock_type::time_point when) {
+		Node& current = nodes[node];
+		Process* proc = current.proc;
+
+		// Only what the reports show is kept, the process itself is reused
+		auto record = [](bool started, Process::exit_code code, StopReason reason, clock_type::time_point start, clock_type::time_point end) {
+			SweepResult result;
+			result.state = SweepResult::DONE | (started ? SweepResult::STARTED : 0);
+			result.exitCode = static_cast<std::uint32_t>(code);
+			result.stopReason = static_cast<std::uint8_t>(reason);
+			result.start = start.time_since_epoch().count();
+			result.end = end.time_since_epoch().count();
+			return result;
+		};
+		std::vector<SweepResult> earlier;
+		for (Process::Attempt const& attempt : proc->GetAttempts()) {
+			earlier.push_back(record(attempt.started, attempt.exitCode, attempt.stopReason, attempt.start, attempt.end));
+		}
+		SweepResult result = record(proc->DidRun(), proc->DidRun() ? proc->GetExitCode() : 0, proc->GetStopReason(), proc->GetStartTime(), proc->GetEndTime());
+		if (current.resumed) {
+			result.state |= SweepResult::RESUMED;
+		}
+		else if (proc->IsCached()) {
+			result.state |= SweepResult::CACHED;
+		}
+		if (proc->DidRun()) {
+			ResourceUsage usage = proc->GetResourceUsage();
+			result.userTime = usage.userTime.count();
+			result.kernelTime = usage.kernelTime.count();
+			result.spawnLatency = static_cast<std::uint32_t>(std::min<long long>(proc->GetSpawnLatency().count(), 0xFFFFFFFFLL));
+			result.launchOverhead = static_cast<std::uint32_t>(std::min<long long>(proc->GetLaunchOverhead().count(), 0xFFFFFFFFLL));
+		}
+		result.attempts = static_cast<std::uint16_t>(proc->GetAttemptCount());
+
+		Node& parent = nodes[current.sweep];
+		parent.proc->GetSweep()->Record(current.job, result, std::move(earlier));
+		if (journal != nullptr) {
+			journal->Forget(*proc);
+		}
+		freeNodes.push_back(node);
+		if (--parent.remaining == 0) {
+			Complete(current.sweep, when);
+		}
+	}
+
+	// Method: Scheduler::Launch
+	// Input: node, the process or copy of it to start
+	// Output: Whether the process started and is being watched
+	bool Scheduler::Launch(size_type node, Process* proc) {
+		// The lowest free slot keeps busy CPUs together when fewer processes run than slots
+		// A pipeline with more stages than slots runs the rest unplaced
+		size_type slot = NONE;
+		if ((layout != nullptr || trace != nullptr) && !freeSlots.empty()) {
+			slot = *freeSlots.begin();
+			freeSlots.erase(freeSlots.begin());
+			if (layout != nullptr && proc->GetPlacement() != nullptr) {
+				layout->Assign(slot, *proc->GetPlacement());
+			}
+		}
+		if (capture != nullptr) {
+			capture->Prepare(proc);
+		}
+		proc->StartAsync();
+		if (capture != nullptr) {
+			capture->Attach(proc);
+		}
+		if (!reaper.Add(proc)) {
+			if (slot != NONE) {
+				freeSlots.insert(slot);
+			}
+			return false;
+		}
+
+		runningNodes[proc] = Running{ node, slot };
+		if (journal != nullptr) {
+			journal->Started(*nodes[node].proc);
+		}
+		if (++nodes[node].running == 1 && progress != nullptr) {
+			progress->Launched();
+		}
+		size_type& groupCount = groupRunning[nodes[node].group];
+		groups[nodes[node].group].NoteRunning(++groupCount);
+		if (trace != nullptr) {
+			// The launchgroup has work to start again, it is not waiting on its last processes
+			groupStarts.emplace(nodes[node].group, proc->GetStartTime());
+			groupDrains.erase(nodes[node].group);
+			trace->Running(proc->GetStartTime(), reaper.Size());
+		}
+		return true;
+	}
+
+	// Method: Scheduler::StartCopy
+	// Purpose: Starts a copy of a straggler, unless it finished while waiting for a slot
+	void Scheduler::StartCopy(size_type node) {
+		Node& current = nodes[node];
+		if (current.done) {
+			return;
+		}
+
+		clock_type::time_point begin = clock_type::now();
+		Process* proc = current.proc;
+		copies.emplace_back(proc->GetLaunchGroup(), copyText, proc->GetApp(), proc->GetParams());
+		Process& copy = copies.back();
+		copy.SetId(proc->GetId());
+		copy.SetEnvironment(proc->GetEnvironment());
+		copy.SetDirectory(proc->GetDirectory().empty() ? nullptr : proc->GetDirectory().data());
+		copy.SetOwnGroup(true);
+		if (proc->GetPlacement() != nullptr) {
+			// The copy gets CPUs of its own slot and a cgroup beside the straggler's
+			Placement placement = *proc->GetPlacement();
+			placement.Rearm();
+			copy.SetPlacement(placement);
+		}
+		if (capture != nullptr) {
+			capture->RegisterCopy(&copy, proc);
+		}
+
+		if (Launch(node, &copy)) {
+			current.copy = &copy;
+		}
+		else {
+			copy.Wait();
+		}
+		launching += clock_type::now() - begin;
+	}
+
+	// Method: Scheduler::Finished
+	// Purpose: Frees the slot of an exited process and completes its node, the first run to exit wins
+	void Scheduler::Finished(Process* proc, clock_type::time_point when) {
+		std::unordered_map<Process*, Running>::iterator found = runningNodes.find(proc);
+		Running run = found->second;
+		runningNodes.erase(found);
+
+		Node& current = nodes[run.node];
+		if (--current.running == 0 && progress != nullptr) {
+			progress->Exited();
+		}
+		if (trace != nullptr) {
+			trace->Job(run.slot == NONE ? Trace::NO_SLOT : run.slot, *proc, when, proc != current.proc);
+			trace->Running(when, reaper.Size());
+		}
+		--groupRunning[current.group];
+		if (run.slot != NONE) {
+			freeSlots.insert(run.slot);
+		}
+		if (current.done) {
+			// The other run of a straggler already finished
+			return;
+		}
+
+		if (current.copy != nullptr) {
+			// The other run is no longer needed
+			bool copyWon = proc == current.copy;
+			(copyWon ? current.proc : current.copy)->Terminate(true);
+			current.proc->SetCopyOutcome(copyWon ? CopyOutcome::CopyWon : CopyOutcome::OriginalWon);
+		}
+		else if (Retry(run.node, when)) {
+			return;
+		}
+
+		// Run times of stopped processes say nothing about the launchgroup
+		// Jobs of a sweep are not compared with the launchgroup, they may differ by design
+		StragglerPolicy policy = groups[current.group].GetLimits().straggler;
+		if ((policy == StragglerPolicy::Kill || policy == StragglerPolicy::Relaunch) && proc->GetStopReason() == StopReason::None && current.sweep == NONE) {
+			Median& times = groupTimes[current.group];
+			times.Add(proc->GetEndTime() - proc->GetStartTime());
+			// Once half the launchgroup has finished, the rest are checked against it
+			if (times.Size() * 2 >= groups[current.group].Size()) {
+				for (std::unordered_map<Process*, Running>::value_type& running : runningNodes) {
+					if (nodes[running.second.node].group == current.group && nodes[running.second.node].sweep == NONE) {
+						CheckStraggler(running.second.node);
+					}
+				}
+			}
+		}
+
+		size_type group = current.group;
+		Complete(run.node, when);
+		if (trace != nullptr && ready[group].empty() && !nodes[groupNodes[group]].done) {
+			// A slot of the launchgroup is free with nothing of it left to start
+			groupDrains.emplace(group, when);
+		}
+	}
+
+	// Method: Scheduler::Fire
+	// Purpose: Acts on an expired timer if its process is still running
+	void Scheduler::Fire(TimerWheel::Timer const& timer, clock_type::time_point now) {
+		Node& current = nodes[timer.key];
+		if (timer.kind == TIMER_RETRY) {
+			--backingOff;
+			Ready(timer.key);
+			return;
+		}
+		// Timers of an earlier attempt are stale
+		if (current.done || current.running == 0 || timer.generation != Generation(timer.key)) {
+			return;
+		}
+
+		switch (timer.kind) {
+		case TIMER_TIMEOUT:
+			StopNode(timer.key, StopReason::Timeout, now);
+			break;
+		case TIMER_KILL:
+			current.proc->Terminate(true);
+			if (current.copy != nullptr) {
+				current.copy->Terminate(true);
+			}
+			break;
+		case TIMER_STRAGGLER: {
+			if (current.copy != nullptr || current.proc->GetStopReason() != StopReason::None) {
+				break;
+			}
+			// The median may have grown since the check was scheduled
+			TimeLimits& limits = groups[current.group].GetLimits();
+			duration_type allowed = std::chrono::duration_cast<duration_type>(groupTimes[current.group].Get() * limits.GetStragglerFactor());
+			clock_type::time_point deadline = current.proc->GetStartTime() + allowed;
+			if (now < deadline) {
+				timers.Schedule(TimerWheel::Timer{ deadline, timer.key, TIMER_STRAGGLER, timer.generation });
+			}
+			else if (limits.straggler == StragglerPolicy::Kill) {
+				StopNode(timer.key, StopReason::Straggler, now);
+			}
+			else if (limits.straggler == StragglerPolicy::Relaunch) {
+				pendingCopies.push_back(timer.key);
+			}
+			break;
+		}
+		}
+	}
+
+	// Method: Scheduler::StopNode
+	// Purpose: Asks every run of a node to exit, killing them after the grace period
+	void Scheduler::StopNode(size_type node, StopReason reason, clock_type::time_point now) {
+		Node& current = nodes[node];
+		for (Process* proc : { current.proc, current.copy }) {
+			if (proc != nullptr && proc->GetStopReason() == StopReason::None) {
+				proc->SetStopReason(reason);
+				proc->Terminate(false);
+			}
+		}
+		duration_type grace = current.proc != nullptr && current.proc->GetGrace() > duration_type::zero() ? current.proc->GetGrace() : groups[current.group].GetLimits().GetGrace();
+		timers.Schedule(TimerWheel::Timer{ now + grace, node, TIMER_KILL, Generation(node) });
+	}
+
+	// Method: Scheduler::CheckStraggler
+	// Purpose: Schedules a straggler check once the launchgroup's median run time is known
+	void Scheduler::CheckStraggler(size_type node) {
+		Node& current = nodes[node];
+		TimeLimits& limits = groups[current.group].GetLimits();
+		if (current.checked || current.sweep != NONE || current.pipeline != NONE || (limits.straggler != StragglerPolicy::Kill && limits.straggler != StragglerPolicy::Relaunch)) {
+			return;
+		}
+		std::map<size_type, Median>::iterator times = groupTimes.find(current.group);
+		if (times == groupTimes.end() || times->second.Size() * 2 < groups[current.group].Size()) {
+			return;
+		}
+		current.checked = true;
+		duration_type allowed = std::chrono::duration_cast<duration_type>(times->second.Get() * limits.GetStragglerFactor());
+		timers.Schedule(TimerWheel::Timer{ current.proc->GetStartTime() + allowed, node, TIMER_STRAGGLER, Generation(node) });
+	}
+
+	// Method: Scheduler::Retry
+	// Output: Whether the failed process will run again after its backoff
+	// Purpose: Requeues the process once its backoff has passed, other processes use the slot meanwhile
+	bool Scheduler::Retry(size_type node, clock_type::time_point now) {
+		Node& current = nodes[node];
+		Process* proc = current.proc;
+		if ((proc->DidRun() && proc->Succeded()) || current.pipeline != NONE) {
+			return false;
+		}
+
+		// A process without its own policy has its launchgroup's, its own was merged with it before the run
+		RetryPolicy& policy = proc->GetRetry() != nullptr ? *proc->GetRetry() : groups[current.group].GetRetry();
+		size_type made = proc->GetAttemptCount();
+		if (made >= policy.attempts || !policy.Matches(proc->DidRun(), static_cast<long long>(proc->DidRun() ? proc->GetExitCode() : 0))) {
+			return false;
+		}
+
+		if (capture != nullptr) {
+			capture->Restart(proc, made);
+		}
+		proc->Retry();
+		current.checked = false;
+		++backingOff;
+		if (progress != nullptr) {
+			progress->Retried();
+		}
+		timers.Schedule(TimerWheel::Timer{ now + policy.Backoff(made), node, TIMER_RETRY, made + 1 });
+		return true;
+	}
+/// End Scheduler::Operations
+
+/// Begin Scheduler::Median
+	// Method: Median::Add
+	void Scheduler::Median::Add(duration_type time) {
+		if (lower.empty() || time <= lower.top()) {
+			lower.push(time);
+		}
+		else {
+			upper.push(time);
+		}
+
+		// The lower half holds the extra time when the count is odd
+		if (lower.size() > upper.size() + 1) {
+			upper.push(lower.top());
+			lower.pop();
+		}
+		else if (upper.size() > lower.size()) {
+			lower.push(upper.top());
+			upper.pop();
+		}
+	}
+
+	// Method: Median::Get
+	// Output: The median, zero when empty
+	Scheduler::duration_type Scheduler::Median::Get() {
+		if (lower.empty()) {
+			return duration_type::zero();
+		}
+		if (lower.size() > upper.size()) {
+			return lower.top();
+		}
+		return lower.top() + (upper.top() - lower.top()) / 2;
+	}
+/// End Scheduler::Median
+
+/// Begin Scheduler::Operators
+	// Method: operator<<
+	// Input: output stream, Stats to print
+	// Purpose: Prints makespan, critical path, idle slot time and scheduling overhead
+	std::wostream& operator<<(std::wostream& lhs, Scheduler::Stats const& rhs) {
+		using seconds = std::chrono::duration<double>;
+
+		lhs << std::fixed << std::setprecision(3)
+			<< L"Concurrency limit: " << rhs.slots << std::endl
+			<< L"Makespan (s): " << seconds(rhs.makespan).count()
+			<< L", critical path (s): " << seconds(rhs.criticalPath).count()
+			<< L", idle slot time (s): " << seconds(rhs.idleTime).count() << std::endl
+			<< L"Scheduling overhead (s): " << seconds(rhs.overhead).count() << std::endl;
+		if (rhs.timedOut > 0 || rhs.stragglers > 0 || rhs.copies > 0) {
+			lhs << L"Timed out: " << rhs.timedOut
+				<< L", stragglers stopped: " << rhs.stragglers
+				<< L", straggler copies: " << rhs.copies << L" (" << rhs.copiesWon << L" finished first)" << std::endl;
+		}
+		if (rhs.resumed > 0) {
+			lhs << L"Resumed: " << rhs.resumed << L" processes had finished before the batch was interrupted" << std::endl;
+		}
+		if (rhs.retries > 0) {
+			lhs << L"Retries: " << rhs.retries << L", processes that succeeded on a retry: " << rhs.recovered << std::endl;
+		}
+		if (rhs.pipelines > 0) {
+			lhs << L"Pipelines: " << rhs.pipelines << L", pipes: " << rhs.pipes
+				<< L", bytes relayed to several consumers: " << rhs.relayed << std::endl;
+		}
+		lhs.unsetf(std::ios_base::floatfield);
+		lhs.precision(6);
+
+		return lhs;
+	}
+/// End Scheduler::Operators
+}
@@ -0,0 +1,352 @@
+/*
+File: rm_Scheduler.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Runs the processes of every launchgroup as a dependency graph
+		A process starts as soon as its own prerequisites have finished
+		Ready processes of a launchgroup start longest predicted run time first
+		Automatic placements pin each running process to the CPUs of its slot
+		Timeouts and stragglers are handled by a timer wheel in the same event loop
+		Starts of a launchgroup are held back while the system is under more pressure than it tolerates
+		Jobs of a sweep are expanded one at a time as slots free up, into nodes reused once they finish
+		Jobs connected by pipes start together as one pipeline once every stage of it is ready
+		The run can be written to a timeline trace, with a track per slot
+*/
+#ifndef RM_SCHEDULER_HEADER_GUARD
+#define RM_SCHEDULER_HEADER_GUARD
+#include "rm_LaunchGroup.hpp"
+#include "rm_Reaper.hpp"
+#include "rm_OutputCapture.hpp"
+#include "rm_ResultCache.hpp"
+#include "rm_TimerWheel.hpp"
+#include "rm_Progress.hpp"
+#include "rm_Journal.hpp"
+#include "rm_Admission.hpp"
+#include "rm_Pipeline.hpp"
+#include "rm_Trace.hpp"
+#include <map>
+#include <memory>
+#include <set>
+#include <queue>
+#include <deque>
+#include <functional>
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <ostream>
+
+namespace rm {
+	class Scheduler {
+	public:		/// Types
+		using size_type = size_t;
+		using group_map = std::map<size_type, LaunchGroup>;
+		using clock_type = Process::clock_type;
+		using duration_type = Process::duration_type;
+
+		// Marks a node that is not a job of a sweep or a stage of a pipeline
+		static const size_type NONE = static_cast<size_type>(-1);
+
+		// Summary of a completed run
+		struct Stats {
+			size_type jobs = 0;
+			size_type started = 0;
+			// Processes completed from the result cache instead of being started
+			size_type cached = 0;
+			// Processes the journal showed had succeeded before the batch was interrupted
+			size_type resumed = 0;
+			// Processes that never became ready, due to a dependency cycle
+			size_type unscheduled = 0;
+			// Processes stopped for running past their timeout
+			size_type timedOut = 0;
+			// Processes stopped for running far longer than their launchgroup
+			size_type stragglers = 0;
+			// Copies started for stragglers, and how many of them finished first
+			size_type copies = 0;
+			size_type copiesWon = 0;
+			// Attempts after the first, and processes that succeeded on one of them
+			size_type retries = 0;
+			size_type recovered = 0;
+			// Pipelines run, pipes created for them and bytes relayed to producers' several consumers
+			size_type pipelines = 0;
+			size_type pipes = 0;
+			unsigned long long relayed = 0;
+			size_type slots = 0;
+			duration_type makespan = duration_type::zero();
+			// Longest chain of dependent processes, measured by their run time
+			duration_type criticalPath = duration_type::zero();
+			// Sum of process run times
+			duration_type busyTime = duration_type::zero();
+			// Slot time not used by a running process
+			duration_type idleTime = duration_type::zero();
+			// Launcher time spent scheduling, outside of spawn calls and waits for exits
+			duration_type overhead = duration_type::zero();
+		};
+	private:
+		// A process, or the completion of a whole launchgroup
+		struct Node {
+			Process* proc = nullptr;
+			size_type group = 0;
+			// Prerequisites that have not finished
+			size_type pending = 0;
+			std::vector<size_type> dependents;
+			clock_type::time_point start, finish;
+			// Longest dependency chain ending when this node started and finished
+			duration_type pathStart = duration_type::zero();
+			duration_type pathEnd = duration_type::zero();
+			bool done = false;
+			// Predicted run time, used to start the longest ready process of a launchgroup first
+			duration_type expected = duration_type::zero();
+			// Copy started once the process straggled, null if none
+			Process* copy = nullptr;
+			// Runs of the process that have not exited, the copy included
+			unsigned int running = 0;
+			// A straggler check has been scheduled, it is only ever scheduled once
+			bool checked = false;
+			// Completed by an earlier run of an interrupted batch
+			bool resumed = false;
+			// Sweep node this job was expanded from, NONE for other nodes
+			size_type sweep = NONE;
+			// Job of the sweep, or for the sweep itself the next job to expand
+			size_type job = 0;
+			// Jobs of a sweep that have not finished
+			size_type remaining = 0;
+			// Times the node was reused for another job, timers of an earlier job are stale
+			size_type serial = 0;
+			// Pipeline the process is a stage of, NONE if it is not piped
+			size_type pipeline = NONE;
+		};
+
+		// Processes connected by pipes, started together so none blocks on a stage that is not running
+		struct Pipeline {
+			// Nodes in file order, the first is queued for the whole pipeline
+			std::vector<size_type> stages;
+			std::vector<Pipelines::connection_type> connections;
+			// Stages whose prerequisites have finished
+			size_type ready = 0;
+		};
+
+		// Process started for a job of a sweep, and the text it is started with
+		struct Expansion {
+			native_string text;
+			std::vector<native_char*> arguments;
+			std::unique_ptr<Process> proc;
+		};
+
+		// A started process
+		struct Running {
+			size_type node;
+			// Slot the process runs in while placements are automatic
+			size_type slot;
+		};
+
+		// What a timer of the wheel is for, its key is a node
+		enum TimerKind : unsigned int {
+			// The process ran past its timeout
+			TIMER_TIMEOUT,
+			// A process asked to exit has had its grace period
+			TIMER_KILL,
+			// The process may have run far longer than the rest of its launchgroup
+			TIMER_STRAGGLER,
+			// A failed process has waited out its backoff
+			TIMER_RETRY
+		};
+
+		// Median of a growing set of run times, kept in two heaps
+		class Median {
+		private:
+			// Shorter half, longest on top
+			std::priority_queue<duration_type> lower;
+			// Longer half, shortest on top
+			std::priority_queue<duration_type, std::vector<duration_type>, std::greater<duration_type>> upper;
+		public:
+			// Method: Median::Add
+			void Add(duration_type time);
+
+			// Method: Median::Get
+			// Output: The median, zero when empty
+			duration_type Get();
+
+			// Method: Median::Size
+			inline size_type Size() {
+				return lower.size() + upper.size();
+			}
+		};
+
+		// Ready process, longer predictions first and file order between equals
+		struct ReadyEntry {
+			duration_type expected;
+			size_type node;
+
+			inline bool operator<(ReadyEntry const& rhs) const {
+				return expected != rhs.expected ? expected < rhs.expected : node > rhs.node;
+			}
+		};
+	private:	/// Variables
+		group_map& groups;
+		size_type limit;
+		std::vector<Node> nodes;
+		// Launchgroup to the node completed by all of its processes
+		std::map<size_type, size_type> groupNodes;
+		// Launchgroup to processes ready to start
+		std::map<size_type, std::priority_queue<ReadyEntry>> ready;
+		std::map<size_type, size_type> groupRunning;
+		Reaper reaper;
+		// Captures the output of registered processes, may be null
+		OutputCapture* capture;
+		// Completes processes whose results are unchanged, may be null
+		ResultCache* cache;
+		// CPUs of each slot for automatic placements, may be null
+		CpuLayout* layout;
+		// Live counts of queued, running and finished jobs, may be null
+		Progress* progress;
+		// Records job starts and finishes and skips jobs finished before a resume, may be null
+		Journal* journal;
+		// Samples system pressure for launchgroups with admission thresholds, may be null
+		PressureMonitor* pressure;
+		// Timeline the run is written to, may be null
+		Trace* trace;
+		// While tracing, when each launchgroup started its first process,
+		// and since when it has had nothing left to start while a process of it is running
+		std::map<size_type, clock_type::time_point> groupStarts;
+		std::map<size_type, clock_type::time_point> groupDrains;
+		// Launchgroups whose starts are held back, and since when
+		std::map<size_type, clock_type::time_point> throttled;
+		// Slots without a running process, lowest first, kept for automatic placements and tracing
+		std::set<size_type> freeSlots;
+		// Running process to its node
+		std::unordered_map<Process*, Running> runningNodes;
+		// Deadlines of running processes
+		TimerWheel timers;
+		// Run times of the finished processes of each launchgroup
+		std::map<size_type, Median> groupTimes;
+		// Copies of stragglers and their text
+		StringPool copyText;
+		std::deque<Process> copies;
+		// Stragglers waiting for a slot to start their copy
+		std::deque<size_type> pendingCopies;
+		// Job nodes of sweeps and their processes, kept for reuse once the job has finished
+		std::unordered_map<size_type, Expansion> expansions;
+		std::vector<size_type> freeNodes;
+		std::vector<Pipeline> pipelines;
+		// Creates the pipes of each pipeline as it starts
+		Pipelines pipes;
+		// Failed processes waiting out their backoff
+		size_type backingOff = 0;
+		// Time spent starting processes, including output capture
+		duration_type launching = duration_type::zero();
+		Stats stats;
+	public:		/// Methods
+		/// Constructors
+		// Input: launchgroups to run, maximum number of processes running at once,
+		//			optional output capture, result cache, CPU layout, live progress, journal, pressure monitor and trace
+		Scheduler(group_map& groups, size_type limit, OutputCapture* capture = nullptr, ResultCache* cache = nullptr,
+			CpuLayout* layout = nullptr, Progress* progress = nullptr, Journal* journal = nullptr, PressureMonitor* pressure = nullptr,
+			Trace* trace = nullptr);
+
+		~Scheduler();
+
+		/// Operations
+		// Method: Scheduler::Run
+		// Purpose: Starts every process once its prerequisites finish and waits for all of them
+		void Run();
+
+		// Method: Scheduler::GetStats
+		// Output: Summary of the last run
+		inline Stats const& GetStats() {
+			return stats;
+		}
+	private:
+		// Method: Scheduler::Build
+		// Purpose: Creates a node per process and launchgroup and links them
+		//			Processes without dependencies depend on the previous launchgroup
+		void Build();
+
+		// Method: Scheduler::Connect
+		// Purpose: Resolves the pipe sources of every process into pipelines
+		//			Sources must be single jobs of the same launchgroup, which runs its stages side by side
+		void Connect(std::map<native_string_view, size_type> const& ids);
+
+		// Method: Scheduler::Link
+		// Purpose: Makes node 'to' wait for node 'from'
+		void Link(size_type from, size_type to);
+
+		// Method: Scheduler::StartReady
+		// Purpose: Starts ready processes until the limits are reached
+		void StartReady();
+
+		// Method: Scheduler::Admit
+		// Input: launchgroup and its key, whether to start regardless of pressure
+		// Output: Whether the launchgroup may start a process now
+		// Purpose: Holds back starts while the system is under more pressure than the launchgroup tolerates
+		bool Admit(size_type key, LaunchGroup& group, bool force);
+
+		// Method: Scheduler::StartPipeline
+		// Purpose: Creates the pipes of a pipeline and starts every stage of it
+		//			Stages are not cached, resumed or retried alone, their input would be gone
+		void StartPipeline(size_type index);
+
+		// Method: Scheduler::Complete
+		// Purpose: Marks a node finished and readies any dependents with no other prerequisites
+		void Complete(size_type node, clock_type::time_point when);
+
+		// Method: Scheduler::Ready
+		// Purpose: Queues a process node to start once a slot is free
+		void Ready(size_type node);
+
+		// Method: Scheduler::Expand
+		// Input: node of a sweep with jobs left to expand
+		// Output: Node of its next job, which the caller starts
+		// Purpose: Keeps the sweep queued while it has further jobs
+		size_type Expand(size_type node);
+
+		// Method: Scheduler::Release
+		// Purpose: Records the result of a finished job of a sweep and frees its node
+		//			The sweep completes once all of its jobs have
+		void Release(size_type node, clock_type::time_point when);
+
+		// Method: Scheduler::Generation
+		// Output: State of a node its timers are checked against
+		inline size_type Generation(size_type node) {
+			return nodes[node].serial << 16 | nodes[node].proc->GetAttemptCount();
+		}
+
+		// Method: Scheduler::Launch
+		// Input: node, the process or copy of it to start
+		// Output: Whether the process started and is being watched
+		bool Launch(size_type node, Process* proc);
+
+		// Method: Scheduler::StartCopy
+		// Purpose: Starts a copy of a straggler, unless it finished while waiting for a slot
+		void StartCopy(size_type node);
+
+		// Method: Scheduler::Finished
+		// Purpose: Frees the slot of an exited process and completes its node, the first run to exit wins
+		void Finished(Process* proc, clock_type::time_point when);
+
+		// Method: Scheduler::Fire
+		// Purpose: Acts on an expired timer if its process is still running
+		void Fire(TimerWheel::Timer const& timer, clock_type::time_point now);
+
+		// Method: Scheduler::StopNode
+		// Purpose: Asks every run of a node to exit, killing them after the grace period
+		void StopNode(size_type node, StopReason reason, clock_type::time_point now);
+
+		// Method: Scheduler::Retry
+		// Output: Whether the failed process will run again after its backoff
+		// Purpose: Requeues the process once its backoff has passed, other processes use the slot meanwhile
+		bool Retry(size_type node, clock_type::time_point now);
+
+		// Method: Scheduler::CheckStraggler
+		// Purpose: Schedules a straggler check once the launchgroup's median run time is known
+		void CheckStraggler(size_type node);
+	};
+
+	/// Operators
+	// Method: operator<<
+	// Input: output stream, Stats to print
+	// Purpose: Prints makespan, critical path, idle slot time and scheduling overhead
+	std::wostream& operator<<(std::wostream& lhs, Scheduler::Stats const& rhs);
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+File: rm_Sha256.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: SHA-256 digests, used to key cached results by content
+		Follows FIPS 180-4
+*/
+#include "rm_Sha256.hpp"
+#include <cstring>
+
+namespace rm {
+	namespace {
+		const uint32_t ROUND_CONSTANTS[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		inline uint32_t Rotate(uint32_t value, int bits) {
+			return (value >> bits) | (value << (32 - bits));
+		}
+	}
+
+/// Begin Sha256::Constructors
+	Sha256::Sha256()
+		: state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+		blockLength(0), totalLength(0) {
+
+	}
+/// End Sha256::Constructors
+
+/// Begin Sha256::Operations
+	// Method: Sha256::Update
+	// Input: bytes to add to the digest
+	void Sha256::Update(void const* data, size_type length) {
+		unsigned char const* bytes = static_cast<unsigned char const*>(data);
+		totalLength += length;
+
+		// Finish a partial block first
+		if (blockLength > 0) {
+			size_type copied = length < 64 - blockLength ? length : 64 - blockLength;
+			std::memcpy(block + blockLength, bytes, copied);
+			blockLength += copied;
+			bytes += copied;
+			length -= copied;
+			if (blockLength < 64) {
+				return;
+			}
+			Transform(block);
+			blockLength = 0;
+		}
+
+		// Whole blocks are hashed in place
+		while (length >= 64) {
+			Transform(bytes);
+			bytes += 64;
+			length -= 64;
+		}
+		std::memcpy(block, bytes, length);
+		blockLength = length;
+	}
+
+	// Method: Sha256::Final
+	// Output: The digest of everything added, the object must not be updated afterwards
+	Sha256::digest_type Sha256::Final() {
+		uint64_t bits = totalLength * 8;
+
+		// Pad with a single 1 bit, zeros and the message length in bits
+		unsigned char padding[72] = { 0x80 };
+		size_type padLength = blockLength < 56 ? 56 - blockLength : 120 - blockLength;
+		for (int i = 0; i < 8; ++i) {
+			padding[padLength + i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+		}
+		Update(padding, padLength + 8);
+
+		digest_type digest;
+		for (int i = 0; i < 8; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				digest[i * 4 + j] = static_cast<unsigned char>(state[i] >> (24 - 8 * j));
+			}
+		}
+		return digest;
+	}
+
+	// Method: Sha256::ToHex
+	// Output: Lower case hexadecimal form of a digest
+	std::string Sha256::ToHex(digest_type const& digest) {
+		static char const HEX[] = "0123456789abcdef";
+		std::string output;
+		output.reserve(digest.size() * 2);
+		for (unsigned char byte : digest) {
+			output += HEX[byte >> 4];
+			output += HEX[byte & 0xF];
+		}
+		return output;
+	}
+
+	// Method: Sha256::Transform
+	// Purpose: Mixes one 64 byte block into the state
+	void Sha256::Transform(unsigned char const* data) {
+		uint32_t words[64];
+		for (int i = 0; i < 16; ++i) {
+			words[i] = (uint32_t(data[i * 4]) << 24) | (uint32_t(data[i * 4 + 1]) << 16)
+				| (uint32_t(data[i * 4 + 2]) << 8) | uint32_t(data[i * 4 + 3]);
+		}
+		for (int i = 16; i < 64; ++i) {
+			uint32_t s0 = Rotate(words[i - 15], 7) ^ Rotate(words[i - 15], 18) ^ (words[i - 15] >> 3);
+			uint32_t s1 = Rotate(words[i - 2], 17) ^ Rotate(words[i - 2], 19) ^ (words[i - 2] >> 10);
+			words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+		}
+
+		uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+		uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+		for (int i = 0; i < 64; ++i) {
+			uint32_t s1 = Rotate(e, 6) ^ Rotate(e, 11) ^ Rotate(e, 25);
+			uint32_t choice = (e & f) ^ (~e & g);
+			uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + words[i];
+			uint32_t s0 = Rotate(a, 2) ^ Rotate(a, 13) ^ Rotate(a, 22);
+			uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t temp2 = s0 + majority;
+			h = g;
+			g = f;
+			f = e;
+			e = d + temp1;
+			d = c;
+			c = b;
+			b = a;
+			a = temp1 + temp2;
+		}
+
+		state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+		state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+	}
+/// End Sha256::Operations
+}
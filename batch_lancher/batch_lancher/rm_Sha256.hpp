@@ -0,0 +1,54 @@
+/*
+File: rm_Sha256.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: SHA-256 digests, used to key cached results by content
+*/
+#ifndef RM_SHA256_HEADER_GUARD
+#define RM_SHA256_HEADER_GUARD
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace rm {
+	class Sha256 {
+	public:		/// Types
+		using size_type = size_t;
+		using digest_type = std::array<unsigned char, 32>;
+	private:	/// Variables
+		uint32_t state[8];
+		unsigned char block[64];
+		size_type blockLength;
+		uint64_t totalLength;
+	public:		/// Methods
+		/// Constructors
+		Sha256();
+
+		/// Operations
+		// Method: Sha256::Update
+		// Input: bytes to add to the digest
+		void Update(void const* data, size_type length);
+
+		// Method: Sha256::Update
+		// Input: string to add to the digest, followed by a null so adjacent strings can not run together
+		inline void Update(std::string const& text) {
+			Update(text.c_str(), text.size() + 1);
+		}
+
+		// Method: Sha256::Final
+		// Output: The digest of everything added, the object must not be updated afterwards
+		digest_type Final();
+
+		// Method: Sha256::ToHex
+		// Output: Lower case hexadecimal form of a digest
+		static std::string ToHex(digest_type const& digest);
+	private:
+		// Method: Sha256::Transform
+		// Purpose: Mixes one 64 byte block into the state
+		void Transform(unsigned char const* data);
+	};
+}
+
+#endif
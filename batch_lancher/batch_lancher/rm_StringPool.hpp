@@ -0,0 +1,116 @@
+/*
+File: rm_StringPool.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Append only arena for the text of every process
+		Strings are packed into large blocks and never move once added
+*/
+#ifndef RM_STRINGPOOL_HEADER_GUARD
+#define RM_STRINGPOOL_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <vector>
+#include <memory>
+#include <cstring>
+
+namespace rm {
+	class StringPool {
+	public:		/// Types
+		using size_type = size_t;
+		using char_type = native_char;
+		using view_type = native_string_view;
+	private:	/// Variables
+		// Characters in a regular block, larger strings get a block of their own
+		static const size_type BLOCK_SIZE = 256 * 1024;
+
+		std::vector<std::unique_ptr<char_type[]>> blocks;
+		// Block currently being filled
+		char_type* current = nullptr;
+		size_type used = BLOCK_SIZE;
+		size_type capacity = 0;
+		size_type length = 0;
+	public:		/// Methods
+		/// Constructors
+		StringPool() = default;
+
+		StringPool(StringPool const&) = delete;
+		StringPool& operator=(StringPool const&) = delete;
+
+		/// Operations
+		// Method: StringPool::Allocate
+		// Input: number of characters needed, not including the terminating null
+		// Output: Writable, null terminated space that lives as long as the pool
+		inline char_type* Allocate(size_type count) {
+			char_type* output;
+			if (count + 1 > BLOCK_SIZE / 4) {
+				// Large strings get a block of their own and do not waste the current one
+				blocks.emplace_back(new char_type[count + 1]);
+				capacity += count + 1;
+				output = blocks.back().get();
+			}
+			else {
+				if (used + count + 1 > BLOCK_SIZE) {
+					blocks.emplace_back(new char_type[BLOCK_SIZE]);
+					capacity += BLOCK_SIZE;
+					current = blocks.back().get();
+					used = 0;
+				}
+				output = current + used;
+				used += count + 1;
+			}
+
+			length += count + 1;
+			output[count] = 0;
+			return output;
+		}
+
+		// Method: StringPool::AllocatePointers
+		// Input: number of pointers needed
+		// Output: Writable array of pointers that lives as long as the pool
+		inline char_type** AllocatePointers(size_type count) {
+			size_type bytes = count * sizeof(char_type*);
+			size_type space = bytes + alignof(char_type*);
+			void* output = Allocate(space / sizeof(char_type) + 1);
+			return static_cast<char_type**>(std::align(alignof(char_type*), bytes, output, space));
+		}
+
+		// Method: StringPool::Add
+		// Input: text to copy into the pool
+		// Output: The pooled copy, which is null terminated
+		inline view_type Add(view_type text) {
+			char_type* output = Allocate(text.size());
+			std::memcpy(output, text.data(), text.size() * sizeof(char_type));
+			return view_type(output, text.size());
+		}
+
+		// Method: StringPool::Absorb
+		// Input: pool whose strings this pool takes over
+		// Purpose: Moves the blocks of another pool, its strings keep their addresses
+		inline void Absorb(StringPool& other) {
+			for (std::unique_ptr<char_type[]>& block : other.blocks) {
+				blocks.push_back(std::move(block));
+			}
+			capacity += other.capacity;
+			length += other.length;
+			other.blocks.clear();
+			other.current = nullptr;
+			other.used = BLOCK_SIZE;
+			other.capacity = 0;
+			other.length = 0;
+		}
+
+		// Method: StringPool::Size
+		// Output: Bytes used by strings, including terminators
+		inline size_type Size() {
+			return length * sizeof(char_type);
+		}
+
+		// Method: StringPool::Capacity
+		// Output: Bytes allocated by the pool
+		inline size_type Capacity() {
+			return capacity * sizeof(char_type);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,223 @@
+/*
+File: rm_Sweep.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Job arrays and parameter sweeps written as one line of a batch file
+*/
+#include "rm_Sweep.hpp"
+#include <limits>
+
+namespace rm {
+	namespace {
+		// Method: ParseInteger
+		// Purpose: Parses a whole string as a signed number
+		bool ParseInteger(std::string_view text, long long& output) {
+			bool negative = !text.empty() && text[0] == '-';
+			size_t value;
+			if (!ParseUnsigned(negative ? text.substr(1) : text, value)
+				|| value > static_cast<size_t>(std::numeric_limits<long long>::max())) {
+				return false;
+			}
+			output = negative ? -static_cast<long long>(value) : static_cast<long long>(value);
+			return true;
+		}
+	}
+
+/// Begin Sweep::Constructors
+	Sweep::Sweep() {
+
+	}
+
+	Sweep::~Sweep() {
+
+	}
+/// End Sweep::Constructors
+
+/// Begin Sweep::Operations
+	// Method: Sweep::AddAxis
+	// Input: name substituted as {name}, values as "first..last[:step]" or "a;b;c"
+	// Output: Whether the axis is valid, the sweep is unchanged if not
+	bool Sweep::AddAxis(std::string_view name, std::string_view values) {
+		// {index} is always the index of the job within the sweep
+		if (name.empty() || name == "index" || name.find_first_of("{}=") != std::string_view::npos || values.empty()) {
+			return false;
+		}
+		Axis axis;
+		axis.name = ToNative(name);
+		for (Axis const& existing : axes) {
+			if (existing.name == axis.name) {
+				return false;
+			}
+		}
+
+		size_t dots = values.find("..");
+		if (dots != std::string_view::npos && values.find(';') == std::string_view::npos) {
+			// first..last[:step], counting down when last is below first
+			std::string_view rest = values.substr(dots + 2);
+			size_t colon = rest.find(':');
+			long long last;
+			size_t step = 1;
+			if (!ParseInteger(values.substr(0, dots), axis.first) || !ParseInteger(rest.substr(0, colon), last)
+				|| (colon != std::string_view::npos && (!ParseUnsigned(rest.substr(colon + 1), step) || step == 0))) {
+				return false;
+			}
+			unsigned long long span = last >= axis.first
+				? static_cast<unsigned long long>(last) - static_cast<unsigned long long>(axis.first)
+				: static_cast<unsigned long long>(axis.first) - static_cast<unsigned long long>(last);
+			axis.count = static_cast<size_type>(span / step + 1);
+			axis.step = last >= axis.first ? static_cast<long long>(step) : -static_cast<long long>(step);
+		}
+		else {
+			// Values are separated by ';' as ',' separates columns
+			while (true) {
+				size_t end = values.find(';');
+				if (end == 0 || values.empty()) {
+					return false;
+				}
+				axis.values.emplace_back(ToNative(values.substr(0, end)));
+				if (end == std::string_view::npos) {
+					break;
+				}
+				values = values.substr(end + 1);
+			}
+			axis.count = axis.values.size();
+		}
+
+		// Every job must have an index
+		if (axis.count == 0 || size > std::numeric_limits<size_type>::max() / axis.count) {
+			return false;
+		}
+		size *= axis.count;
+		axes.push_back(std::move(axis));
+		return true;
+	}
+
+	// Method: Sweep::Describe
+	// Output: Axes as the job settings they were read from, "sweep.name=values ..."
+	std::string Sweep::Describe() const {
+		std::string output;
+		for (Axis const& axis : axes) {
+			if (!output.empty()) {
+				output += ' ';
+			}
+			output += "sweep." + ToUtf8(ToWide(axis.name)) + '=';
+			if (axis.values.empty()) {
+				long long step = axis.step < 0 ? -axis.step : axis.step;
+				output += std::to_string(axis.first) + ".." + std::to_string(axis.first + axis.step * static_cast<long long>(axis.count - 1));
+				if (step != 1) {
+					output += ':' + std::to_string(step);
+				}
+				continue;
+			}
+			for (size_type value = 0; value < axis.values.size(); ++value) {
+				output += (value == 0 ? "" : ";") + ToUtf8(ToWide(axis.values[value]));
+			}
+		}
+		return output;
+	}
+
+	// Method: Sweep::SetShard
+	// Input: index of this launcher from 0, number of launchers
+	// Purpose: Keeps every count-th job from the index-th on, the other launchers run the rest
+	void Sweep::SetShard(size_type index, size_type count) {
+		offset = index;
+		stride = count == 0 ? 1 : count;
+		results.clear();
+		earlier.clear();
+	}
+
+	// Method: Sweep::Expand
+	// Input: job of this launcher, parameters with {name} placeholders, output
+	// Purpose: Writes the parameters of the job, unknown placeholders are kept as written
+	void Sweep::Expand(size_type job, native_string_view params, native_string& output) const {
+		// The last axis changes fastest, like nested loops written in axis order
+		size_type index = GetIndex(job);
+		size_type digits[16];
+		std::vector<size_type> spill;
+		size_type* digit = axes.size() <= 16 ? digits : (spill.resize(axes.size()), spill.data());
+		size_type rest = index;
+		for (size_type axis = axes.size(); axis-- > 0;) {
+			digit[axis] = rest % axes[axis].count;
+			rest /= axes[axis].count;
+		}
+
+		output.clear();
+		while (!params.empty()) {
+			size_type open = params.find('{');
+			size_type close = open == native_string_view::npos ? open : params.find('}', open);
+			if (close == native_string_view::npos) {
+				output += params;
+				break;
+			}
+			output += params.substr(0, open);
+			native_string_view name = params.substr(open + 1, close - open - 1);
+			params = params.substr(close + 1);
+
+			if (name == RM_TEXT("index")) {
+				output += ToNative(std::to_string(index));
+				continue;
+			}
+			bool found = false;
+			for (size_type axis = 0; axis < axes.size() && !found; ++axis) {
+				if (axes[axis].name != name) {
+					continue;
+				}
+				found = true;
+				if (axes[axis].values.empty()) {
+					output += ToNative(std::to_string(axes[axis].first + axes[axis].step * static_cast<long long>(digit[axis])));
+				}
+				else {
+					output += axes[axis].values[digit[axis]];
+				}
+			}
+			if (!found) {
+				output += RM_TEXT('{');
+				output += name;
+				output += RM_TEXT('}');
+			}
+		}
+	}
+
+	// Method: Sweep::Record
+	// Input: job of this launcher, how it ended, earlier attempts if it was retried
+	void Sweep::Record(size_type job, SweepResult const& result, std::vector<SweepResult>&& attempts) {
+		if (results.empty()) {
+			results.resize(GetCount());
+		}
+		results[job] = result;
+		if (!attempts.empty()) {
+			earlier[job] = std::move(attempts);
+		}
+	}
+
+	// Method: Sweep::GetResult
+	// Output: How the job ended, no flags are set if it never finished
+	SweepResult Sweep::GetResult(size_type job) const {
+		return job < results.size() ? results[job] : SweepResult();
+	}
+
+	// Method: Sweep::GetEarlierAttempts
+	// Output: Earlier attempts of the job, null if it was not retried
+	std::vector<SweepResult> const* Sweep::GetEarlierAttempts(size_type job) const {
+		std::unordered_map<size_type, std::vector<SweepResult>>::const_iterator found = earlier.find(job);
+		return found == earlier.end() ? nullptr : &found->second;
+	}
+
+	// Method: Sweep::GetMemoryFootprint
+	// Output: Bytes used by the axes and results
+	Sweep::size_type Sweep::GetMemoryFootprint() const {
+		size_type bytes = sizeof(*this) + axes.capacity() * sizeof(Axis) + results.capacity() * sizeof(SweepResult);
+		for (Axis const& axis : axes) {
+			bytes += axis.name.capacity() * sizeof(native_char);
+			for (native_string const& value : axis.values) {
+				bytes += sizeof(value) + value.capacity() * sizeof(native_char);
+			}
+		}
+		for (std::unordered_map<size_type, std::vector<SweepResult>>::value_type const& attempts : earlier) {
+			bytes += sizeof(attempts) + attempts.second.capacity() * sizeof(SweepResult);
+		}
+		return bytes;
+	}
+/// End Sweep::Operations
+}
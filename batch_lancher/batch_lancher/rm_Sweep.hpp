@@ -0,0 +1,131 @@
+/*
+File: rm_Sweep.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Job arrays and parameter sweeps written as one line of a batch file
+		Each axis is a range or a list of values, the jobs are every combination of them
+		and are only expanded into a process when the scheduler is about to start them
+		A finished job is kept as a compact result, so a sweep costs the same memory
+		however many of its jobs have run
+*/
+#ifndef RM_SWEEP_HEADER_GUARD
+#define RM_SWEEP_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+namespace rm {
+	// How one expanded job of a sweep ended, the times are nanoseconds of the steady clock
+	struct SweepResult {
+		// Flags of SweepResult::state
+		enum : unsigned char {
+			DONE = 1,
+			STARTED = 2,
+			// Restored from an earlier run rather than started
+			CACHED = 4,
+			// Finished before the batch was interrupted
+			RESUMED = 8
+		};
+
+		std::int64_t start = 0;
+		std::int64_t end = 0;
+		std::int64_t userTime = 0;
+		std::int64_t kernelTime = 0;
+		std::uint32_t exitCode = 0;
+		// Nanoseconds inside the spawn call and starting the process in all, saturated at 4 seconds
+		std::uint32_t spawnLatency = 0;
+		std::uint32_t launchOverhead = 0;
+		std::uint16_t attempts = 0;
+		// A StopReason
+		std::uint8_t stopReason = 0;
+		std::uint8_t state = 0;
+	};
+	static_assert(sizeof(SweepResult) == 48, "sweep results are 48 bytes");
+
+	class Sweep {
+	public:		/// Types
+		using size_type = size_t;
+	private:
+		// One parameter of the sweep
+		struct Axis {
+			native_string name;
+			// Values listed, empty for a range
+			std::vector<native_string> values;
+			// Range of integers, first + step * n for n below count
+			long long first = 0;
+			long long step = 1;
+			size_type count = 0;
+		};
+	private:	/// Variables
+		std::vector<Axis> axes;
+		// Combinations of every axis
+		size_type size = 1;
+		// Jobs kept by this launcher when sharded, offset + stride * job
+		size_type offset = 0;
+		size_type stride = 1;
+		// Result of each kept job, allocated once the first of them finishes
+		std::vector<SweepResult> results;
+		// Earlier attempts of jobs that were retried, oldest first
+		std::unordered_map<size_type, std::vector<SweepResult>> earlier;
+	public:		/// Methods
+		/// Constructors
+		Sweep();
+
+		~Sweep();
+
+		/// Operations
+		// Method: Sweep::AddAxis
+		// Input: name substituted as {name}, values as "first..last[:step]" or "a;b;c"
+		// Output: Whether the axis is valid, the sweep is unchanged if not
+		bool AddAxis(std::string_view name, std::string_view values);
+
+		// Method: Sweep::Describe
+		// Output: Axes as the job settings they were read from, "sweep.name=values ..."
+		std::string Describe() const;
+
+		// Method: Sweep::SetShard
+		// Input: index of this launcher from 0, number of launchers
+		// Purpose: Keeps every count-th job from the index-th on, the other launchers run the rest
+		void SetShard(size_type index, size_type count);
+
+		// Method: Sweep::GetCount
+		// Output: Jobs this launcher runs
+		inline size_type GetCount() const {
+			return offset >= size ? 0 : (size - offset + stride - 1) / stride;
+		}
+
+		// Method: Sweep::GetIndex
+		// Input: job of this launcher
+		// Output: Index of the job within the whole sweep, substituted as {index}
+		inline size_type GetIndex(size_type job) const {
+			return offset + job * stride;
+		}
+
+		// Method: Sweep::Expand
+		// Input: job of this launcher, parameters with {name} placeholders, output
+		// Purpose: Writes the parameters of the job, unknown placeholders are kept as written
+		void Expand(size_type job, native_string_view params, native_string& output) const;
+
+		// Method: Sweep::Record
+		// Input: job of this launcher, how it ended, earlier attempts if it was retried
+		void Record(size_type job, SweepResult const& result, std::vector<SweepResult>&& attempts);
+
+		// Method: Sweep::GetResult
+		// Output: How the job ended, no flags are set if it never finished
+		SweepResult GetResult(size_type job) const;
+
+		// Method: Sweep::GetEarlierAttempts
+		// Output: Earlier attempts of the job, null if it was not retried
+		std::vector<SweepResult> const* GetEarlierAttempts(size_type job) const;
+
+		// Method: Sweep::GetMemoryFootprint
+		// Output: Bytes used by the axes and results
+		size_type GetMemoryFootprint() const;
+	};
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+File: rm_TimeLimits.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Parses and merges the time limits of a launchgroup
+*/
+#include "rm_TimeLimits.hpp"
+
+namespace rm {
+/// Begin TimeLimits::Operations
+	// Method: TimeLimits::Merge
+	// Input: Settings of the launcher
+	// Purpose: Copies every setting this launchgroup does not set itself
+	void TimeLimits::Merge(TimeLimits const& defaults) {
+		if (timeout == duration_type::zero()) {
+			timeout = defaults.timeout;
+		}
+		if (grace == duration_type::zero()) {
+			grace = defaults.grace;
+		}
+		if (straggler == StragglerPolicy::Default) {
+			straggler = defaults.straggler;
+		}
+		if (stragglerFactor == 0) {
+			stragglerFactor = defaults.stragglerFactor;
+		}
+	}
+
+	// Method: TimeLimits::ApplySetting
+	// Input: setting name and value from the batch file
+	// Output: setting was a valid time limit setting
+	bool TimeLimits::ApplySetting(std::string_view key, std::string_view value) {
+		if (key == "timeout") {
+			return ParseDuration(value, timeout) && timeout > duration_type::zero();
+		}
+		if (key == "grace") {
+			return ParseDuration(value, grace) && grace > duration_type::zero();
+		}
+		if (key == "straggler") {
+			if (value == "kill") {
+				straggler = StragglerPolicy::Kill;
+			}
+			else if (value == "relaunch") {
+				straggler = StragglerPolicy::Relaunch;
+			}
+			else if (value == "none") {
+				straggler = StragglerPolicy::None;
+			}
+			else {
+				return false;
+			}
+			return true;
+		}
+		if (key == "straggler_factor") {
+			// Below 1 every process would be a straggler
+			return ParseDecimal(value, stragglerFactor) && stragglerFactor >= 1;
+		}
+		return false;
+	}
+/// End TimeLimits::Operations
+}
@@ -0,0 +1,69 @@
+/*
+File: rm_TimeLimits.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: How long the processes of a launchgroup may run
+		A timeout stops a process, a straggler policy deals with processes
+		that run far longer than the rest of their launchgroup
+*/
+#ifndef RM_TIMELIMITS_HEADER_GUARD
+#define RM_TIMELIMITS_HEADER_GUARD
+#include "rm_lib.hpp"
+#include <chrono>
+#include <string_view>
+
+namespace rm {
+	// What happens to a process that runs far longer than the rest of its launchgroup
+	enum class StragglerPolicy : unsigned char {
+		// Use the launcher default
+		Default,
+		// Let it run
+		None,
+		// Stop it
+		Kill,
+		// Start a copy and keep whichever finishes first
+		Relaunch
+	};
+
+	struct TimeLimits {
+		using duration_type = std::chrono::nanoseconds;
+
+		// Grace and straggler factor used when neither the launchgroup nor launcher set them
+		static constexpr std::chrono::seconds DEFAULT_GRACE = std::chrono::seconds(5);
+		static constexpr double DEFAULT_FACTOR = 3;
+
+		// Wall time a process may run before it is stopped, zero for no limit
+		duration_type timeout = duration_type::zero();
+		// Time between asking a process to exit and killing it, zero if not set
+		duration_type grace = duration_type::zero();
+		StragglerPolicy straggler = StragglerPolicy::Default;
+		// Multiple of the launchgroup's median run time that makes a process a straggler, 0 if not set
+		double stragglerFactor = 0;
+
+		// Method: TimeLimits::Merge
+		// Input: Settings of the launcher
+		// Purpose: Copies every setting this launchgroup does not set itself
+		void Merge(TimeLimits const& defaults);
+
+		// Method: TimeLimits::ApplySetting
+		// Input: setting name and value from the batch file
+		// Output: setting was a valid time limit setting
+		//			timeout=10m grace=5s straggler=kill|relaunch|none straggler_factor=2.5
+		bool ApplySetting(std::string_view key, std::string_view value);
+
+		// Method: TimeLimits::GetGrace
+		// Output: Time between asking a process to exit and killing it
+		inline duration_type GetGrace() const {
+			return grace > duration_type::zero() ? grace : duration_type(DEFAULT_GRACE);
+		}
+
+		// Method: TimeLimits::GetStragglerFactor
+		// Output: Multiple of the median run time that makes a process a straggler
+		inline double GetStragglerFactor() const {
+			return stragglerFactor > 0 ? stragglerFactor : DEFAULT_FACTOR;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+File: rm_TimerWheel.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Hashed timing wheel for the deadlines of running processes
+*/
+#include "rm_TimerWheel.hpp"
+#include <algorithm>
+
+namespace rm {
+/// Begin TimerWheel::Constructors
+	TimerWheel::TimerWheel(clock_type::time_point origin)
+		: slots(SLOTS), origin(origin), next(0), count(0) {
+
+	}
+
+	TimerWheel::~TimerWheel() {
+
+	}
+/// End TimerWheel::Constructors
+
+/// Begin TimerWheel::Operations
+	// Method: TimerWheel::Schedule
+	// Input: Timer to fire once its deadline has passed
+	void TimerWheel::Schedule(Timer const& timer) {
+		// Deadlines already passed fire on the next Expire
+		size_type tick = std::max(TickOf(timer.deadline), next);
+		slots[tick % SLOTS].push_back(timer);
+		++count;
+	}
+
+	// Method: TimerWheel::Expire
+	// Input: current time, list to append expired timers to
+	// Purpose: Removes every timer whose deadline has passed, in no particular order
+	void TimerWheel::Expire(clock_type::time_point now, std::vector<Timer>& expired) {
+		if (now < origin + TICK * static_cast<long long>(next)) {
+			return;
+		}
+		// Last tick that has fully passed
+		size_type last = static_cast<size_type>((now - origin) / TICK);
+
+		// Each slot is visited once however long the wheel was left alone
+		size_type visits = std::min(last - next + 1, SLOTS);
+		for (size_type i = 0; i < visits; ++i) {
+			std::vector<Timer>& slot = slots[(next + i) % SLOTS];
+			std::vector<Timer>::iterator kept = std::partition(slot.begin(), slot.end(), [&](Timer const& timer) {
+				return std::max(TickOf(timer.deadline), next) > last;
+			});
+			expired.insert(expired.end(), kept, slot.end());
+			count -= slot.end() - kept;
+			slot.erase(kept, slot.end());
+		}
+		next = last + 1;
+	}
+
+	// Method: TimerWheel::UntilNext
+	// Input: current time
+	// Output: Time until the next occupied tick, negative when no timer is pending
+	std::chrono::milliseconds TimerWheel::UntilNext(clock_type::time_point now) {
+		if (count == 0) {
+			return std::chrono::milliseconds(-1);
+		}
+
+		// The first occupied slot may hold timers for a later turn, waking early for them is harmless
+		size_type tick = next;
+		while (slots[tick % SLOTS].empty()) {
+			++tick;
+		}
+		clock_type::time_point when = origin + TICK * static_cast<long long>(tick);
+		if (when <= now) {
+			return std::chrono::milliseconds::zero();
+		}
+		return std::chrono::ceil<std::chrono::milliseconds>(when - now);
+	}
+
+	// Method: TimerWheel::TickOf
+	// Output: First tick at or after a time
+	TimerWheel::size_type TimerWheel::TickOf(clock_type::time_point time) {
+		if (time <= origin) {
+			return 0;
+		}
+		duration_type since = time - origin;
+		return static_cast<size_type>((since + TICK - duration_type(1)) / TICK);
+	}
+/// End TimerWheel::Operations
+}
@@ -0,0 +1,76 @@
+/*
+File: rm_TimerWheel.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Hashed timing wheel for the deadlines of running processes
+		Scheduling and expiring a timer cost the same however many are pending,
+		and the scheduler's event loop sleeps until the next occupied tick
+*/
+#ifndef RM_TIMERWHEEL_HEADER_GUARD
+#define RM_TIMERWHEEL_HEADER_GUARD
+#include <chrono>
+#include <vector>
+
+namespace rm {
+	class TimerWheel {
+	public:		/// Types
+		using size_type = size_t;
+		using clock_type = std::chrono::steady_clock;
+		using duration_type = std::chrono::nanoseconds;
+
+		// A deadline and what it is for, timers are never cancelled and are
+		// checked against the current state of their owner when they fire
+		struct Timer {
+			clock_type::time_point deadline;
+			size_type key;
+			unsigned int kind;
+			// State of the owner when scheduled, so a timer can tell it has gone stale
+			size_type generation;
+		};
+
+		// Resolution of the wheel, timers fire up to one tick late and never early
+		static constexpr std::chrono::milliseconds TICK = std::chrono::milliseconds(10);
+		// Ticks in one turn of the wheel, later timers wait in their slot for further turns
+		static const size_type SLOTS = 256;
+	private:	/// Variables
+		std::vector<std::vector<Timer>> slots;
+		clock_type::time_point origin;
+		// First tick that has not been expired
+		size_type next;
+		size_type count;
+	public:		/// Methods
+		/// Constructors
+		// Input: Time tick 0 starts at
+		TimerWheel(clock_type::time_point origin = clock_type::now());
+
+		~TimerWheel();
+
+		/// Operations
+		// Method: TimerWheel::Schedule
+		// Input: Timer to fire once its deadline has passed
+		void Schedule(Timer const& timer);
+
+		// Method: TimerWheel::Expire
+		// Input: current time, list to append expired timers to
+		// Purpose: Removes every timer whose deadline has passed, in no particular order
+		void Expire(clock_type::time_point now, std::vector<Timer>& expired);
+
+		// Method: TimerWheel::UntilNext
+		// Input: current time
+		// Output: Time until the next occupied tick, negative when no timer is pending
+		std::chrono::milliseconds UntilNext(clock_type::time_point now);
+
+		// Method: TimerWheel::Size
+		// Output: Number of pending timers
+		inline size_type Size() {
+			return count;
+		}
+	private:
+		// Method: TimerWheel::TickOf
+		// Output: First tick at or after a time
+		size_type TickOf(clock_type::time_point time);
+	};
+}
+
+#endif
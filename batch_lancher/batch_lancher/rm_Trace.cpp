@@ -0,0 +1,203 @@
+/*
+File: rm_Trace.cpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Timeline of a whole run in the Chrome trace event format
+*/
+#include "rm_Trace.hpp"
+#include "rm_lib.hpp"
+#include <cstdio>
+
+namespace rm {
+	namespace {
+		// Process ids of the launcher's own tracks and of the slot tracks
+		const int LAUNCHER_PID = 1;
+		const int SLOTS_PID = 2;
+		// Thread ids of the launcher's tracks, slot tracks are numbered from 1 with 0 beyond the limit
+		const Trace::size_type PHASES_TID = 1;
+		const Trace::size_type GROUPS_TID = 2;
+
+		// Names of StopReason values
+		char const* const STOP_REASONS[] = { "", "timeout", "straggler" };
+
+		// Method: AppendJsonString
+		// Purpose: Appends a quoted JSON string, the text is UTF-8 so only quotes and control characters are escaped
+		void AppendJsonString(std::string& output, std::string_view text) {
+			static char const HEX[] = "0123456789abcdef";
+			output += '"';
+			for (char ch : text) {
+				if (ch == '"' || ch == '\\') {
+					output += '\\';
+					output += ch;
+				}
+				else if (static_cast<unsigned char>(ch) < 0x20) {
+					output += "\\u00";
+					output += HEX[(ch >> 4) & 0xF];
+					output += HEX[ch & 0xF];
+				}
+				else {
+					output += ch;
+				}
+			}
+			output += '"';
+		}
+	}
+
+/// Begin Trace::Constructors
+	Trace::Trace()
+		: first(true) {
+
+	}
+
+	Trace::~Trace() {
+		Close();
+	}
+/// End Trace::Constructors
+
+/// Begin Trace::Operations
+	// Method: Trace::Open
+	// Input: path of the trace file
+	// Output: Whether the file could be created
+	bool Trace::Open(std::string const& path) {
+		file.open(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		origin = clock_type::now();
+		first = true;
+		named.clear();
+		file << "[";
+
+		for (int pid : { LAUNCHER_PID, SLOTS_PID }) {
+			Begin("process_name", 'M', origin, pid, 0);
+			file << ",\"args\":{\"name\":" << (pid == LAUNCHER_PID ? "\"Launcher\"" : "\"Slots\"") << "}}";
+		}
+		Name(LAUNCHER_PID, PHASES_TID, "Phases", 0);
+		Name(LAUNCHER_PID, GROUPS_TID, "Launchgroups", 1);
+		return true;
+	}
+
+	// Method: Trace::Phase
+	// Input: name of a launcher phase such as "parse", when it began and ended
+	void Trace::Phase(std::string_view name, clock_type::time_point begin, clock_type::time_point end) {
+		if (!Enabled()) {
+			return;
+		}
+		Begin(name, 'X', begin, LAUNCHER_PID, PHASES_TID);
+		file << ",\"dur\":" << Timestamp(end - begin) << "}";
+	}
+
+	// Method: Trace::Job
+	// Input: slot the process ran in, the process, when it was reaped, whether it was a copy of a straggler
+	// Purpose: Adds the run of a process to the track of its slot, from its spawn until it was reaped
+	void Trace::Job(size_type slot, Process& proc, clock_type::time_point end, bool copy) {
+		if (!Enabled()) {
+			return;
+		}
+		size_type tid = slot == NO_SLOT ? 0 : slot + 1;
+		if (tid >= named.size()) {
+			named.resize(tid + 1, false);
+		}
+		if (!named[tid]) {
+			named[tid] = true;
+			// Processes beyond the limit are shown after every slot
+			Name(SLOTS_PID, tid, tid == 0 ? std::string("Beyond the limit") : "Slot " + std::to_string(slot), tid == 0 ? 1LL << 30 : static_cast<long long>(slot));
+		}
+
+		// Processes are named by their job id, or by their application without its directory
+		std::string name = ToUtf8(ToWide(proc.GetId().empty() ? proc.GetApp() : proc.GetId()));
+		if (proc.GetId().empty()) {
+			name = name.substr(name.find_last_of("/\\") + 1);
+		}
+		Begin(copy ? name + " (copy)" : name, 'X', proc.GetStartTime(), SLOTS_PID, tid);
+
+		std::string args = ",\"dur\":" + Timestamp(end - proc.GetStartTime())
+			+ ",\"args\":{\"launchgroup\":" + std::to_string(proc.GetLaunchGroup()) + ",\"command\":";
+		AppendJsonString(args, ToUtf8(ToWide(proc.GetCommand())));
+		args += ",\"exit_code\":" + std::to_string(static_cast<long long>(proc.GetExitCode()))
+			+ ",\"attempt\":" + std::to_string(proc.GetAttemptCount());
+		if (proc.GetStopReason() != StopReason::None) {
+			args += ",\"stop_reason\":\"" + std::string(STOP_REASONS[static_cast<size_type>(proc.GetStopReason())]) + '"';
+		}
+		file << args << "}}";
+	}
+
+	// Method: Trace::Group
+	// Input: launchgroup, when its first process started and when all of them had finished
+	void Trace::Group(size_type group, clock_type::time_point begin, clock_type::time_point end) {
+		if (!Enabled()) {
+			return;
+		}
+		Begin("Launchgroup " + std::to_string(group), 'X', begin, LAUNCHER_PID, GROUPS_TID);
+		file << ",\"dur\":" << Timestamp(end - begin) << "}";
+	}
+
+	// Method: Trace::Barrier
+	// Input: launchgroup, when it first had a free slot and nothing left to start, when it completed
+	// Purpose: Shows how long launchgroups waiting on it were held back by its last processes
+	void Trace::Barrier(size_type group, clock_type::time_point begin, clock_type::time_point end) {
+		if (!Enabled()) {
+			return;
+		}
+		// Nested within the launchgroup's own span, which ends at the same time
+		Begin("Barrier " + std::to_string(group), 'X', begin, LAUNCHER_PID, GROUPS_TID);
+		file << ",\"dur\":" << Timestamp(end - begin) << "}";
+	}
+
+	// Method: Trace::Running
+	// Input: time, processes running then
+	void Trace::Running(clock_type::time_point when, size_type count) {
+		if (!Enabled()) {
+			return;
+		}
+		Begin("Running", 'C', when, LAUNCHER_PID, 0);
+		file << ",\"args\":{\"processes\":" << count << "}}";
+	}
+
+	// Method: Trace::Close
+	// Purpose: Ends the event list and closes the file
+	void Trace::Close() {
+		if (!Enabled()) {
+			return;
+		}
+		file << "\n]\n";
+		file.close();
+	}
+
+	// Method: Trace::Begin
+	// Input: event name, phase letter, time, process and thread ids of its track
+	// Purpose: Writes the fields every event has, the caller adds the rest and closes it
+	void Trace::Begin(std::string_view name, char phase, clock_type::time_point when, int pid, size_type tid) {
+		std::string event = first ? "\n{\"name\":" : ",\n{\"name\":";
+		first = false;
+		AppendJsonString(event, name);
+		event += ",\"ph\":\"";
+		event += phase;
+		event += "\",\"ts\":" + Timestamp(when - origin) + ",\"pid\":" + std::to_string(pid) + ",\"tid\":" + std::to_string(tid);
+		file << event;
+	}
+
+	// Method: Trace::Name
+	// Input: process and thread ids, name of the track, position among the tracks
+	void Trace::Name(int pid, size_type tid, std::string_view name, long long order) {
+		Begin("thread_name", 'M', origin, pid, tid);
+		std::string args = ",\"args\":{\"name\":";
+		AppendJsonString(args, name);
+		file << args << "}}";
+		Begin("thread_sort_index", 'M', origin, pid, tid);
+		file << ",\"args\":{\"sort_index\":" << order << "}}";
+	}
+
+	// Method: Trace::Timestamp
+	// Output: Microseconds since the trace was opened, as written to the file
+	std::string Trace::Timestamp(clock_type::duration time) {
+		// Nanoseconds are kept as three decimals
+		long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+		char text[32];
+		std::snprintf(text, sizeof(text), "%s%lld.%03lld", nanoseconds < 0 ? "-" : "",
+			(nanoseconds < 0 ? -nanoseconds : nanoseconds) / 1000, (nanoseconds < 0 ? -nanoseconds : nanoseconds) % 1000);
+		return text;
+	}
+/// End Trace::Operations
+}
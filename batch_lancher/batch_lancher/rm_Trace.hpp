@@ -0,0 +1,97 @@
+/*
+File: rm_Trace.hpp
+Author: Ryan McNamee
+Date Created: Saturday, 17, October, 2026
+Date Updated: Saturday, 17, October, 2026
+Purpose: Timeline of a whole run in the Chrome trace event format, opened by chrome://tracing and Perfetto
+		Each concurrency slot is a track showing its processes from spawn to reap, beside launchgroup spans,
+		the barriers at the end of each launchgroup, launcher phases and a counter of running processes
+		Events are written as they happen, the viewers accept a file cut short by an interrupted run
+*/
+#ifndef RM_TRACE_HEADER_GUARD
+#define RM_TRACE_HEADER_GUARD
+#include "rm_Process.hpp"
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rm {
+	class Trace {
+	public:		/// Types
+		using size_type = size_t;
+		using clock_type = Process::clock_type;
+
+		// Slot of processes started beyond the concurrency limit, such as stages of a large pipeline
+		static const size_type NO_SLOT = static_cast<size_type>(-1);
+	private:	/// Variables
+		std::ofstream file;
+		// Times are written relative to when the trace was opened
+		clock_type::time_point origin;
+		bool first;
+		// Slot tracks whose name has been written, by thread id
+		std::vector<bool> named;
+	public:		/// Methods
+		/// Constructors
+		Trace();
+
+		~Trace();
+
+		Trace(Trace const&) = delete;
+		Trace& operator=(Trace const&) = delete;
+
+		/// Operations
+		// Method: Trace::Open
+		// Input: path of the trace file
+		// Output: Whether the file could be created
+		bool Open(std::string const& path);
+
+		// Method: Trace::Enabled
+		// Output: Whether events are written
+		inline bool Enabled() {
+			return file.is_open();
+		}
+
+		// Method: Trace::Phase
+		// Input: name of a launcher phase such as "parse", when it began and ended
+		void Phase(std::string_view name, clock_type::time_point begin, clock_type::time_point end);
+
+		// Method: Trace::Job
+		// Input: slot the process ran in, the process, when it was reaped, whether it was a copy of a straggler
+		// Purpose: Adds the run of a process to the track of its slot, from its spawn until it was reaped
+		void Job(size_type slot, Process& proc, clock_type::time_point end, bool copy);
+
+		// Method: Trace::Group
+		// Input: launchgroup, when its first process started and when all of them had finished
+		void Group(size_type group, clock_type::time_point begin, clock_type::time_point end);
+
+		// Method: Trace::Barrier
+		// Input: launchgroup, when it first had a free slot and nothing left to start, when it completed
+		// Purpose: Shows how long launchgroups waiting on it were held back by its last processes
+		void Barrier(size_type group, clock_type::time_point begin, clock_type::time_point end);
+
+		// Method: Trace::Running
+		// Input: time, processes running then
+		void Running(clock_type::time_point when, size_type count);
+
+		// Method: Trace::Close
+		// Purpose: Ends the event list and closes the file
+		void Close();
+	private:
+		// Method: Trace::Begin
+		// Input: event name, phase letter, time, process and thread ids of its track
+		// Purpose: Writes the fields every event has, the caller adds the rest and closes it
+		void Begin(std::string_view name, char phase, clock_type::time_point when, int pid, size_type tid);
+
+		// Method: Trace::Name
+		// Input: process and thread ids, name of the track, position among the tracks
+		void Name(int pid, size_type tid, std::string_view name, long long order);
+
+		// Method: Trace::Timestamp
+		// Output: Microseconds since the trace was opened, as written to the file
+		std::string Timestamp(clock_type::duration time);
+	};
+}
+
+#endif
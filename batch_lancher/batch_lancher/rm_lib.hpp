@@ -2,15 +2,34 @@
 File: rm_lib.hpp
 Author: Ryan McNamee
 Date Created: Monday, 9, September, 2017
-Date Updated: Monday, 9, October, 2017
+Date Updated: Saturday, 17, October, 2026
 Purpose: Holds reusable non-member functions
 */
 #ifndef RM_LIB_HPP_HEADER_GUARD
 #define RM_LIB_HPP_HEADER_GUARD
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+
+// Marks a literal as native text, like the Windows TEXT() macro
+#ifdef _WIN32
+#define RM_TEXT(text) L##text
+#else
+#define RM_TEXT(text) text
+#endif
 
 namespace rm {
+	// Text passed to the operating system, UTF-16 on Windows and UTF-8 elsewhere
+#ifdef _WIN32
+	using native_char = wchar_t;
+#else
+	using native_char = char;
+#endif
+	using native_string = std::basic_string<native_char>;
+	using native_string_view = std::basic_string_view<native_char>;
+
 	// Method: GetLine
 	// Purpose: Parses a single line from filestream into input wstring
 	// Inputs: input file, output string
@@ -40,6 +59,322 @@ namespace rm {
 		}
 		return ch == delim;
 	}
+
+	// Method: SplitWhitespace
+	// Purpose: Splits a string into tokens separated by spaces or tabs
+	// Input: string to split
+	// Output: list of slices of the input
+	inline std::vector<std::string_view> SplitWhitespace(std::string_view input) {
+		std::vector<std::string_view> tokens;
+		size_t start = 0;
+		for (size_t i = 0; i <= input.size(); ++i) {
+			if (i == input.size() || input[i] == ' ' || input[i] == '\t' || input[i] == '\r') {
+				if (i > start) {
+					tokens.push_back(input.substr(start, i - start));
+				}
+				start = i + 1;
+			}
+		}
+		return tokens;
+	}
+
+	// Method: SplitKeyValue
+	// Purpose: Splits a key=value token
+	// Input: token, output key, output value
+	// Output: token contained an '='
+	inline bool SplitKeyValue(std::string_view token, std::string_view& key, std::string_view& value) noexcept {
+		size_t equals = token.find('=');
+		if (equals == std::string_view::npos) {
+			key = token;
+			value = std::string_view();
+			return false;
+		}
+		key = token.substr(0, equals);
+		value = token.substr(equals + 1);
+		return true;
+	}
+
+	// Method: TrimLeft
+	// Purpose: Removes leading spaces and tabs
+	inline std::string_view TrimLeft(std::string_view input) noexcept {
+		size_t start = input.find_first_not_of(" \t");
+		return start == std::string_view::npos ? std::string_view() : input.substr(start);
+	}
+
+	// Method: ParseUnsigned
+	// Purpose: Parses a whole string as an unsigned number
+	// Input: string to parse, output number
+	// Output: string was a valid unsigned number
+	template <typename char_type>
+	inline bool ParseUnsigned(std::basic_string_view<char_type> input, size_t& output) noexcept {
+		if (input.empty()) {
+			return false;
+		}
+		size_t value = 0;
+		for (char_type ch : input) {
+			if (ch < '0' || ch > '9') {
+				return false;
+			}
+			value = value * 10 + (ch - '0');
+		}
+		output = value;
+		return true;
+	}
+
+	inline bool ParseUnsigned(std::string_view input, size_t& output) noexcept {
+		return ParseUnsigned<char>(input, output);
+	}
+
+	inline bool ParseUnsigned(std::wstring_view input, size_t& output) noexcept {
+		return ParseUnsigned<wchar_t>(input, output);
+	}
+
+	// Method: ParseDecimal
+	// Purpose: Parses a whole string as a non-negative decimal such as 2 or 2.5
+	// Input: string to parse, output number
+	// Output: string was a valid decimal
+	inline bool ParseDecimal(std::string_view input, double& output) noexcept {
+		size_t point = input.find('.');
+		size_t whole = 0, fraction = 0;
+		if (!ParseUnsigned(input.substr(0, point), whole)) {
+			return false;
+		}
+		double value = static_cast<double>(whole);
+		if (point != std::string_view::npos) {
+			std::string_view digits = input.substr(point + 1);
+			if (digits.size() > 9 || !ParseUnsigned(digits, fraction)) {
+				return false;
+			}
+			double scale = 1;
+			for (size_t i = 0; i < digits.size(); ++i) {
+				scale *= 10;
+			}
+			value += fraction / scale;
+		}
+		output = value;
+		return true;
+	}
+
+	// Method: ParseSize
+	// Purpose: Parses a byte count with an optional K, M or G suffix
+	// Input: string to parse, output byte count
+	// Output: string was a valid, non-zero byte count
+	inline bool ParseSize(std::string_view input, unsigned long long& output) noexcept {
+		unsigned long long scale = 1;
+		if (!input.empty()) {
+			switch (input.back()) {
+			case 'K': case 'k': scale = 1ULL << 10; break;
+			case 'M': case 'm': scale = 1ULL << 20; break;
+			case 'G': case 'g': scale = 1ULL << 30; break;
+			}
+			if (scale != 1) {
+				input.remove_suffix(1);
+			}
+		}
+		size_t value;
+		if (!ParseUnsigned(input, value) || value == 0) {
+			return false;
+		}
+		output = value * scale;
+		return true;
+	}
+
+	// Method: ParseDuration
+	// Purpose: Parses a time such as 30, 1.5s, 500ms, 10m or 2h, seconds when there is no unit
+	// Input: string to parse, output duration
+	// Output: string was a valid duration
+	inline bool ParseDuration(std::string_view input, std::chrono::nanoseconds& output) noexcept {
+		double scale = 1e9;
+		if (input.size() > 2 && input.substr(input.size() - 2) == "ms") {
+			scale = 1e6;
+			input.remove_suffix(2);
+		}
+		else if (!input.empty() && (input.back() == 's' || input.back() == 'm' || input.back() == 'h')) {
+			scale = input.back() == 's' ? 1e9 : input.back() == 'm' ? 60e9 : 3600e9;
+			input.remove_suffix(1);
+		}
+		double value;
+		if (!ParseDecimal(input, value)) {
+			return false;
+		}
+		output = std::chrono::nanoseconds(static_cast<long long>(value * scale));
+		return true;
+	}
+
+	// Method: FromUtf8
+	// Purpose: Decodes UTF-8 into a wide string, wchar_t may be UTF-16 or UTF-32
+	// Input: UTF-8 encoded string
+	// Output: wide string, invalid sequences become U+FFFD
+	inline std::wstring FromUtf8(std::string_view input) {
+		std::wstring output;
+		output.reserve(input.size());
+		size_t i = 0;
+		while (i < input.size()) {
+			unsigned char ch = static_cast<unsigned char>(input[i]);
+			// Plain ASCII is by far the most common
+			if (ch < 0x80) {
+				output += static_cast<wchar_t>(ch);
+				++i;
+				continue;
+			}
+
+			size_t length = ch >= 0xF0 ? 4 : ch >= 0xE0 ? 3 : ch >= 0xC0 ? 2 : 0;
+			unsigned long cp = length == 4 ? (ch & 0x07) : length == 3 ? (ch & 0x0F) : (ch & 0x1F);
+			bool valid = length != 0 && i + length <= input.size();
+			for (size_t j = 1; valid && j < length; ++j) {
+				unsigned char next = static_cast<unsigned char>(input[i + j]);
+				valid = (next & 0xC0) == 0x80;
+				cp = (cp << 6) | (next & 0x3F);
+			}
+			if (!valid) {
+				output += static_cast<wchar_t>(0xFFFD);
+				++i;
+				continue;
+			}
+			i += length;
+
+			if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+				// Encode as a UTF-16 surrogate pair
+				cp -= 0x10000;
+				output += static_cast<wchar_t>(0xD800 + (cp >> 10));
+				output += static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+			}
+			else {
+				output += static_cast<wchar_t>(cp);
+			}
+		}
+		return output;
+	}
+
+	// Method: ToUtf8
+	// Purpose: Encodes a wide string as UTF-8, wchar_t may be UTF-16 or UTF-32
+	// Input: wide string
+	// Output: UTF-8 encoded string
+	inline std::string ToUtf8(std::wstring const& input) {
+		std::string output;
+		output.reserve(input.size());
+		for (size_t i = 0; i < input.size(); ++i) {
+			unsigned long cp = static_cast<unsigned long>(input[i]);
+			// Join UTF-16 surrogate pairs
+			if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < input.size()) {
+				unsigned long low = static_cast<unsigned long>(input[i + 1]);
+				if (low >= 0xDC00 && low <= 0xDFFF) {
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					++i;
+				}
+			}
+
+			if (cp < 0x80) {
+				output += static_cast<char>(cp);
+			}
+			else if (cp < 0x800) {
+				output += static_cast<char>(0xC0 | (cp >> 6));
+				output += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else if (cp < 0x10000) {
+				output += static_cast<char>(0xE0 | (cp >> 12));
+				output += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				output += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else {
+				output += static_cast<char>(0xF0 | (cp >> 18));
+				output += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+				output += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				output += static_cast<char>(0x80 | (cp & 0x3F));
+			}
+		}
+		return output;
+	}
+
+	// Method: SplitArgumentsInto
+	// Purpose: Splits a commandline into arguments, honouring quotes and backslash escapes
+	// Input: commandline, output with room for commandline.size() + 1 characters
+	// Output: number of arguments written to output, each followed by a null
+	inline size_t SplitArgumentsInto(std::string_view commandline, char* output) {
+		size_t count = 0;
+		bool inArg = false;
+		char quote = 0;
+		for (size_t i = 0; i < commandline.size(); ++i) {
+			char ch = commandline[i];
+			if (quote != 0) {
+				// Inside quotes only the matching quote ends the section
+				if (ch == quote) {
+					quote = 0;
+				}
+				else if (ch == '\\' && quote == '"' && i + 1 < commandline.size()
+					&& (commandline[i + 1] == '"' || commandline[i + 1] == '\\')) {
+					*output++ = commandline[++i];
+				}
+				else {
+					*output++ = ch;
+				}
+			}
+			else if (ch == '"' || ch == '\'') {
+				quote = ch;
+				inArg = true;
+			}
+			else if (ch == '\\' && i + 1 < commandline.size()) {
+				*output++ = commandline[++i];
+				inArg = true;
+			}
+			else if (ch == ' ' || ch == '\t' || ch == '\r') {
+				if (inArg) {
+					*output++ = 0;
+					++count;
+					inArg = false;
+				}
+			}
+			else {
+				*output++ = ch;
+				inArg = true;
+			}
+		}
+		if (inArg) {
+			*output++ = 0;
+			++count;
+		}
+		return count;
+	}
+
+	// Method: SplitArguments
+	// Purpose: Splits a commandline into arguments, honouring quotes and backslash escapes
+	// Input: commandline
+	// Output: list of arguments
+	inline std::vector<std::string> SplitArguments(std::string const& commandline) {
+		std::string buffer(commandline.size() + 1, '\0');
+		size_t count = SplitArgumentsInto(commandline, &buffer[0]);
+
+		std::vector<std::string> args;
+		args.reserve(count);
+		char const* arg = buffer.data();
+		for (size_t i = 0; i < count; ++i) {
+			args.emplace_back(arg);
+			arg += args.back().size() + 1;
+		}
+		return args;
+	}
+
+	// Method: ToNative
+	// Purpose: Converts UTF-8 to native text, on POSIX the input is already native
+#ifdef _WIN32
+	inline std::wstring ToNative(std::string_view input) {
+		return FromUtf8(input);
+	}
+#else
+	inline std::string_view ToNative(std::string_view input) {
+		return input;
+	}
+#endif
+
+	// Method: ToWide
+	// Purpose: Converts native text to a wide string for printing
+	inline std::wstring ToWide(native_string_view input) {
+#ifdef _WIN32
+		return std::wstring(input);
+#else
+		return FromUtf8(input);
+#endif
+	}
 }
 
 #endif
\ No newline at end of file